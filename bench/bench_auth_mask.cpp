@@ -0,0 +1,78 @@
+#include "bench_harness.h"
+#include "bench_suites.h"
+#include <interface/auth_types.h>
+#include <vector>
+
+// Memory held by route auth requirements across a 300-route table, comparing
+// the former std::vector<AuthType> with AuthMask, plus membership cost.
+
+namespace {
+
+const size_t ROUTE_COUNT = 300;
+
+// Mix seen in practice: public pages, session pages and API routes
+std::initializer_list<AuthType> requirementsFor(size_t route) {
+  static const std::initializer_list<AuthType> mixes[] = {
+      {AuthType::NONE},
+      {AuthType::SESSION},
+      {AuthType::SESSION, AuthType::TOKEN}};
+  return mixes[route % 3];
+}
+
+struct Footprint {
+  double inlineBytes;
+  double heapBytes;
+  double allocs;
+};
+
+template <typename Requirements> Footprint measureTable() {
+  std::vector<Requirements> table;
+  table.reserve(ROUTE_COUNT);
+  AllocScope scope;
+  for (size_t i = 0; i < ROUTE_COUNT; i++) {
+    table.push_back(Requirements(requirementsFor(i)));
+  }
+  AllocStats used = scope.stats();
+  bench::doNotOptimize(table.data());
+  return {static_cast<double>(sizeof(Requirements)),
+          static_cast<double>(used.bytes) / ROUTE_COUNT,
+          static_cast<double>(used.count) / ROUTE_COUNT};
+}
+
+bool vectorHas(const std::vector<AuthType> &requirements, AuthType type) {
+  for (AuthType candidate : requirements) {
+    if (candidate == type) {
+      return true;
+    }
+  }
+  return false;
+}
+
+} // namespace
+
+void run_auth_mask_benchmarks() {
+  bench::printHeader("AuthRequirements (300 routes)");
+  // Per-route cost of building the table; bytes/op is heap only
+  Footprint vectorCost = measureTable<std::vector<AuthType>>();
+  Footprint maskCost = measureTable<AuthMask>();
+  bench::report("std::vector<AuthType> per route",
+                {0.0 / 0.0, vectorCost.allocs, vectorCost.heapBytes});
+  bench::report("AuthMask per route",
+                {0.0 / 0.0, maskCost.allocs, maskCost.heapBytes});
+  bench::note("table bytes (inline + heap): vector %.0f, mask %.0f; "
+              "saved per route: %.1f bytes (excluding allocator headers)\n",
+              (vectorCost.inlineBytes + vectorCost.heapBytes) * ROUTE_COUNT,
+              (maskCost.inlineBytes + maskCost.heapBytes) * ROUTE_COUNT,
+              vectorCost.inlineBytes + vectorCost.heapBytes -
+                  maskCost.inlineBytes - maskCost.heapBytes);
+
+  std::vector<AuthType> vectorAuth = {AuthType::SESSION, AuthType::TOKEN};
+  AuthMask maskAuth = AuthType::SESSION | AuthType::TOKEN;
+  volatile AuthType probe = AuthType::LOCAL_ONLY;
+  bench::run("std::vector<AuthType> membership miss", 1000000, [&]() {
+    bench::doNotOptimize(vectorHas(vectorAuth, probe));
+  });
+  bench::run("AuthMask membership miss", 1000000, [&]() {
+    bench::doNotOptimize(maskAuth.has(probe));
+  });
+}
@@ -0,0 +1,63 @@
+#include "bench_harness.h"
+#include "bench_suites.h"
+#include <interface/utils/gzip_stream.h>
+#include <string>
+
+// CPU cost versus bytes saved when gzipping a ~30 KB JSON list on the fly,
+// across window sizes and match-chain depths. The note after each row gives
+// the compressed size and the encoder's heap footprint, to pick a setting
+// that fits ESP32-class memory.
+
+namespace {
+
+std::string deviceList() {
+  static const char *ROOMS[] = {"kitchen", "living room", "porch", "garage"};
+  std::string json = "{\"devices\":[";
+  for (int i = 0; i < 320; i++) {
+    json += i ? "," : "";
+    json += "{\"id\":" + std::to_string(1000 + i) + ",\"name\":\"Sensor " +
+            std::to_string(i) + "\",\"room\":\"" + ROOMS[i % 4] +
+            "\",\"online\":" + (i % 7 ? "true" : "false") +
+            ",\"battery\":" + std::to_string(100 - i % 61) +
+            ",\"temperature\":" + std::to_string(18 + i % 9) + "." +
+            std::to_string(i % 10) + "}";
+  }
+  return json + "]}";
+}
+
+void measure(const std::string &json, uint8_t windowBits, uint8_t maxChain) {
+  char name[64];
+  snprintf(name, sizeof(name), "window %5u, chain %2u",
+           1u << windowBits, static_cast<unsigned>(maxChain));
+  size_t compressed = 0;
+  bench::Result result = bench::run(name, 200, [&]() {
+    size_t total = 0;
+    GzipStream gzip(
+        [&total](const char *data, size_t length) {
+          total += length;
+          return true;
+        },
+        windowBits, maxChain);
+    gzip.write(json.data(), json.size());
+    gzip.finish();
+    compressed = total;
+  });
+  if (result.nsPerOp == result.nsPerOp) {
+    bench::note("  %zu -> %zu bytes (%.1f%%), %.1f MB/s, heap %zu bytes\n",
+                json.size(), compressed, 100.0 * compressed / json.size(),
+                json.size() / (result.nsPerOp / 1e9) / (1024.0 * 1024.0),
+                GzipStream::memoryFor(windowBits));
+  }
+}
+
+} // namespace
+
+void run_gzip_benchmarks() {
+  bench::printHeader("On-the-fly gzip of a JSON list");
+  std::string json = deviceList();
+  for (uint8_t windowBits : {9, 10, 11, 12, 14}) {
+    measure(json, windowBits, GzipStream::DEFAULT_MAX_CHAIN);
+  }
+  measure(json, 10, 2);
+  measure(json, 10, 32);
+}
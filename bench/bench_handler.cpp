@@ -0,0 +1,73 @@
+#include "bench_harness.h"
+#include "bench_suites.h"
+#include <functional>
+#include <interface/utils/inplace_function.h>
+
+// Dispatch cost and allocations of InplaceFunction versus std::function for
+// the handler shapes modules use: free functions, lambdas capturing `this`,
+// lambdas capturing `this` plus a couple of members, and (fn, context).
+
+namespace {
+
+struct Module {
+  int base = 3;
+  int scale = 2;
+  const char *name = "module";
+
+  int handle(int value) { return value * scale + base; }
+};
+
+int freeHandler(int value) { return value + 1; }
+
+int contextHandler(void *context, int value) {
+  return static_cast<Module *>(context)->handle(value);
+}
+
+template <typename Handler>
+void report(const char *shape, const Handler &prototype,
+            uint64_t iterations) {
+  Handler handler = prototype;
+  int input = 0;
+  char name[64];
+  snprintf(name, sizeof(name), "%s call", shape);
+  bench::run(name, iterations,
+             [&]() { bench::doNotOptimize(handler(input++)); });
+  // Routes copy their handler whenever the route itself is copied
+  snprintf(name, sizeof(name), "%s copy", shape);
+  bench::run(name, iterations / 10, [&]() {
+    Handler copy = prototype;
+    bench::doNotOptimize(copy);
+  });
+}
+
+template <typename Handler> void reportAll(const char *label, Module &module) {
+  const uint64_t iterations = 5000000;
+  Module *self = &module;
+  int offset = 7;
+  char row[64];
+
+  snprintf(row, sizeof(row), "%s fn pointer", label);
+  report(row, Handler(&freeHandler), iterations);
+
+  snprintf(row, sizeof(row), "%s [this]", label);
+  report(row, Handler([self](int value) { return self->handle(value); }),
+         iterations);
+
+  snprintf(row, sizeof(row), "%s [this, 2 members]", label);
+  const char *name = module.name;
+  report(row, Handler([self, offset, name](int value) {
+           return self->handle(value) + offset + name[0];
+         }),
+         iterations);
+}
+
+} // namespace
+
+void run_handler_benchmarks() {
+  bench::printHeader("Route handler: InplaceFunction vs std::function");
+  Module module;
+  reportAll<std::function<int(int)>>("std::function", module);
+  reportAll<InplaceFunction<int(int)>>("inplace", module);
+  report("inplace (fn, context)",
+         InplaceFunction<int(int)>(&contextHandler, &module), 5000000);
+}
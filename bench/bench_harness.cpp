@@ -0,0 +1,152 @@
+#include "bench_harness.h"
+#include <cmath>
+#include <cstdarg>
+#include <cstring>
+
+namespace bench {
+
+namespace {
+
+OutputFormat format = OutputFormat::TEXT;
+const char *filter = nullptr;
+const char *currentSuite = "";
+bool csvHeaderPrinted = false;
+
+// Column value: fixed decimals, or the format's notion of "missing"
+void printValue(double value, const char *missing) {
+  if (std::isnan(value)) {
+    printf("%s", missing);
+  } else {
+    printf("%.2f", value);
+  }
+}
+
+void printTextColumn(double value, int decimals) {
+  if (std::isnan(value)) {
+    printf(" %12s", "-");
+  } else {
+    printf(" %12.*f", decimals, value);
+  }
+}
+
+// Names are plain ASCII labels; only quotes and backslashes need escaping
+void printJsonString(const char *text) {
+  putchar('"');
+  for (const char *c = text; *c; c++) {
+    if (*c == '"' || *c == '\\') {
+      putchar('\\');
+    }
+    putchar(*c);
+  }
+  putchar('"');
+}
+
+void printCsvField(const char *text) {
+  putchar('"');
+  for (const char *c = text; *c; c++) {
+    if (*c == '"') {
+      putchar('"');
+    }
+    putchar(*c);
+  }
+  putchar('"');
+}
+
+} // namespace
+
+bool configure(int argc, char **argv) {
+  for (int i = 1; i < argc; i++) {
+    const char *arg = argv[i];
+    if (strcmp(arg, "--format=text") == 0) {
+      format = OutputFormat::TEXT;
+    } else if (strcmp(arg, "--format=json") == 0) {
+      format = OutputFormat::JSON;
+    } else if (strcmp(arg, "--format=csv") == 0) {
+      format = OutputFormat::CSV;
+    } else if (strncmp(arg, "--filter=", 9) == 0) {
+      filter = arg + 9;
+    } else {
+      fprintf(stderr,
+              "usage: %s [--format=text|json|csv] [--filter=substring]\n",
+              argv[0]);
+      return false;
+    }
+  }
+  return true;
+}
+
+OutputFormat outputFormat() { return format; }
+
+void printHeader(const char *suite) {
+  currentSuite = suite;
+  if (format == OutputFormat::TEXT) {
+    printf("\n== %s ==\n", suite);
+    printf("%-44s %12s %12s %12s\n", "case", "ns/op", "allocs/op",
+           "bytes/op");
+  }
+}
+
+void note(const char *format, ...) {
+  if (bench::format != OutputFormat::TEXT) {
+    return;
+  }
+  va_list args;
+  va_start(args, format);
+  vprintf(format, args);
+  va_end(args);
+}
+
+bool selected(const char *name) {
+  if (!filter || !*filter) {
+    return true;
+  }
+  char qualified[256];
+  snprintf(qualified, sizeof(qualified), "%s/%s", currentSuite, name);
+  return strstr(qualified, filter) != nullptr;
+}
+
+void report(const char *name, const Result &result) {
+  if (!selected(name)) {
+    return;
+  }
+  switch (format) {
+  case OutputFormat::TEXT:
+    printf("%-44s", name);
+    printTextColumn(result.nsPerOp, 1);
+    printTextColumn(result.allocsPerOp, 2);
+    printTextColumn(result.bytesPerOp, 0);
+    putchar('\n');
+    break;
+  case OutputFormat::JSON:
+    printf("{\"suite\":");
+    printJsonString(currentSuite);
+    printf(",\"case\":");
+    printJsonString(name);
+    printf(",\"ns_per_op\":");
+    printValue(result.nsPerOp, "null");
+    printf(",\"allocs_per_op\":");
+    printValue(result.allocsPerOp, "null");
+    printf(",\"bytes_per_op\":");
+    printValue(result.bytesPerOp, "null");
+    printf("}\n");
+    break;
+  case OutputFormat::CSV:
+    if (!csvHeaderPrinted) {
+      printf("suite,case,ns_per_op,allocs_per_op,bytes_per_op\n");
+      csvHeaderPrinted = true;
+    }
+    printCsvField(currentSuite);
+    putchar(',');
+    printCsvField(name);
+    putchar(',');
+    printValue(result.nsPerOp, "");
+    putchar(',');
+    printValue(result.allocsPerOp, "");
+    putchar(',');
+    printValue(result.bytesPerOp, "");
+    putchar('\n');
+    break;
+  }
+}
+
+} // namespace bench
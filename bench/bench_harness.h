@@ -0,0 +1,113 @@
+#ifndef BENCH_HARNESS_H
+#define BENCH_HARNESS_H
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <testing/alloc_scope.h>
+
+/**
+ * Timing and reporting helpers for the native benchmark program.
+ *
+ * Benchmarks run in the bench_native environment, which builds with
+ * optimizations (unlike test_native) so numbers reflect real code paths.
+ *
+ * Every measured case goes through bench::run() (or bench::report() for
+ * values computed by the suite) and becomes one result row with ns/op,
+ * allocs/op and bytes/op. Rows print as aligned text by default, or as
+ * JSON lines / CSV for tracking between releases:
+ *
+ *   program --format=json --filter=RouteTrie > results.jsonl
+ *
+ * --filter keeps cases whose "suite/case" name contains the given text.
+ * Commentary printed with bench::note() only appears in text output.
+ */
+namespace bench {
+
+enum class OutputFormat { TEXT, JSON, CSV };
+
+struct Result {
+  double nsPerOp;     // NaN when not measured
+  double allocsPerOp; // NaN when allocation counting is unavailable
+  double bytesPerOp;  // Bytes requested per op (NaN as above)
+};
+
+// Parse command-line options; false (after printing usage) on bad input
+bool configure(int argc, char **argv);
+OutputFormat outputFormat();
+
+// Start a suite: a heading in text output, the "suite" column otherwise
+void printHeader(const char *suite);
+
+// Free-form commentary, text output only
+void note(const char *format, ...) __attribute__((format(printf, 1, 2)));
+
+// Whether `name` in the current suite passes --filter
+bool selected(const char *name);
+
+// Emit one result row
+void report(const char *name, const Result &result);
+
+// Allocation counts are deterministic, so they are sampled over at most
+// this many calls
+static const uint64_t ALLOC_SAMPLE_ITERATIONS = 2000;
+
+inline uint64_t nowNs() {
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+}
+
+// Keep the optimizer from discarding a computed value
+template <typename T> inline void doNotOptimize(const T &value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Run fn() `iterations` times after a short warm-up and return ns per call
+template <typename Fn> double measureNsPerOp(uint64_t iterations, Fn &&fn) {
+  for (uint64_t i = 0; i < iterations / 10 + 1; i++) {
+    fn();
+  }
+  uint64_t start = nowNs();
+  for (uint64_t i = 0; i < iterations; i++) {
+    fn();
+  }
+  return static_cast<double>(nowNs() - start) / iterations;
+}
+
+// Allocation count and bytes of fn(), averaged over `iterations` calls
+template <typename Fn> Result measureAllocs(uint64_t iterations, Fn &&fn) {
+  AllocScope scope;
+  for (uint64_t i = 0; i < iterations; i++) {
+    fn();
+  }
+  AllocStats used = scope.stats();
+  if (!allocTrackingAvailable()) {
+    return {0.0 / 0.0, 0.0 / 0.0, 0.0 / 0.0};
+  }
+  return {0.0 / 0.0, static_cast<double>(used.count) / iterations,
+          static_cast<double>(used.bytes) / iterations};
+}
+
+// Measure fn() (time, then allocations) and report it as case `name`
+template <typename Fn>
+Result run(const char *name, uint64_t iterations, Fn &&fn) {
+  Result result = {0.0 / 0.0, 0.0 / 0.0, 0.0 / 0.0};
+  if (!selected(name)) {
+    return result;
+  }
+  result.nsPerOp = measureNsPerOp(iterations, fn);
+  Result allocs = measureAllocs(iterations < ALLOC_SAMPLE_ITERATIONS
+                                    ? iterations
+                                    : ALLOC_SAMPLE_ITERATIONS,
+                                fn);
+  result.allocsPerOp = allocs.allocsPerOp;
+  result.bytesPerOp = allocs.bytesPerOp;
+  report(name, result);
+  return result;
+}
+
+} // namespace bench
+
+#endif // BENCH_HARNESS_H
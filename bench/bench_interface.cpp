@@ -0,0 +1,161 @@
+#include "bench_harness.h"
+#include "bench_suites.h"
+#include <interface/openapi_factory.h>
+#include <interface/route_types.h>
+#include <interface/string_compat.h>
+#include <interface/web_response.h>
+#include <testing/testing_platform_provider.h>
+
+// Per-request and per-registration paths of the interface types that the
+// other suites do not cover: building routes and their documentation (run
+// once per route at startup, but it dominates boot time with many modules),
+// filling a WebResponse from a handler, the platform's JSON response
+// builders and the mock request/response path module tests run through.
+
+namespace {
+
+void noopHandler(WebRequest &, WebResponse &) {}
+
+class DeviceModule : public IWebModule {
+public:
+  std::vector<RouteVariant> getHttpRoutes() override {
+    return {ApiRoute("/devices/{id}", WebModule::WM_GET,
+                     [](WebRequest &req, WebResponse &res) {
+                       res.setContent("{\"id\":\"" +
+                                          req.getRouteParameter("id") +
+                                          "\"}",
+                                      "application/json");
+                     })};
+  }
+  std::vector<RouteVariant> getHttpsRoutes() override {
+    return getHttpRoutes();
+  }
+  String getModuleName() const override { return "devices"; }
+};
+
+} // namespace
+
+void run_interface_benchmarks() {
+  bench::printHeader("Interface types");
+
+  // normalizeApiPath is private; the difference between these two rows is
+  // what it costs when the path carries an /api prefix
+  bench::run("ApiRoute ctor, normalized path", 200000, [] {
+    ApiRoute route("/devices/{id}", WebModule::WM_GET, noopHandler);
+    bench::doNotOptimize(route);
+  });
+  bench::run("ApiRoute ctor, /api prefixed path", 200000, [] {
+    ApiRoute route("/api/devices/{id}", WebModule::WM_GET, noopHandler);
+    bench::doNotOptimize(route);
+  });
+  bench::run("WebRoute ctor with auth", 200000, [] {
+    WebRoute route("/settings", WebModule::WM_GET, noopHandler,
+                   {AuthType::SESSION});
+    bench::doNotOptimize(route);
+  });
+
+  bench::run("OpenAPIFactory::create (2 tags)", 200000, [] {
+    OpenAPIDocumentation docs = OpenAPIFactory::create(
+        "Get device", "Returns one device", "getDevice", {"Devices", "Core"});
+    bench::doNotOptimize(docs);
+  });
+  bench::run("OpenAPIFactory::generateOperationId", 200000, [] {
+    String id = OpenAPIFactory::generateOperationId("get", "DeviceStatus");
+    bench::doNotOptimize(id);
+  });
+  bench::run("OpenAPIFactory::createSuccessResponse", 200000, [] {
+    OpenAPISchemaRef schema = OpenAPIFactory::createSuccessResponse();
+    bench::doNotOptimize(schema);
+  });
+  bench::run("OpenAPIFactory::createErrorResponse", 200000, [] {
+    OpenAPISchemaRef schema = OpenAPIFactory::createErrorResponse();
+    bench::doNotOptimize(schema);
+  });
+  bench::run("OpenAPIFactory::createListResponse", 200000, [] {
+    OpenAPISchemaRef schema = OpenAPIFactory::createListResponse("devices");
+    bench::doNotOptimize(schema);
+  });
+  bench::run("OpenAPIFactory::createIdParameter", 200000, [] {
+    OpenAPISchemaRef schema =
+        OpenAPIFactory::createIdParameter("id", "Device ID");
+    bench::doNotOptimize(schema);
+  });
+
+  StaticJsonDocument<256> doc;
+  doc["name"] = "Lamp";
+  doc["level"] = 80;
+  doc["online"] = true;
+  bench::run("serializeJsonToStdString (3 members)", 200000, [&doc] {
+    std::string json = StringCompat::serializeJsonToStdString(doc);
+    bench::doNotOptimize(json);
+  });
+
+  bench::run("WebResponse setContent + setHeader", 200000, [] {
+    WebResponse response;
+    response.setContent("{\"ok\":true}", "application/json");
+    response.setHeader("Cache-Control", "no-store");
+    bench::doNotOptimize(response);
+  });
+  bench::run("WebResponse setJsonContent (3 members)", 200000, [&doc] {
+    WebResponse response;
+    response.setJsonContent(doc);
+    bench::doNotOptimize(response);
+  });
+
+  // Bound like a platform-dispatched request, so the pooled document is
+  // reused per route and the Accept header is negotiated
+  MockWebPlatform platform;
+  const char raw[] = "GET /api/devices HTTP/1.1\r\n"
+                     "Accept: application/json\r\n\r\n";
+  WebRequest request(raw, sizeof(raw) - 1);
+  bench::run("MockWebPlatform createJsonResponse", 200000, [&] {
+    WebResponse response;
+    response.bindRequest(request);
+    platform.createJsonResponse(response, [](JsonObject &obj) {
+      obj["name"] = "Lamp";
+      obj["level"] = 80;
+      obj["online"] = true;
+    });
+    bench::doNotOptimize(response);
+  });
+  bench::run("MockWebPlatform createJsonArrayResponse (4)", 200000, [&] {
+    WebResponse response;
+    response.bindRequest(request);
+    platform.createJsonArrayResponse(response, [](JsonArray &array) {
+      for (int i = 0; i < 4; i++) {
+        array.add(i);
+      }
+    });
+    bench::doNotOptimize(response);
+  });
+
+  // A registered module handler, resolved and run the way module tests do
+  DeviceModule module;
+  platform.registerModule("/home", &module);
+  const char get[] = "GET /api/home/devices/7 HTTP/1.1\r\n\r\n";
+  WebRequest deviceRequest(get, sizeof(get) - 1);
+  const String path = "/api/home/devices/7";
+  bench::run("MockWebPlatform findRoute + handler", 200000, [&] {
+    RouteTrie::Match match;
+    const MockWebPlatform::RegisteredRoute *route =
+        platform.findRoute(path, WebModule::WM_GET, match);
+    deviceRequest.setMatchedRoute(match.pattern);
+    WebResponse response;
+    route->handler(deviceRequest, response);
+    bench::doNotOptimize(response);
+  });
+  bench::run("MockWebRequest/MockWebResponse handler", 200000, [] {
+    MockWebRequest request("/api/home/devices");
+    request.setParam("id", "7");
+    request.setMockHeader("Accept", "application/json");
+    MockWebResponse response;
+    runTestOperation(request, response,
+                     [](MockWebRequest &req, MockWebResponse &res) {
+                       res.setContent("{\"id\":\"" + req.getParam("id") +
+                                          "\"}",
+                                      "application/json");
+                       res.setHeader("Cache-Control", "no-store");
+                     });
+    bench::doNotOptimize(response);
+  });
+}
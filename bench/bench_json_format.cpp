@@ -0,0 +1,79 @@
+#include "bench_harness.h"
+#include "bench_suites.h"
+#include <interface/utils/json_format.h>
+#include <interface/web_response.h>
+#include <vector>
+
+// JSON against MessagePack for a typical API body: a list of devices as
+// returned by createJsonArrayResponse(). Sizes are the bytes on the wire;
+// times cover serializing into a preallocated buffer, parsing a received
+// body and the full WebResponse path a negotiated response takes.
+
+namespace {
+
+const int DEVICE_COUNT = 20;
+
+void buildDevices(JsonDocument &doc) {
+  JsonArray devices = doc.to<JsonArray>();
+  for (int i = 0; i < DEVICE_COUNT; i++) {
+    JsonObject device = devices.createNestedObject();
+    device["id"] = i;
+    device["name"] = "sensor";
+    device["online"] = i % 3 != 0;
+    device["level"] = i * 5;
+    device["temperature"] = 20.5 + i * 0.25;
+    device["firmware"] = "1.4.2";
+  }
+}
+
+} // namespace
+
+void run_json_format_benchmarks() {
+  bench::printHeader("JSON vs MessagePack bodies");
+
+  DynamicJsonDocument doc(8192);
+  buildDevices(doc);
+  size_t jsonSize = measureJson(doc);
+  size_t msgPackSize = measureMsgPack(doc);
+  bench::note("%d devices: JSON %zu bytes, MessagePack %zu bytes (%.1f%%)\n",
+              DEVICE_COUNT, jsonSize, msgPackSize,
+              100.0 * msgPackSize / jsonSize);
+
+  std::vector<char> json(jsonSize + 1);
+  std::vector<char> msgPack(msgPackSize);
+  bench::run("serializeJson", 50000, [&] {
+    bench::doNotOptimize(serializeJson(doc, json.data(), json.size()));
+  });
+  bench::run("serializeMsgPack", 50000, [&] {
+    bench::doNotOptimize(serializeMsgPack(doc, msgPack.data(), msgPack.size()));
+  });
+
+  DynamicJsonDocument parsed(
+      JsonFormats::documentCapacity(jsonSize, JsonFormat::JSON));
+  StringView jsonBody(json.data(), jsonSize);
+  StringView msgPackBody(msgPack.data(), msgPackSize);
+  bench::run("deserialize JSON body", 50000, [&] {
+    bench::doNotOptimize(
+        JsonFormats::deserialize(parsed, jsonBody, JsonFormat::JSON));
+  });
+  bench::run("deserialize MessagePack body", 50000, [&] {
+    bench::doNotOptimize(
+        JsonFormats::deserialize(parsed, msgPackBody, JsonFormat::MSGPACK));
+  });
+
+  bench::run("WebResponse::setJsonContent, JSON", 50000, [&] {
+    WebResponse response;
+    response.setJsonContent(doc, JsonFormat::JSON);
+    bench::doNotOptimize(response);
+  });
+  bench::run("WebResponse::setJsonContent, MessagePack", 50000, [&] {
+    WebResponse response;
+    response.setJsonContent(doc, JsonFormat::MSGPACK);
+    bench::doNotOptimize(response);
+  });
+
+  bench::run("negotiate Accept header", 1000000, [] {
+    bench::doNotOptimize(JsonFormats::negotiate(
+        "application/msgpack, application/json;q=0.9, */*;q=0.1"));
+  });
+}
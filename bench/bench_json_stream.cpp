@@ -0,0 +1,87 @@
+#include "bench_harness.h"
+#include "bench_suites.h"
+#include <interface/web_response.h>
+#include <string>
+
+// Heap traffic to produce a device-list response: building a JsonDocument,
+// serializing it to std::string and copying into the response (what
+// createJsonResponse does) versus streaming through JsonStreamWriter.
+
+namespace {
+
+struct Device {
+  int id;
+  const char *name;
+  bool on;
+  int level;
+};
+
+const Device DEVICES[] = {{1, "Living room lamp", true, 80},
+                          {2, "Kitchen strip", false, 0},
+                          {3, "Porch light", true, 100},
+                          {4, "Bedroom fan", false, 35}};
+
+void buildResponse(WebResponse &res, size_t count) {
+  DynamicJsonDocument doc(count * 128 + 64);
+  JsonArray devices = doc.createNestedArray("devices");
+  for (size_t i = 0; i < count; i++) {
+    const Device &d = DEVICES[i % 4];
+    JsonObject item = devices.createNestedObject();
+    item["id"] = d.id + static_cast<int>(i);
+    item["name"] = d.name;
+    item["on"] = d.on;
+    item["level"] = d.level;
+  }
+  std::string json;
+  serializeJson(doc, json);
+  res.setContent(String(json.c_str()), "application/json");
+}
+
+void streamResponse(WebResponse &res, size_t count) {
+  res.setJsonStreamContent([count](JsonStreamWriter &json) {
+    json.beginObject().key("devices").beginArray();
+    for (size_t i = 0; i < count; i++) {
+      const Device &d = DEVICES[i % 4];
+      json.beginObject()
+          .member("id", d.id + static_cast<int>(i))
+          .member("name", d.name)
+          .member("on", d.on)
+          .member("level", d.level)
+          .endObject();
+    }
+    json.endArray().endObject();
+  });
+}
+
+// Stands in for the socket: consumes chunks without keeping them
+bool discardChunk(const char *data, size_t length) {
+  bench::doNotOptimize(data[length - 1]);
+  return true;
+}
+
+} // namespace
+
+void run_json_stream_benchmarks() {
+  bench::printHeader("JSON response: document + copies vs streaming");
+
+  const size_t counts[] = {4, 64, 1024};
+  for (size_t count : counts) {
+    const uint64_t iterations = count > 100 ? 200 : 5000;
+    char name[64];
+    snprintf(name, sizeof(name), "document, %zu devices", count);
+    bench::run(name, iterations, [count]() {
+      WebResponse res;
+      buildResponse(res, count);
+      // A real server hands the content String to the socket as is
+      bench::doNotOptimize(res.getContent().length());
+    });
+    snprintf(name, sizeof(name), "stream, %zu devices", count);
+    bench::run(name, iterations, [count]() {
+      WebResponse res;
+      streamResponse(res, count);
+      bench::doNotOptimize(res.writeJsonStream(&discardChunk));
+    });
+  }
+  bench::note("stream buffer: %d bytes on the writer's stack frame\n",
+              JSON_STREAM_BUFFER_SIZE);
+}
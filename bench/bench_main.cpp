@@ -0,0 +1,24 @@
+#include "bench_harness.h"
+#include "bench_suites.h"
+
+// Entry point for the bench_native environment:
+//   pio run -e bench_native && .pio/build/bench_native/program [options]
+// Options are described in bench_harness.h.
+int main(int argc, char **argv) {
+  if (!bench::configure(argc, argv)) {
+    return 1;
+  }
+  run_route_trie_benchmarks();
+  run_route_variant_benchmarks();
+  run_auth_mask_benchmarks();
+  run_handler_benchmarks();
+  run_web_request_benchmarks();
+  run_json_stream_benchmarks();
+  run_interface_benchmarks();
+  run_openapi_components_benchmarks();
+  run_request_validator_benchmarks();
+  run_json_format_benchmarks();
+  run_storage_benchmarks();
+  run_gzip_benchmarks();
+  return 0;
+}
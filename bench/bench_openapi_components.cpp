@@ -0,0 +1,98 @@
+#include "bench_harness.h"
+#include "bench_suites.h"
+#include <interface/openapi_factory.h>
+#include <vector>
+
+// Memory held by the documentation of a 100-route module whose routes use
+// the OpenAPIFactory schemas: a full schema copy per route (the default)
+// versus the shared component $ref (WEB_PLATFORM_OPENAPI_COMPONENTS).
+// Components are interned directly so both sides run in any build.
+
+namespace {
+
+const size_t ROUTE_COUNT = 100;
+
+OpenAPISchemaRef schemaFor(OpenAPIComponents::Kind kind,
+                           const String &description, bool shared,
+                           const String &parameter = String()) {
+  return shared ? OpenAPISchemaRef::interned(kind, description, parameter)
+                : OpenAPISchemaRef(OpenAPIComponents::standalone(
+                      kind, description, parameter));
+}
+
+// CRUD-style mix: list, get by ID, update and delete per resource
+void document(OpenAPIDocumentation &doc, size_t route, bool shared) {
+  typedef OpenAPIComponents::Kind Kind;
+  OpenAPISchemaRef schema;
+  switch (route % 4) {
+  case 0:
+    schema = schemaFor(Kind::LIST_RESPONSE, "List of devices", shared);
+    break;
+  case 1:
+    doc.withParameters(schemaFor(Kind::ID_PARAMETER, "ID", shared, "id"));
+    schema = schemaFor(Kind::SUCCESS_RESPONSE,
+                       "Operation completed successfully", shared);
+    break;
+  case 2:
+    schema = schemaFor(Kind::SUCCESS_RESPONSE, "Device updated", shared);
+    break;
+  default:
+    schema = schemaFor(Kind::ERROR_RESPONSE, "Details about the error",
+                       shared);
+    break;
+  }
+  doc.withResponseSchema(schema);
+}
+
+struct Footprint {
+  uint64_t liveBytes; // Heap held by the docs once built
+  double allocs;      // Per route, including temporaries
+};
+
+Footprint measureModule(bool shared) {
+  std::vector<OpenAPIDocumentation> docs(ROUTE_COUNT);
+  uint64_t before = allocLiveBytes();
+  AllocScope scope;
+  for (size_t i = 0; i < ROUTE_COUNT; i++) {
+    document(docs[i], i, shared);
+  }
+  AllocStats used = scope.stats();
+  Footprint footprint = {allocLiveBytes() - before,
+                         static_cast<double>(used.count) / ROUTE_COUNT};
+  bench::doNotOptimize(docs.data());
+  return footprint;
+}
+
+} // namespace
+
+void run_openapi_components_benchmarks() {
+  bench::printHeader("OpenAPI components (100 routes)");
+
+  // Register the components first so neither side pays for that
+  measureModule(true);
+  Footprint copied = measureModule(false);
+  Footprint shared = measureModule(true);
+  bench::report("schema String per route",
+                {0.0 / 0.0, copied.allocs,
+                 static_cast<double>(copied.liveBytes) / ROUTE_COUNT});
+  bench::report("component $ref per route",
+                {0.0 / 0.0, shared.allocs,
+                 static_cast<double>(shared.liveBytes) / ROUTE_COUNT});
+  bench::note("docs heap for %u routes: copies %llu bytes, $refs %llu "
+              "bytes; %u shared components\n",
+              static_cast<unsigned>(ROUTE_COUNT),
+              static_cast<unsigned long long>(copied.liveBytes),
+              static_cast<unsigned long long>(shared.liveBytes),
+              static_cast<unsigned>(OpenAPIComponents::shared().size()));
+
+  bench::run("createSuccessResponse as String", 100000, [] {
+    String schema = OpenAPIFactory::createSuccessResponse();
+    bench::doNotOptimize(schema);
+  });
+  bench::run("interned success schema handle", 100000, [] {
+    OpenAPISchemaRef schema = OpenAPISchemaRef::interned(
+        OpenAPIComponents::Kind::SUCCESS_RESPONSE,
+        "Operation completed successfully");
+    bench::doNotOptimize(schema);
+  });
+}
@@ -0,0 +1,100 @@
+#include "bench_harness.h"
+#include "bench_suites.h"
+#include <interface/utils/request_validator.h>
+#include <string.h>
+
+// Request body validation against a compiled schema, next to the
+// equivalent checks written by hand in a handler. Bodies are parsed once
+// outside the loop: platforms validate the document the request already
+// holds.
+
+namespace {
+
+const char SCHEMA[] = R"({
+    "type": "object",
+    "properties": {
+        "name": {"type": "string", "maxLength": 32},
+        "level": {"type": "integer", "minimum": 0, "maximum": 100},
+        "mode": {"type": "string", "enum": ["auto", "manual", "off"]},
+        "schedule": {
+            "type": "array",
+            "maxItems": 7,
+            "items": {"type": "integer", "minimum": 0, "maximum": 6}
+        }
+    },
+    "required": ["name", "level"]
+})";
+
+const char VALID_BODY[] =
+    R"({"name": "living room", "level": 80, "mode": "manual",
+        "schedule": [0, 1, 2, 3, 4]})";
+const char INVALID_BODY[] = R"({"name": "living room", "level": 180})";
+
+bool handWritten(JsonVariantConst body) {
+  JsonObjectConst object = body.as<JsonObjectConst>();
+  if (object.isNull()) {
+    return false;
+  }
+  JsonVariantConst name = object["name"];
+  if (!name.is<const char *>() || strlen(name.as<const char *>()) > 32) {
+    return false;
+  }
+  JsonVariantConst level = object["level"];
+  if (!level.is<long>() || level.as<long>() < 0 || level.as<long>() > 100) {
+    return false;
+  }
+  JsonVariantConst mode = object["mode"];
+  if (!mode.isNull()) {
+    const char *text = mode.as<const char *>();
+    if (!text || (strcmp(text, "auto") != 0 && strcmp(text, "manual") != 0 &&
+                  strcmp(text, "off") != 0)) {
+      return false;
+    }
+  }
+  JsonVariantConst schedule = object["schedule"];
+  if (!schedule.isNull()) {
+    if (!schedule.is<JsonArrayConst>() || schedule.size() > 7) {
+      return false;
+    }
+    for (JsonVariantConst day : schedule.as<JsonArrayConst>()) {
+      if (!day.is<long>() || day.as<long>() < 0 || day.as<long>() > 6) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+void run_request_validator_benchmarks() {
+  bench::printHeader("Request body validation");
+
+  bench::run("compile schema (4 properties)", 20000, [] {
+    RequestValidator validator;
+    bench::doNotOptimize(validator.compile(SCHEMA));
+  });
+
+  RequestValidator validator;
+  validator.compile(SCHEMA);
+  bench::note("compiled: %u rules, %u bytes of tables\n",
+              static_cast<unsigned>(validator.ruleCount()),
+              static_cast<unsigned>(validator.memoryUsage()));
+
+  DynamicJsonDocument valid(1024);
+  deserializeJson(valid, VALID_BODY);
+  DynamicJsonDocument invalid(1024);
+  deserializeJson(invalid, INVALID_BODY);
+  JsonVariantConst validBody = valid.as<JsonVariantConst>();
+  JsonVariantConst invalidBody = invalid.as<JsonVariantConst>();
+
+  bench::run("RequestValidator, valid body", 1000000, [&] {
+    bench::doNotOptimize(validator.validate(validBody));
+  });
+  bench::run("RequestValidator, invalid body", 1000000, [&] {
+    bench::doNotOptimize(validator.validate(invalidBody));
+  });
+  bench::run("hand-written checks, valid body", 1000000, [&] {
+    bench::doNotOptimize(handWritten(validBody));
+  });
+}
@@ -0,0 +1,113 @@
+#include "bench_harness.h"
+#include "bench_suites.h"
+#include <cstring>
+#include <interface/utils/route_trie.h>
+#include <string>
+#include <vector>
+
+// Compares RouteTrie lookups with the linear pattern walk used before the
+// trie existed. Trie latency should stay flat as the route count grows.
+
+namespace {
+
+struct Pattern {
+  std::string path;
+  WebModule::Method method;
+};
+
+// Segment-by-segment comparison against every registered pattern
+int linearMatch(const std::vector<Pattern> &patterns, const char *path,
+                WebModule::Method method) {
+  for (size_t i = 0; i < patterns.size(); i++) {
+    if (patterns[i].method != method) {
+      continue;
+    }
+    const char *p = patterns[i].path.c_str();
+    const char *s = path;
+    bool ok = true;
+    while (*p && ok) {
+      if (*p == '*') {
+        return static_cast<int>(i);
+      }
+      if (*p == '{') {
+        while (*p && *p != '}')
+          p++;
+        if (*p)
+          p++;
+        if (!*s || *s == '/') {
+          ok = false;
+        }
+        while (*s && *s != '/')
+          s++;
+      } else if (*p++ != *s++) {
+        ok = false;
+      }
+    }
+    if (ok && !*s) {
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
+
+void buildRoutes(size_t count, std::vector<Pattern> &patterns,
+                 std::vector<Pattern> &lookups) {
+  static const char *templates[] = {"/m%zu/status", "/m%zu/items/{id}",
+                                    "/m%zu/items/{id}/fields/{field}",
+                                    "/m%zu/assets/*"};
+  static const char *requests[] = {"/m%zu/status", "/m%zu/items/1234",
+                                   "/m%zu/items/1234/fields/name",
+                                   "/m%zu/assets/js/app.js"};
+  static const WebModule::Method methods[] = {
+      WebModule::WM_GET, WebModule::WM_GET, WebModule::WM_PUT,
+      WebModule::WM_GET};
+
+  char buffer[96];
+  for (size_t i = 0; i < count; i++) {
+    size_t module = i / 4;
+    size_t kind = i % 4;
+    snprintf(buffer, sizeof(buffer), templates[kind], module);
+    patterns.push_back({buffer, methods[kind]});
+    snprintf(buffer, sizeof(buffer), requests[kind], module);
+    lookups.push_back({buffer, methods[kind]});
+  }
+}
+
+} // namespace
+
+void run_route_trie_benchmarks() {
+  bench::printHeader("RouteTrie vs linear match");
+
+  const size_t counts[] = {10, 100, 500, 1000, 2000};
+  for (size_t count : counts) {
+    std::vector<Pattern> patterns;
+    std::vector<Pattern> lookups;
+    buildRoutes(count, patterns, lookups);
+
+    RouteTrie trie;
+    for (size_t i = 0; i < patterns.size(); i++) {
+      trie.insert(patterns[i].path.c_str(), patterns[i].method,
+                  static_cast<int>(i));
+    }
+
+    char name[64];
+    size_t next = 0;
+    RouteTrie::Match match;
+    snprintf(name, sizeof(name), "trie match, %zu routes", count);
+    bench::run(name, 200000, [&]() {
+      const Pattern &lookup = lookups[next++ % lookups.size()];
+      trie.match(lookup.path.c_str(), lookup.path.size(), lookup.method,
+                 match);
+      bench::doNotOptimize(match.routeId);
+    });
+
+    next = 0;
+    uint64_t linearIterations = count >= 1000 ? 5000 : 50000;
+    snprintf(name, sizeof(name), "linear match, %zu routes", count);
+    bench::run(name, linearIterations, [&]() {
+      const Pattern &lookup = lookups[next++ % lookups.size()];
+      int index = linearMatch(patterns, lookup.path.c_str(), lookup.method);
+      bench::doNotOptimize(index);
+    });
+  }
+}
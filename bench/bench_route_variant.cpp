@@ -0,0 +1,102 @@
+#include "bench_harness.h"
+#include "bench_suites.h"
+#include <interface/utils/route_variant.h>
+#include <vector>
+
+// Allocations per getHttpRoutes() call with the inline RouteVariant versus
+// the previous heap-allocating implementation (reproduced below).
+
+namespace {
+
+// RouteVariant as it was before inline storage: one heap node per route and
+// per copy, and no move constructor
+class LegacyRouteVariant {
+private:
+  enum Type { WEB_ROUTE, API_ROUTE } type;
+  union {
+    WebRoute *webRoute;
+    ApiRoute *apiRoute;
+  };
+
+public:
+  LegacyRouteVariant(const WebRoute &route) : type(WEB_ROUTE) {
+    webRoute = new WebRoute(route);
+  }
+  LegacyRouteVariant(const ApiRoute &route) : type(API_ROUTE) {
+    apiRoute = new ApiRoute(route);
+  }
+  LegacyRouteVariant(const LegacyRouteVariant &other) : type(other.type) {
+    if (type == WEB_ROUTE) {
+      webRoute = new WebRoute(*other.webRoute);
+    } else {
+      apiRoute = new ApiRoute(*other.apiRoute);
+    }
+  }
+  LegacyRouteVariant &operator=(const LegacyRouteVariant &other) {
+    if (this != &other) {
+      LegacyRouteVariant copy(other);
+      std::swap(type, copy.type);
+      std::swap(webRoute, copy.webRoute);
+    }
+    return *this;
+  }
+  ~LegacyRouteVariant() {
+    if (type == WEB_ROUTE) {
+      delete webRoute;
+    } else {
+      delete apiRoute;
+    }
+  }
+};
+
+void noopHandler(WebRequest &, WebResponse &) {}
+
+// Typical module route table: pages plus a small REST API
+template <typename Variant> std::vector<Variant> moduleRoutes() {
+  return {WebRoute("/", WebModule::WM_GET, noopHandler),
+          WebRoute("/settings", WebModule::WM_GET, noopHandler,
+                   {AuthType::SESSION}),
+          WebRoute("/assets/app.js", WebModule::WM_GET, noopHandler,
+                   "application/javascript"),
+          ApiRoute("/status", WebModule::WM_GET, noopHandler),
+          ApiRoute("/devices", WebModule::WM_GET, noopHandler,
+                   {AuthType::TOKEN}),
+          ApiRoute("/devices/{id}", WebModule::WM_GET, noopHandler,
+                   {AuthType::TOKEN}),
+          ApiRoute("/devices/{id}", WebModule::WM_PUT, noopHandler,
+                   {AuthType::TOKEN}),
+          ApiRoute("/devices/{id}", WebModule::WM_DELETE, noopHandler,
+                   {AuthType::TOKEN})};
+}
+
+template <typename Variant> void report(const char *label) {
+  const uint64_t iterations = 20000;
+  char name[64];
+  snprintf(name, sizeof(name), "%s getHttpRoutes", label);
+  bench::run(name, iterations, []() {
+    std::vector<Variant> routes = moduleRoutes<Variant>();
+    bench::doNotOptimize(routes.data());
+  });
+
+  // Vector growth: relocation copies legacy variants, moves inline ones
+  std::vector<Variant> source = moduleRoutes<Variant>();
+  snprintf(name, sizeof(name), "%s copy into growing vector", label);
+  bench::run(name, iterations, [&]() {
+    std::vector<Variant> grown;
+    for (const auto &route : source) {
+      grown.push_back(route);
+    }
+    bench::doNotOptimize(grown.data());
+  });
+}
+
+} // namespace
+
+void run_route_variant_benchmarks() {
+  bench::printHeader("RouteVariant (8-route module)");
+  report<LegacyRouteVariant>("legacy");
+  report<RouteVariant>("inline");
+  bench::note("sizeof: legacy %zu, inline %zu, WebRoute %zu, ApiRoute %zu\n",
+              sizeof(LegacyRouteVariant), sizeof(RouteVariant),
+              sizeof(WebRoute), sizeof(ApiRoute));
+}
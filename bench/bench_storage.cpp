@@ -0,0 +1,134 @@
+#include "bench_harness.h"
+#include "bench_suites.h"
+
+#if defined(__linux__)
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <stdlib.h>
+#include <string>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <testing/native_storage_driver.h>
+#include <testing/native_web_platform.h>
+#include <unistd.h>
+#include <vector>
+
+// Large-object throughput of setStorageStreamContent over a loopback
+// socket: NativeFileStorageDriver with mmap (body sent from the mapping
+// with sendmsg) versus pread() into the response buffer, which is what a
+// driver without contiguousView() costs.
+
+namespace {
+
+const size_t OBJECT_SIZE = 8 * 1024 * 1024;
+
+class Client {
+public:
+  explicit Client(uint16_t port) : buffer(256 * 1024) {
+    fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(port);
+    connect(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address));
+  }
+  ~Client() { close(fd); }
+
+  // Send `request` and drain one response of `expected` bytes (measured on
+  // the first call when 0)
+  size_t fetch(NativeWebPlatform &platform, const std::string &request,
+               size_t expected) {
+    send(fd, request.data(), request.size(), MSG_NOSIGNAL);
+    std::string headers;
+    size_t received = 0;
+    while (expected == 0 || received < expected) {
+      platform.poll(0);
+      ssize_t count = recv(fd, buffer.data(), buffer.size(), MSG_DONTWAIT);
+      if (count <= 0) {
+        continue;
+      }
+      received += count;
+      if (expected == 0) {
+        headers.append(buffer.data(), count);
+        size_t end = headers.find("\r\n\r\n");
+        size_t length = headers.find("Content-Length: ");
+        if (end != std::string::npos && length != std::string::npos) {
+          expected = end + 4 + strtoul(headers.c_str() + length + 16,
+                                       nullptr, 10);
+        }
+      }
+    }
+    return expected;
+  }
+
+private:
+  int fd;
+  std::vector<char> buffer;
+};
+
+void measure(const char *name, const std::string &root, bool useMmap,
+             const char *range, size_t bodyBytes) {
+  if (!bench::selected(name)) {
+    return;
+  }
+  NativeFileStorageDriver driver(root, useMmap);
+  StorageDriverRegistry::registerDriver("bench", &driver);
+  NativeWebPlatform platform(0);
+  platform.registerWebRoute(
+      "/files/{name}",
+      [](WebRequest &req, WebResponse &res) {
+        res.setStorageStreamContent("files", req.getRouteParameter("name"),
+                                    "application/octet-stream", "bench");
+      },
+      {AuthType::NONE}, WebModule::WM_GET);
+  platform.begin("bench");
+
+  Client client(platform.getPort());
+  std::string request = "GET /files/object HTTP/1.1\r\n";
+  request += range;
+  request += "\r\n";
+  size_t expected = client.fetch(platform, request, 0);
+
+  bench::Result result = bench::run(
+      name, 20, [&]() { client.fetch(platform, request, expected); });
+  bench::note("%s: %.0f MB/s\n", name,
+              bodyBytes / (result.nsPerOp / 1e9) / (1024.0 * 1024.0));
+  StorageDriverRegistry::unregisterDriver("bench");
+}
+
+} // namespace
+
+void run_storage_benchmarks() {
+  bench::printHeader("Storage streaming (8 MiB object, loopback)");
+
+  char pattern[] = "/tmp/web_platform_bench_XXXXXX";
+  std::string root = mkdtemp(pattern);
+  std::string dir = root + "/files";
+  std::string path = dir + "/object";
+  mkdir(dir.c_str(), 0700);
+  std::vector<char> data(OBJECT_SIZE);
+  for (size_t i = 0; i < data.size(); i++) {
+    data[i] = static_cast<char>(i * 131);
+  }
+  FILE *file = fopen(path.c_str(), "wb");
+  fwrite(data.data(), 1, data.size(), file);
+  fclose(file);
+
+  measure("mmap + sendmsg, whole object", root, true, "", OBJECT_SIZE);
+  measure("pread copy, whole object", root, false, "", OBJECT_SIZE);
+  measure("mmap + sendmsg, last 1 MiB", root, true,
+          "Range: bytes=-1048576\r\n", 1024 * 1024);
+  measure("pread copy, last 1 MiB", root, false, "Range: bytes=-1048576\r\n",
+          1024 * 1024);
+
+  unlink(path.c_str());
+  rmdir(dir.c_str());
+  rmdir(root.c_str());
+}
+
+#else
+
+void run_storage_benchmarks() {}
+
+#endif // __linux__
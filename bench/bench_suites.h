@@ -0,0 +1,18 @@
+#ifndef BENCH_SUITES_H
+#define BENCH_SUITES_H
+
+// Benchmark suites, one per bench_*.cpp file
+void run_route_trie_benchmarks();
+void run_route_variant_benchmarks();
+void run_auth_mask_benchmarks();
+void run_handler_benchmarks();
+void run_web_request_benchmarks();
+void run_json_stream_benchmarks();
+void run_interface_benchmarks();
+void run_openapi_components_benchmarks();
+void run_request_validator_benchmarks();
+void run_json_format_benchmarks();
+void run_storage_benchmarks();
+void run_gzip_benchmarks();
+
+#endif // BENCH_SUITES_H
@@ -0,0 +1,106 @@
+#include "bench_harness.h"
+#include "bench_suites.h"
+#include <cstring>
+#include <interface/web_request.h>
+#include <map>
+
+// Heap allocations to build one request: the former representation
+// (separate Strings plus std::map<String, String> for params and headers)
+// versus the arena-backed WebRequest. Then the cost of lazy parsing by how
+// much of the request a handler actually reads.
+
+namespace {
+
+const char RAW_REQUEST[] = "GET /api/devices/7?fields=name,state&limit=10"
+                           "&sort=name HTTP/1.1\r\n"
+                           "Host: device.local\r\n"
+                           "User-Agent: Mozilla/5.0\r\n"
+                           "Accept: application/json\r\n"
+                           "Accept-Encoding: gzip, deflate\r\n"
+                           "Authorization: Bearer 0123456789abcdef\r\n"
+                           "Connection: keep-alive\r\n"
+                           "\r\n";
+
+const char JSON_REQUEST[] =
+    "POST /api/devices/7?dryRun=1&verbose=0 HTTP/1.1\r\n"
+    "Host: device.local\r\n"
+    "Content-Type: application/json\r\n"
+    "\r\n"
+    "{\"name\":\"Lamp\",\"level\":80,"
+    "\"schedule\":{\"on\":\"07:00\",\"off\":\"23:00\"}}";
+
+// Shape of WebRequest before the arena, filled the way servers did
+struct LegacyRequest {
+  String path;
+  String body;
+  String clientIp;
+  std::map<String, String> params;
+  std::map<String, String> headers;
+};
+
+LegacyRequest buildLegacy() {
+  LegacyRequest request;
+  request.path = "/api/devices/7";
+  request.clientIp = "192.168.1.20";
+  request.params["fields"] = "name,state";
+  request.params["limit"] = "10";
+  request.params["sort"] = "name";
+  request.headers["Host"] = "device.local";
+  request.headers["User-Agent"] = "Mozilla/5.0";
+  request.headers["Accept"] = "application/json";
+  request.headers["Accept-Encoding"] = "gzip, deflate";
+  request.headers["Authorization"] = "Bearer 0123456789abcdef";
+  request.headers["Connection"] = "keep-alive";
+  return request;
+}
+
+} // namespace
+
+void run_web_request_benchmarks() {
+  bench::printHeader("WebRequest (6 headers, 3 params)");
+
+  const uint64_t iterations = 20000;
+  bench::run("construct: String + std::map", iterations, []() {
+    LegacyRequest request = buildLegacy();
+    bench::doNotOptimize(request.headers.size());
+  });
+  bench::run("construct: RequestArena", iterations, []() {
+    WebRequest request(RAW_REQUEST, sizeof(RAW_REQUEST) - 1, "192.168.1.20");
+    bench::doNotOptimize(request.pathView().data());
+  });
+
+  // Reading a header: String lookup copies, the view does not. Common
+  // headers by name hash to their slot; HeaderId skips even that. An
+  // uncommon name scans every header field.
+  WebRequest request(RAW_REQUEST, sizeof(RAW_REQUEST) - 1, "192.168.1.20");
+  const uint64_t lookups = 1000000;
+  bench::run("getHeader(\"Authorization\")", lookups, [&]() {
+    String value = request.getHeader("Authorization");
+    bench::doNotOptimize(value.length());
+  });
+  bench::run("headerView(\"Authorization\")", lookups, [&]() {
+    bench::doNotOptimize(request.headerView("Authorization").data());
+  });
+  bench::run("headerView(HeaderId::AUTHORIZATION)", lookups, [&]() {
+    bench::doNotOptimize(request.headerView(HeaderId::AUTHORIZATION).data());
+  });
+  bench::run("headerView(uncommon name, miss)", lookups, [&]() {
+    bench::doNotOptimize(request.headerView("X-Not-Present").data());
+  });
+
+  // Parsing is deferred until a handler asks; reading everything is what
+  // every request paid when parsing was eager
+  bench::run("reads nothing (health check)", iterations, []() {
+    WebRequest req(JSON_REQUEST, sizeof(JSON_REQUEST) - 1);
+    bench::doNotOptimize(req.pathView().data());
+  });
+  bench::run("reads one query param", iterations, []() {
+    WebRequest req(JSON_REQUEST, sizeof(JSON_REQUEST) - 1);
+    bench::doNotOptimize(req.paramView("dryRun").data());
+  });
+  bench::run("reads params + JSON (eager)", iterations, []() {
+    WebRequest req(JSON_REQUEST, sizeof(JSON_REQUEST) - 1);
+    bench::doNotOptimize(req.paramView("dryRun").data());
+    bench::doNotOptimize(req.getJsonBody().isNull());
+  });
+}
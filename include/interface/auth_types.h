@@ -2,7 +2,10 @@
 #define AUTH_TYPES_H
 
 #include <Arduino.h>
+#include <initializer_list>
 #include <interface/string_compat.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <vector>
 
 /**
@@ -20,14 +23,145 @@ enum class AuthType {
   PAGE_TOKEN = 8  // CSRF protection for pages
 };
 
+/**
+ * AuthMask - Set of allowed AuthType values packed into one byte
+ *
+ * Represents the allowed authentication methods for a route. If multiple
+ * types are present, any one of them can satisfy the requirement (OR logic).
+ *
+ * The flag bits are the AuthType values themselves; NONE is 0 in the enum,
+ * so it gets the dedicated NONE_FLAG bit to stay distinguishable from an
+ * empty set. Membership tests are a single AND. For source compatibility
+ * with the former std::vector<AuthType>, the mask is built from the same
+ * initializer lists ({AuthType::SESSION, AuthType::TOKEN}) and exposes
+ * size(), operator[] and iteration, which list the members in ascending
+ * AuthType order. Duplicates collapse, as in any set.
+ */
+class AuthMask {
+public:
+  static constexpr uint8_t NONE_FLAG = 0x10;
+  static constexpr size_t TYPE_COUNT = 5; // NONE .. PAGE_TOKEN
+
+  class const_iterator {
+  public:
+    constexpr const_iterator(uint8_t bits, size_t position)
+        : bits(bits), position(position) {}
+
+    AuthType operator*() const { return typeAt(position); }
+    const_iterator &operator++() {
+      position = nextPosition(bits, position + 1);
+      return *this;
+    }
+    bool operator==(const const_iterator &other) const {
+      return position == other.position;
+    }
+    bool operator!=(const const_iterator &other) const {
+      return position != other.position;
+    }
+
+  private:
+    uint8_t bits;
+    size_t position;
+  };
+
+  constexpr AuthMask() : bits(0) {}
+  constexpr AuthMask(AuthType type) : bits(flagFor(type)) {}
+  constexpr AuthMask(std::initializer_list<AuthType> types)
+      : bits(flagsFor(types.begin(), types.end())) {}
+
+  // Migration aid for code that assembled requirements in a vector
+  AuthMask(const std::vector<AuthType> &types)
+      : bits(flagsFor(types.data(), types.data() + types.size())) {}
+
+  constexpr bool has(AuthType type) const {
+    return (bits & flagFor(type)) != 0;
+  }
+  // True when at least one real authentication method is listed
+  constexpr bool requiresAuth() const {
+    return (bits & ~NONE_FLAG) != 0;
+  }
+  constexpr uint8_t flags() const { return bits; }
+
+  // std::vector-compatible surface
+  size_t size() const {
+    size_t count = 0;
+    for (uint8_t remaining = bits; remaining; remaining &= remaining - 1) {
+      count++;
+    }
+    return count;
+  }
+  constexpr bool empty() const { return bits == 0; }
+  AuthType operator[](size_t index) const {
+    for (size_t position = nextPosition(bits, 0); position < TYPE_COUNT;
+         position = nextPosition(bits, position + 1)) {
+      if (index-- == 0) {
+        return typeAt(position);
+      }
+    }
+    return AuthType::NONE;
+  }
+  const_iterator begin() const {
+    return const_iterator(bits, nextPosition(bits, 0));
+  }
+  const_iterator end() const { return const_iterator(bits, TYPE_COUNT); }
+  void push_back(AuthType type) { bits |= flagFor(type); }
+  void clear() { bits = 0; }
+
+  constexpr bool operator==(const AuthMask &other) const {
+    return bits == other.bits;
+  }
+  constexpr bool operator!=(const AuthMask &other) const {
+    return bits != other.bits;
+  }
+  AuthMask &operator|=(const AuthMask &other) {
+    bits |= other.bits;
+    return *this;
+  }
+
+  friend constexpr AuthMask operator|(const AuthMask &a, const AuthMask &b) {
+    return AuthMask(static_cast<uint8_t>(a.bits | b.bits), RawFlags());
+  }
+
+private:
+  struct RawFlags {};
+  constexpr AuthMask(uint8_t bits, RawFlags) : bits(bits) {}
+
+  static constexpr uint8_t flagFor(AuthType type) {
+    return type == AuthType::NONE ? NONE_FLAG : static_cast<uint8_t>(type);
+  }
+  static constexpr uint8_t flagsFor(const AuthType *first,
+                                    const AuthType *last) {
+    return first == last ? 0 : flagFor(*first) | flagsFor(first + 1, last);
+  }
+  // Position 0 is NONE, position n is the AuthType with value 1 << (n - 1)
+  static constexpr uint8_t flagAt(size_t position) {
+    return position == 0 ? NONE_FLAG
+                         : static_cast<uint8_t>(1 << (position - 1));
+  }
+  static constexpr AuthType typeAt(size_t position) {
+    return position == 0 ? AuthType::NONE
+                         : static_cast<AuthType>(1 << (position - 1));
+  }
+  static size_t nextPosition(uint8_t bits, size_t position) {
+    while (position < TYPE_COUNT && !(bits & flagAt(position))) {
+      position++;
+    }
+    return position;
+  }
+
+  uint8_t bits;
+};
+
+constexpr AuthMask operator|(AuthType a, AuthType b) {
+  return AuthMask(a) | AuthMask(b);
+}
+
 /**
  * Authentication Requirements Container
  *
- * Contains a list of AuthType values that represent allowed authentication
- * methods for a route. If multiple types are present, any one of them
- * can satisfy the requirement (OR logic).
+ * Allowed authentication methods for a route (see AuthMask).
  */
-using AuthRequirements = std::vector<AuthType>;
+using AuthRequirements = AuthMask;
 
 /**
  * Authentication Context
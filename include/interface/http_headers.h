@@ -0,0 +1,119 @@
+#ifndef HTTP_HEADERS_H
+#define HTTP_HEADERS_H
+
+#include <interface/utils/string_view.h>
+#include <stdint.h>
+
+// Request headers every server collects and WebRequest stores in fixed
+// slots. Single source for HeaderId and COMMON_HTTP_HEADERS.
+#define WEB_PLATFORM_COMMON_HEADERS(X)                                         \
+  X(HOST, "Host")                                                              \
+  X(USER_AGENT, "User-Agent")                                                  \
+  X(ACCEPT, "Accept")                                                          \
+  X(ACCEPT_LANGUAGE, "Accept-Language")                                        \
+  X(ACCEPT_ENCODING, "Accept-Encoding")                                        \
+  X(CONTENT_TYPE, "Content-Type")                                              \
+  X(CONTENT_LENGTH, "Content-Length")                                          \
+  X(AUTHORIZATION, "Authorization")                                            \
+  X(COOKIE, "Cookie")                                                          \
+  X(X_CSRF_TOKEN, "X-CSRF-Token")                                              \
+  X(X_REQUESTED_WITH, "X-Requested-With")                                      \
+  X(REFERER, "Referer")                                                        \
+  X(CACHE_CONTROL, "Cache-Control")                                            \
+  X(CONNECTION, "Connection")                                                  \
+  X(PRAGMA, "Pragma")                                                          \
+  X(IF_NONE_MATCH, "If-None-Match")                                            \
+  X(RANGE, "Range")                                                            \
+  X(IF_RANGE, "If-Range")
+
+/**
+ * HeaderId - Interned identifiers for the common request headers
+ *
+ * Lets hot paths (auth middleware, content negotiation) read a header with
+ * WebRequest::getHeader(HeaderId) / headerView(HeaderId) instead of
+ * hashing and comparing a name on every request.
+ */
+enum class HeaderId : uint8_t {
+#define WEB_PLATFORM_HEADER_ID(id, name) id,
+  WEB_PLATFORM_COMMON_HEADERS(WEB_PLATFORM_HEADER_ID)
+#undef WEB_PLATFORM_HEADER_ID
+      UNKNOWN
+};
+
+namespace HttpHeaders {
+
+static constexpr size_t COUNT = static_cast<size_t>(HeaderId::UNKNOWN);
+
+// Canonical spelling of a common header; "" for UNKNOWN
+constexpr const char *name(HeaderId id) {
+  return
+#define WEB_PLATFORM_HEADER_NAME(headerId, headerName)                         \
+  id == HeaderId::headerId ? headerName:
+      WEB_PLATFORM_COMMON_HEADERS(WEB_PLATFORM_HEADER_NAME)
+#undef WEB_PLATFORM_HEADER_NAME
+          "";
+}
+
+constexpr char lower(char c) {
+  return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+constexpr size_t length(const char *text) {
+  return *text ? 1 + length(text + 1) : 0;
+}
+
+// Case-insensitive hash of length, first and last character. The
+// multipliers were chosen so the common headers land in distinct slots;
+// the static_assert below re-checks that whenever the list changes.
+static constexpr size_t HASH_SLOTS = 32;
+
+constexpr size_t hash(const char *text, size_t length) {
+  return length == 0 ? 0
+                     : (length + 13 * static_cast<unsigned char>(
+                                          lower(text[0])) +
+                        3 * static_cast<unsigned char>(
+                                lower(text[length - 1]))) %
+                           HASH_SLOTS;
+}
+
+struct SlotTable {
+  uint8_t slots[HASH_SLOTS];
+  bool perfect;
+};
+
+constexpr SlotTable buildSlotTable() {
+  SlotTable table = {{}, true};
+  for (size_t slot = 0; slot < HASH_SLOTS; slot++) {
+    table.slots[slot] = static_cast<uint8_t>(HeaderId::UNKNOWN);
+  }
+  for (size_t i = 0; i < COUNT; i++) {
+    const char *headerName = name(static_cast<HeaderId>(i));
+    size_t slot = hash(headerName, length(headerName));
+    if (table.slots[slot] != static_cast<uint8_t>(HeaderId::UNKNOWN)) {
+      table.perfect = false;
+    }
+    table.slots[slot] = static_cast<uint8_t>(i);
+  }
+  return table;
+}
+
+static constexpr SlotTable SLOT_TABLE = buildSlotTable();
+static_assert(SLOT_TABLE.perfect,
+              "HeaderId hash collision: adjust HttpHeaders::hash multipliers");
+
+// Map a header name (any case) to its HeaderId, UNKNOWN if not common
+inline HeaderId idFromName(StringView headerName) {
+  if (headerName.empty()) {
+    return HeaderId::UNKNOWN;
+  }
+  HeaderId id = static_cast<HeaderId>(
+      SLOT_TABLE.slots[hash(headerName.data(), headerName.length())]);
+  if (id == HeaderId::UNKNOWN || !headerName.equalsIgnoreCase(name(id))) {
+    return HeaderId::UNKNOWN;
+  }
+  return id;
+}
+
+} // namespace HttpHeaders
+
+#endif // HTTP_HEADERS_H
@@ -0,0 +1,131 @@
+#ifndef OPENAPI_COMPONENTS_H
+#define OPENAPI_COMPONENTS_H
+
+#include <Arduino.h>
+#include <interface/openapi_types.h>
+#include <interface/utils/json_stream_writer.h>
+#include <memory>
+#include <stdint.h>
+#include <vector>
+
+// Opt in to shared components for the OpenAPIFactory schema helpers. Off by
+// default: docs keep the full schema text, as spec generators that do not
+// write OpenAPIComponents (the ESP32 WebPlatform's, until it does) would
+// otherwise serve dangling $refs. NativeWebPlatform, MockWebPlatform and
+// tools/openapi_extract write the components and can enable it.
+#ifndef WEB_PLATFORM_OPENAPI_COMPONENTS
+#define WEB_PLATFORM_OPENAPI_COMPONENTS 0
+#endif
+
+/**
+ * OpenAPIComponents - Interned schemas shared by many routes
+ *
+ * The standard success, error and list response schemas and the path ID
+ * parameter are the same few hundred bytes of JSON on almost every route.
+ * Instead of a copy per route, each distinct variant (kind plus
+ * description) is registered here once. Routes store only a short
+ * {"$ref": "#/components/..."} text owned by the registry, and
+ * OpenAPISpecWriter writes each component's full definition once under
+ * components/schemas or components/parameters.
+ *
+ * Components live for the rest of the program: docs borrow their $ref
+ * text, so entries are never moved or removed. Registration happens while
+ * routes are built at start-up and is not thread-safe.
+ */
+class OpenAPIComponents {
+public:
+  enum class Kind : uint8_t {
+    SUCCESS_RESPONSE,
+    ERROR_RESPONSE,
+    LIST_RESPONSE,
+    ID_PARAMETER
+  };
+
+  struct Component {
+    Kind kind;
+    String name;        // Key under components/, e.g. "ErrorResponse2"
+    String description; // Of the message, error, list or parameter
+    String parameter;   // Parameter name (ID_PARAMETER only)
+    String ref;         // {"$ref":"#/components/schemas/<name>"}
+  };
+
+  // The registry OpenAPIFactory interns into and the spec writer emits
+  static OpenAPIComponents &shared();
+
+  // The component for this kind and description, registered on first use.
+  // `parameter` is the path parameter name for ID_PARAMETER.
+  const Component &intern(Kind kind, const String &description,
+                          const String &parameter = String());
+
+  // A component that is not registered: its definition only, no $ref
+  static std::shared_ptr<const Component>
+  standalone(Kind kind, const String &description,
+             const String &parameter = String());
+
+  // Write the "schemas" and "parameters" members of the components object;
+  // nothing when no component of that section is registered
+  void write(JsonStreamWriter &writer) const;
+
+  // A component's full definition (the value under its name)
+  static void writeDefinition(JsonStreamWriter &writer,
+                              const Component &component);
+
+  size_t size() const { return components.size(); }
+
+private:
+  void writeSection(JsonStreamWriter &writer, const char *section,
+                    bool parameters) const;
+
+  std::vector<std::unique_ptr<Component>> components;
+};
+
+/**
+ * OpenAPISchemaRef - Handle to a factory schema
+ *
+ * Returned by the OpenAPIFactory schema helpers. With
+ * WEB_PLATFORM_OPENAPI_COMPONENTS the handle points to an interned
+ * component, and passing it to an OpenAPIDoc builder (withResponseSchema,
+ * withParameters, ...) stores the borrowed $ref text: no copy per route.
+ * Otherwise it holds a standalone component and builders store the full
+ * definition, as the factory did before components existed. Converting it
+ * to String always yields the full definition as compact JSON.
+ */
+class OpenAPISchemaRef {
+public:
+  OpenAPISchemaRef() = default;
+  explicit OpenAPISchemaRef(const OpenAPIComponents::Component *component)
+      : component(component) {}
+  explicit OpenAPISchemaRef(
+      std::shared_ptr<const OpenAPIComponents::Component> standalone)
+      : owner(std::move(standalone)), component(owner.get()) {}
+
+  // Handle to the component registered in OpenAPIComponents::shared()
+  static OpenAPISchemaRef interned(OpenAPIComponents::Kind kind,
+                                   const String &description,
+                                   const String &parameter = String()) {
+    return OpenAPISchemaRef(
+        &OpenAPIComponents::shared().intern(kind, description, parameter));
+  }
+
+  bool empty() const { return component == nullptr; }
+  // Whether builders get a $ref to a shared component
+  bool isShared() const { return component && !owner; }
+  const char *name() const { return component ? component->name.c_str() : ""; }
+
+  // {"$ref":"..."} text; "" for empty and standalone handles
+  const char *ref() const { return component ? component->ref.c_str() : ""; }
+
+  // The full definition as compact JSON
+  String toString() const;
+
+  operator String() const { return toString(); }
+  operator OpenAPIText() const {
+    return owner ? OpenAPIText(toString()) : OpenAPIText(ref());
+  }
+
+private:
+  std::shared_ptr<const OpenAPIComponents::Component> owner;
+  const OpenAPIComponents::Component *component = nullptr;
+};
+
+#endif // OPENAPI_COMPONENTS_H
@@ -1,6 +1,7 @@
 #ifndef OPENAPI_FACTORY_H
 #define OPENAPI_FACTORY_H
 
+#include <interface/openapi_components.h>
 #include <interface/openapi_types.h>
 
 /**
@@ -10,99 +11,53 @@
 class OpenAPIFactory {
 public:
   /**
-   * Create a basic OpenAPI documentation object
+   * Create a basic OpenAPI documentation object. Literal arguments are
+   * borrowed, String arguments copied (see OpenAPIText).
    */
-  static OpenAPIDocumentation create(const String &summary,
-                                     const String &description = "",
-                                     const String &operationId = "",
+  static OpenAPIDocumentation create(OpenAPIText summary,
+                                     OpenAPIText description = OpenAPIText(),
+                                     OpenAPIText operationId = OpenAPIText(),
                                      const std::vector<String> &tags = {}) {
-    return OpenAPIDocumentation(summary, description, operationId, tags);
+    return OpenAPIDocumentation(std::move(summary), std::move(description),
+                                std::move(operationId), tags);
   }
 
   /**
-   * Create a standard success response schema
+   * Standard success response schema. Like the other schema helpers it
+   * returns an OpenAPISchemaRef: builders store the full schema, or with
+   * WEB_PLATFORM_OPENAPI_COMPONENTS a short $ref to a definition written
+   * once under components/schemas. Converts to String for the full schema
+   * JSON in every build, including ones with OpenAPI docs disabled.
    */
-  static String createSuccessResponse(
+  static OpenAPISchemaRef createSuccessResponse(
       const String &description = "Operation completed successfully") {
-    return R"({
-            "type": "object",
-            "properties": {
-                "success": {
-                    "type": "boolean",
-                    "description": "Whether the operation was successful",
-                    "example": true
-                },
-                "message": {
-                    "type": "string",
-                    "description": ")" +
-           description + R"(",
-                    "example": "Operation successful"
-                }
-            },
-            "required": ["success"]
-        })";
+    return component(OpenAPIComponents::Kind::SUCCESS_RESPONSE, description);
   }
 
   /**
    * Create a standard error response schema
    */
-  static String
+  static OpenAPISchemaRef
   createErrorResponse(const String &description = "Details about the error") {
-    return R"({
-            "type": "object",
-            "properties": {
-                "success": {
-                    "type": "boolean",
-                    "description": "Whether the operation was successful",
-                    "example": false
-                },
-                "error": {
-                    "type": "string",
-                    "description": ")" +
-           description + R"(",
-                    "example": "Operation failed"
-                }
-            },
-            "required": ["success", "error"]
-        })";
+    return component(OpenAPIComponents::Kind::ERROR_RESPONSE, description);
   }
 
   /**
    * Create a list/array response schema
    */
-  static String createListResponse(const String &itemDescription) {
-    return R"({
-            "type": "object",
-            "properties": {
-                "items": {
-                    "type": "array",
-                    "items": {},
-                    "description": "List of )" +
-           itemDescription + R"("
-                },
-                "total": {
-                    "type": "integer",
-                    "description": "Total number of items"
-                }
-            },
-            "required": ["items", "total"]
-        })";
+  static OpenAPISchemaRef createListResponse(const String &itemDescription) {
+    return component(OpenAPIComponents::Kind::LIST_RESPONSE,
+                     String("List of ") + itemDescription);
   }
 
   /**
-   * Create an ID parameter schema for path parameters
+   * Create an ID parameter for path parameters (a components/parameters
+   * entry, referenced from withParameters)
    */
-  static String createIdParameter(const String &name,
-                                  const String &description) {
-    return R"({
-            "name": ")" +
-           name + R"(",
-            "in": "path",
-            "required": true,
-            "schema": {"type": "string"},
-            "description": ")" +
-           description + R"("
-        })";
+  static OpenAPISchemaRef createIdParameter(const String &name,
+                                            const String &description) {
+    return component(OpenAPIComponents::Kind::ID_PARAMETER, description,
+                     name);
   }
 
   /**
@@ -132,12 +87,28 @@ public:
    * Create OpenAPI documentation with success response
    */
   static OpenAPIDocumentation
-  createWithSuccessResponse(const String &summary, const String &description,
-                            const String &operationId,
+  createWithSuccessResponse(OpenAPIText summary, OpenAPIText description,
+                            OpenAPIText operationId,
                             const std::vector<String> &tags,
                             const String &responseDescription) {
-    return OpenAPIDocumentation(summary, description, operationId, tags)
-        .withResponseSchema(createSuccessResponse(responseDescription));
+    OpenAPIDocumentation doc(std::move(summary), std::move(description),
+                             std::move(operationId), tags);
+    doc.withResponseSchema(createSuccessResponse(responseDescription));
+    return doc;
+  }
+
+private:
+  // Interned only when components are enabled and docs are compiled in;
+  // otherwise a standalone schema that nothing keeps alive
+  static OpenAPISchemaRef component(OpenAPIComponents::Kind kind,
+                                    const String &description,
+                                    const String &parameter = String()) {
+#if WEB_PLATFORM_OPENAPI_COMPONENTS && (OPENAPI_ENABLED || MAKERAPI_ENABLED)
+    return OpenAPISchemaRef::interned(kind, description, parameter);
+#else
+    return OpenAPISchemaRef(
+        OpenAPIComponents::standalone(kind, description, parameter));
+#endif
   }
 };
 
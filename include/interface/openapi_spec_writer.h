@@ -0,0 +1,72 @@
+#ifndef OPENAPI_SPEC_WRITER_H
+#define OPENAPI_SPEC_WRITER_H
+
+#include <Arduino.h>
+#include <interface/auth_types.h>
+#include <interface/openapi_components.h>
+#include <interface/openapi_types.h>
+#include <interface/utils/json_stream_writer.h>
+#include <interface/web_module_types.h>
+#include <vector>
+
+/**
+ * OpenAPISpecWriter - Streams an OpenAPI 3 document for registered routes
+ *
+ * Writes the spec through a JsonStreamWriter, so it goes to the connection
+ * in buffer-sized chunks instead of being assembled in memory. The JSON
+ * texts stored in each route's OpenAPIDocumentation (schemas, parameters,
+ * responses, examples) are spliced in as they are, with whitespace
+ * outside strings dropped, never parsed into a JsonDocument. Memory use is
+ * therefore the writer's buffer plus the caller's list of operations,
+ * whatever the number of routes or size of their schemas. Stored JSON is
+ * trusted: a malformed schema string yields a malformed spec.
+ *
+ * Per operation:
+ * - summary, description, operationId and tags from the doc
+ * - parameters: the stored text (an object is wrapped in an array), or
+ *   generated string parameters for the path's {name} segments
+ * - requestBody: the stored text when it is a full request body (has a
+ *   top-level "content"), otherwise it is used as the application/json
+ *   schema, with the request example
+ * - responses: the stored responses object, or a 200 response built from
+ *   the response schema and example
+ * - security: bearer token, session cookie and/or CSRF header alternatives
+ *   for routes that do not also allow AuthType::NONE
+ *
+ * The shared schemas of OpenAPIComponents, which routes reference through
+ * $ref, are written once under components.
+ */
+class OpenAPISpecWriter {
+public:
+  // Conventional location of the generated spec
+  static constexpr const char *SPEC_PATH = "/openapi.json";
+
+  struct Info {
+    const char *title = "Web Platform API";
+    const char *version = "1.0.0";
+    const char *description = nullptr;
+    const char *serverUrl = nullptr; // Omitted from the spec when null
+  };
+
+  // One route; the pointers must stay valid while the spec is written
+  struct Operation {
+    const char *path; // Full path, e.g. "/api/items/{id}"
+    WebModule::Method method;
+    AuthRequirements auth;
+    const OpenAPIDocumentation *docs; // nullptr for undocumented routes
+  };
+
+  // Write the complete document. `operations` is sorted in place by path
+  // and method so each path object is written once. Returns writer.ok().
+  static bool write(JsonStreamWriter &writer, const Info &info,
+                    std::vector<Operation> &operations);
+
+  // The operation object of a single route (the value of "get" etc.)
+  static void writeOperation(JsonStreamWriter &writer,
+                             const Operation &operation);
+
+  // Lower-case OpenAPI method key, e.g. "get"
+  static const char *methodName(WebModule::Method method);
+};
+
+#endif // OPENAPI_SPEC_WRITER_H
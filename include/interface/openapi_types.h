@@ -3,7 +3,11 @@
 
 #include <Arduino.h>
 #include <interface/string_compat.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 #ifndef WEB_PLATFORM_OPENAPI
@@ -18,111 +22,296 @@
 #define OPENAPI_ENABLED WEB_PLATFORM_OPENAPI
 #define MAKERAPI_ENABLED WEB_PLATFORM_MAKERAPI
 
-// Template-based OpenAPI documentation - full implementation when enabled
+// Text fields of an OpenAPIDoc, in presence-bitmask order
+enum class OpenAPIField : uint8_t {
+  SUMMARY,          // Short summary of the operation
+  OPERATION_ID,     // Unique identifier for the operation
+  DESCRIPTION,      // Detailed description
+  TAGS,             // Comma-separated tags for organizing operations
+  REQUEST_EXAMPLE,  // JSON string containing example request body
+  RESPONSE_EXAMPLE, // JSON string containing example response body
+  REQUEST_SCHEMA,   // JSON string containing request schema definition
+  RESPONSE_SCHEMA,  // JSON string containing response schema definition
+  PARAMETERS,       // JSON string containing parameter definitions
+  RESPONSES,        // JSON string containing response definitions
+  COUNT
+};
+
+/**
+ * OpenAPIText - Documentation text that is either borrowed or owned
+ *
+ * A const char * is borrowed, not copied: it must outlive the route, which
+ * string literals always do (on ESP32 they are read straight from flash). A
+ * String is copied to the heap once and owned by the OpenAPIDoc it is given
+ * to. Builder methods take OpenAPIText, so both kinds of argument work.
+ */
+class OpenAPIText {
+public:
+  OpenAPIText() = default;
+  OpenAPIText(const char *text) : ptr(text) {}
+  OpenAPIText(const String &text)
+      : ptr(text.length() ? copy(text.c_str(), text.length()) : nullptr),
+        owned(ptr != nullptr) {}
+
+  OpenAPIText(OpenAPIText &&other) noexcept
+      : ptr(other.ptr), owned(other.owned) {
+    other.ptr = nullptr;
+    other.owned = false;
+  }
+  OpenAPIText &operator=(OpenAPIText &&other) noexcept {
+    if (this != &other) {
+      reset();
+      ptr = other.ptr;
+      owned = other.owned;
+      other.ptr = nullptr;
+      other.owned = false;
+    }
+    return *this;
+  }
+  OpenAPIText(const OpenAPIText &) = delete;
+  OpenAPIText &operator=(const OpenAPIText &) = delete;
+  ~OpenAPIText() { reset(); }
+
+  const char *c_str() const { return ptr ? ptr : ""; }
+  bool empty() const { return !ptr || !*ptr; }
+  bool isOwned() const { return owned; }
+
+  // Give up the text; the caller frees it with release() when isOwned()
+  const char *take() {
+    const char *text = ptr;
+    ptr = nullptr;
+    owned = false;
+    return text;
+  }
+
+  static char *copy(const char *text, size_t length) {
+    char *result = static_cast<char *>(malloc(length + 1));
+    if (result) {
+      memcpy(result, text, length);
+      result[length] = '\0';
+    }
+    return result;
+  }
+  static void release(const char *text) {
+    free(const_cast<char *>(text));
+  }
+
+private:
+  void reset() {
+    if (owned) {
+      release(ptr);
+    }
+    ptr = nullptr;
+    owned = false;
+  }
+
+  const char *ptr = nullptr;
+  bool owned = false;
+};
+
+/**
+ * OpenAPIDoc - Per-route OpenAPI documentation, full implementation
+ *
+ * Stored compactly: one pointer per OpenAPIField plus two bitmasks, one for
+ * the fields that are set and one for those holding an owned heap copy.
+ * Documentation written with string literals costs no heap at all; a
+ * runtime String is copied once. Copying a doc duplicates only the owned
+ * texts.
+ */
 template <bool Enabled = (OPENAPI_ENABLED || MAKERAPI_ENABLED)>
 struct OpenAPIDoc {
 private:
-  String summary;           // Short summary of the operation
-  String operationId;       // Unique identifier for the operation
-  String description;       // Detailed description
-  std::vector<String> tags; // Tags for organizing operations
-  String requestExample;    // JSON string containing example request body
-  String responseExample;   // JSON string containing example response body
-  String requestSchema;     // JSON string containing request schema definition
-  String responseSchema;    // JSON string containing response schema definition
-  String parameters;        // JSON string containing parameter definitions
-  String responsesJson;     // JSON string containing response definitions
+  static constexpr size_t FIELD_COUNT =
+      static_cast<size_t>(OpenAPIField::COUNT);
+
+  const char *fields[FIELD_COUNT] = {};
+  uint16_t present = 0; // Bit per OpenAPIField with non-empty text
+  uint16_t owned = 0;   // Bit per OpenAPIField whose text is a heap copy
+
+  static uint16_t bit(OpenAPIField field) {
+    return static_cast<uint16_t>(1u << static_cast<uint8_t>(field));
+  }
+
+  void set(OpenAPIField field, OpenAPIText text) {
+    size_t index = static_cast<size_t>(field);
+    if (owned & bit(field)) {
+      OpenAPIText::release(fields[index]);
+    }
+    present &= ~bit(field);
+    owned &= ~bit(field);
+    fields[index] = nullptr;
+    if (text.empty()) {
+      return;
+    }
+    bool isOwned = text.isOwned();
+    fields[index] = text.take();
+    present |= bit(field);
+    if (isOwned) {
+      owned |= bit(field);
+    }
+  }
+
+  void clear() {
+    for (size_t i = 0; i < FIELD_COUNT; i++) {
+      if (owned & (1u << i)) {
+        OpenAPIText::release(fields[i]);
+      }
+      fields[i] = nullptr;
+    }
+    present = 0;
+    owned = 0;
+  }
+
+  void copyFrom(const OpenAPIDoc &other) {
+    for (size_t i = 0; i < FIELD_COUNT; i++) {
+      const char *text = other.fields[i];
+      fields[i] = (other.owned & (1u << i))
+                      ? OpenAPIText::copy(text, strlen(text))
+                      : text;
+    }
+    present = other.present;
+    owned = other.owned;
+  }
+
+  void moveFrom(OpenAPIDoc &other) {
+    for (size_t i = 0; i < FIELD_COUNT; i++) {
+      fields[i] = other.fields[i];
+      other.fields[i] = nullptr;
+    }
+    present = other.present;
+    owned = other.owned;
+    other.present = 0;
+    other.owned = 0;
+  }
+
+  static String joinTags(const std::vector<String> &tags) {
+    String result = "";
+    for (size_t i = 0; i < tags.size(); i++) {
+      if (i > 0)
+        result += ",";
+      result += tags[i];
+    }
+    return result;
+  }
 
 public:
   // Default constructor
   OpenAPIDoc() = default;
+  ~OpenAPIDoc() { clear(); }
 
   // Copy/move constructors and assignment operators
-  OpenAPIDoc(const OpenAPIDoc &) = default;
-  OpenAPIDoc &operator=(const OpenAPIDoc &) = default;
-  OpenAPIDoc(OpenAPIDoc &&) noexcept = default;
-  OpenAPIDoc &operator=(OpenAPIDoc &&) noexcept = default;
+  OpenAPIDoc(const OpenAPIDoc &other) { copyFrom(other); }
+  OpenAPIDoc &operator=(const OpenAPIDoc &other) {
+    if (this != &other) {
+      clear();
+      copyFrom(other);
+    }
+    return *this;
+  }
+  OpenAPIDoc(OpenAPIDoc &&other) noexcept { moveFrom(other); }
+  OpenAPIDoc &operator=(OpenAPIDoc &&other) noexcept {
+    if (this != &other) {
+      clear();
+      moveFrom(other);
+    }
+    return *this;
+  }
 
   // Convenience constructor with common fields - tags are now optional
-  OpenAPIDoc(const String &sum, const String &desc = "",
-             const String &opId = "")
-      : summary(sum), operationId(opId), description(desc), tags({}) {}
+  OpenAPIDoc(OpenAPIText sum, OpenAPIText desc = OpenAPIText(),
+             OpenAPIText opId = OpenAPIText()) {
+    set(OpenAPIField::SUMMARY, std::move(sum));
+    set(OpenAPIField::DESCRIPTION, std::move(desc));
+    set(OpenAPIField::OPERATION_ID, std::move(opId));
+  }
 
   // Constructor with explicit tags (for when you want to override defaults)
-  OpenAPIDoc(const String &sum, const String &desc, const String &opId,
+  OpenAPIDoc(OpenAPIText sum, OpenAPIText desc, OpenAPIText opId,
              const std::vector<String> &t)
-      : summary(sum), operationId(opId), description(desc), tags(t) {}
+      : OpenAPIDoc(std::move(sum), std::move(desc), std::move(opId)) {
+    if (!t.empty()) {
+      set(OpenAPIField::TAGS, joinTags(t));
+    }
+  }
 
   // Builder pattern methods - each returns a reference to the current object
   // for chaining
-  OpenAPIDoc &withRequestExample(const String &example) {
-    this->requestExample = example;
+  OpenAPIDoc &withRequestExample(OpenAPIText example) {
+    set(OpenAPIField::REQUEST_EXAMPLE, std::move(example));
     return *this;
   }
 
-  OpenAPIDoc &withResponseExample(const String &example) {
-    this->responseExample = example;
+  OpenAPIDoc &withResponseExample(OpenAPIText example) {
+    set(OpenAPIField::RESPONSE_EXAMPLE, std::move(example));
     return *this;
   }
 
   // OpenAPI 3.0 compliant request bodies
-  OpenAPIDoc &withRequestBody(const String &requestBody) {
-    this->requestSchema = requestBody;
+  OpenAPIDoc &withRequestBody(OpenAPIText requestBody) {
+    set(OpenAPIField::REQUEST_SCHEMA, std::move(requestBody));
     return *this;
   }
 
-  OpenAPIDoc &withResponseSchema(const String &schema) {
-    this->responseSchema = schema;
+  OpenAPIDoc &withResponseSchema(OpenAPIText schema) {
+    set(OpenAPIField::RESPONSE_SCHEMA, std::move(schema));
     return *this;
   }
 
-  OpenAPIDoc &withParameters(const String &params) {
-    this->parameters = params;
+  OpenAPIDoc &withParameters(OpenAPIText params) {
+    set(OpenAPIField::PARAMETERS, std::move(params));
     return *this;
   }
 
-  OpenAPIDoc &withResponses(const String &responses) {
-    this->responsesJson = responses;
+  OpenAPIDoc &withResponses(OpenAPIText responses) {
+    set(OpenAPIField::RESPONSES, std::move(responses));
     return *this;
   }
 
+  // Raw field access without a String copy; "" when the field is not set
+  const char *text(OpenAPIField field) const {
+    const char *value = fields[static_cast<size_t>(field)];
+    return value ? value : "";
+  }
+  bool has(OpenAPIField field) const { return (present & bit(field)) != 0; }
+
   // Getters
-  const String &getSummary() const { return summary; }
-  const String &getOperationId() const { return operationId; }
-  const String &getDescription() const { return description; }
-  const std::vector<String> &getTags() const { return tags; }
-  const String &getRequestExample() const { return requestExample; }
-  const String &getResponseExample() const { return responseExample; }
-  const String &getRequestSchema() const { return requestSchema; }
-  const String &getResponseSchema() const { return responseSchema; }
-  const String &getParameters() const { return parameters; }
-  const String &getResponsesJson() const { return responsesJson; }
+  String getSummary() const { return text(OpenAPIField::SUMMARY); }
+  String getOperationId() const { return text(OpenAPIField::OPERATION_ID); }
+  String getDescription() const { return text(OpenAPIField::DESCRIPTION); }
+  std::vector<String> getTags() const {
+    std::vector<String> tags;
+    const char *start = text(OpenAPIField::TAGS);
+    while (*start) {
+      const char *end = strchr(start, ',');
+      size_t length = end ? static_cast<size_t>(end - start) : strlen(start);
+      String tag;
+      tag.reserve(length);
+      for (size_t i = 0; i < length; i++) {
+        tag += start[i];
+      }
+      tags.push_back(tag);
+      start += end ? length + 1 : length;
+    }
+    return tags;
+  }
+  String getRequestExample() const {
+    return text(OpenAPIField::REQUEST_EXAMPLE);
+  }
+  String getResponseExample() const {
+    return text(OpenAPIField::RESPONSE_EXAMPLE);
+  }
+  String getRequestSchema() const { return text(OpenAPIField::REQUEST_SCHEMA); }
+  String getResponseSchema() const {
+    return text(OpenAPIField::RESPONSE_SCHEMA);
+  }
+  String getParameters() const { return text(OpenAPIField::PARAMETERS); }
+  String getResponsesJson() const { return text(OpenAPIField::RESPONSES); }
 
   // Check if any documentation is provided
-  bool hasDocumentation() const {
-    return !StringUtils::isStringEmpty(summary) ||
-           !StringUtils::isStringEmpty(description) ||
-           !StringUtils::isStringEmpty(operationId) || !tags.empty() ||
-           !StringUtils::isStringEmpty(requestExample) ||
-           !StringUtils::isStringEmpty(responseExample) ||
-           !StringUtils::isStringEmpty(requestSchema) ||
-           !StringUtils::isStringEmpty(responseSchema) ||
-           !StringUtils::isStringEmpty(parameters) ||
-           !StringUtils::isStringEmpty(responsesJson);
-  }
+  bool hasDocumentation() const { return present != 0; }
 
   // Helper to get tags as comma-separated string
-  String getTagsString() const {
-    if (tags.empty())
-      return "";
-    String result = "";
-    for (size_t i = 0; i < tags.size(); i++) {
-      if (i > 0)
-        result += ",";
-      result += tags[i];
-    }
-    return result;
-  }
+  String getTagsString() const { return text(OpenAPIField::TAGS); }
 };
 
 // Template specialization - empty implementation when disabled
@@ -140,13 +329,14 @@ template <> struct OpenAPIDoc<false> {
             typename std::enable_if<!(sizeof...(Args) == 1), int>::type = 0>
   OpenAPIDoc(Args &&...args) {}
 
-  // Builder pattern methods that do nothing but return self for chaining
-  OpenAPIDoc &withRequestExample(const String &) { return *this; }
-  OpenAPIDoc &withResponseExample(const String &) { return *this; }
-  OpenAPIDoc &withRequestBody(const String &) { return *this; }
-  OpenAPIDoc &withResponseSchema(const String &) { return *this; }
-  OpenAPIDoc &withParameters(const String &) { return *this; }
-  OpenAPIDoc &withResponses(const String &) { return *this; }
+  // Builder pattern methods that do nothing but return self for chaining;
+  // templates so literal arguments are not turned into Strings
+  template <typename T> OpenAPIDoc &withRequestExample(T &&) { return *this; }
+  template <typename T> OpenAPIDoc &withResponseExample(T &&) { return *this; }
+  template <typename T> OpenAPIDoc &withRequestBody(T &&) { return *this; }
+  template <typename T> OpenAPIDoc &withResponseSchema(T &&) { return *this; }
+  template <typename T> OpenAPIDoc &withParameters(T &&) { return *this; }
+  template <typename T> OpenAPIDoc &withResponses(T &&) { return *this; }
 
   // Getters that return empty values
   String getSummary() const { return ""; }
@@ -159,6 +349,8 @@ template <> struct OpenAPIDoc<false> {
   String getResponseSchema() const { return ""; }
   String getParameters() const { return ""; }
   String getResponsesJson() const { return ""; }
+  const char *text(OpenAPIField) const { return ""; }
+  bool has(OpenAPIField) const { return false; }
 
   // All methods return empty/default values and inline to nothing
   bool hasDocumentation() const { return false; }
@@ -176,8 +368,7 @@ using OpenAPIDocumentation = OpenAPIDoc<(OPENAPI_ENABLED || MAKERAPI_ENABLED)>;
 #define COMPLEX_API_DOC(summary, desc, reqSchema, respExample)                 \
   []() {                                                                       \
     auto doc = OpenAPIDocumentation(summary, desc);                            \
-    doc.requestSchema = reqSchema;                                             \
-    doc.responseExample = respExample;                                         \
+    doc.withRequestBody(reqSchema).withResponseExample(respExample);           \
     return doc;                                                                \
   }()
 #else
@@ -0,0 +1,35 @@
+#ifndef PROGMEM_ASSET_H
+#define PROGMEM_ASSET_H
+
+#include <Arduino.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef PROGMEM
+#define PROGMEM
+#endif
+
+/**
+ * ProgmemAsset - Static file in flash, stored pre-compressed
+ *
+ * Holds the identity bytes plus optional gzip and brotli encodings of the
+ * same file. WebResponse::setProgmemContent(asset) picks the encoding the
+ * client accepts, so browsers download (and the device reads from flash)
+ * the compressed copy. Normally generated from an asset directory with
+ * tools/generate_progmem_assets.py rather than written by hand.
+ */
+struct ProgmemAsset {
+  const char *path;     // URL path, e.g. "/assets/app.js"
+  const char *mimeType; // e.g. "application/javascript"
+  const uint8_t *identity;
+  size_t identityLength;
+  const uint8_t *gzip; // nullptr when not available
+  size_t gzipLength;
+  const uint8_t *brotli; // nullptr when not available
+  size_t brotliLength;
+  // Strong ETag of the identity bytes in header form ("\"1f2e...\""), or
+  // nullptr. Compressed copies are tagged with a -gzip / -br suffix.
+  const char *etag;
+};
+
+#endif // PROGMEM_ASSET_H
@@ -0,0 +1,207 @@
+#ifndef ROUTE_TYPES_H
+#define ROUTE_TYPES_H
+
+#include <Arduino.h>
+#include <interface/auth_types.h>
+#include <interface/debug_macros.h>
+#include <interface/openapi_types.h>
+#include <interface/unified_types.h>
+#include <interface/utils/gzip_stream.h>
+#include <interface/utils/request_validator.h>
+#include <interface/utils/response_cache.h>
+#include <interface/web_module_types.h>
+
+// Route definitions live apart from IWebModule so RouteVariant can store
+// them inline (it needs the complete types, not just declarations)
+
+// Web route structure - supports both legacy and unified handlers
+struct WebRoute {
+  String path;                     // Route path (e.g., "/status", "/config")
+  WebModule::Method method;        // HTTP method
+  WebModule::RouteHandler handler; // Legacy function pointer (deprecated)
+  WebModule::UnifiedRouteHandler unifiedHandler; // New unified handler
+  String contentType; // Optional: "text/html", "application/json"
+  String description; // Optional: Human-readable description
+  AuthRequirements authRequirements; // Authentication requirements for route
+  ResponseCachePolicy cachePolicy;   // Optional: GET response caching
+  ResponseCompressionPolicy compressionPolicy; // Optional: on-the-fly gzip
+
+private:
+  // Helper function to check for API path usage warning
+  static void checkApiPathWarning(const String &p) {
+    if (p.startsWith("/api/") || p.startsWith("api/")) {
+      WARN_PRINTLN(
+          "WARNING: WebRoute path '" + p +
+          "' starts with '/api/' or 'api/'. Consider using ApiRoute instead "
+          "for better API documentation and path normalization.");
+    }
+  }
+
+public:
+  // Constructors for unified handlers
+  WebRoute(const String &p, WebModule::Method m,
+           WebModule::UnifiedRouteHandler h)
+      : path(p), method(m), unifiedHandler(h), contentType("text/html"),
+        authRequirements({AuthType::NONE}) {
+    checkApiPathWarning(p);
+  }
+
+  WebRoute(const String &p, WebModule::Method m,
+           WebModule::UnifiedRouteHandler h, const String &ct)
+      : path(p), method(m), unifiedHandler(h), contentType(ct),
+        authRequirements({AuthType::NONE}) {
+    checkApiPathWarning(p);
+  }
+
+  WebRoute(const String &p, WebModule::Method m,
+           WebModule::UnifiedRouteHandler h, const String &ct,
+           const String &desc)
+      : path(p), method(m), unifiedHandler(h), contentType(ct),
+        description(desc), authRequirements({AuthType::NONE}) {
+    checkApiPathWarning(p);
+  }
+
+  // Constructors with auth requirements
+  WebRoute(const String &p, WebModule::Method m,
+           WebModule::UnifiedRouteHandler h, const AuthRequirements &auth)
+      : path(p), method(m), unifiedHandler(h), contentType("text/html"),
+        authRequirements(auth) {
+    checkApiPathWarning(p);
+  }
+
+  WebRoute(const String &p, WebModule::Method m,
+           WebModule::UnifiedRouteHandler h, const AuthRequirements &auth,
+           const String &ct)
+      : path(p), method(m), unifiedHandler(h), contentType(ct),
+        authRequirements(auth) {
+    checkApiPathWarning(p);
+  }
+
+  WebRoute(const String &p, WebModule::Method m,
+           WebModule::UnifiedRouteHandler h, const AuthRequirements &auth,
+           const String &ct, const String &desc)
+      : path(p), method(m), unifiedHandler(h), contentType(ct),
+        description(desc), authRequirements(auth) {
+    checkApiPathWarning(p);
+  }
+
+  // Serve repeated GETs from the platform's response cache for ttlMs after
+  // a 200 response; varyParams names the query params (comma-separated)
+  // that select separate copies. See ResponseCache.
+  WebRoute &cached(uint32_t ttlMs, const char *varyParams = nullptr) {
+    cachePolicy.ttlMs = ttlMs;
+    cachePolicy.varyParams = varyParams;
+    return *this;
+  }
+
+  // Gzip this route's responses of at least minBytes (and all streamed
+  // JSON) for clients that accept it, with a 2^windowBits byte window.
+  // Overrides the platform-wide policy. See ResponseCompressionPolicy.
+  WebRoute &compressed(uint8_t windowBits = GzipStream::DEFAULT_WINDOW_BITS,
+                       size_t minBytes = 1024) {
+    compressionPolicy.windowBits = windowBits;
+    compressionPolicy.minBytes = minBytes;
+    return *this;
+  }
+};
+
+struct ApiRoute {
+  WebRoute webRoute; // Route details
+
+  OpenAPIDocumentation docs; // OpenAPI documentation
+  RequestValidationPolicy validation; // Optional: reject invalid bodies
+
+private:
+  // Helper function to normalize API paths by removing /api or api prefix
+  static String normalizeApiPath(const String &path) {
+    // If starts with /api/, remove the /api part
+    if (path.startsWith("/api/")) {
+      return path.substring(4); // Remove "/api" keeping the "/"
+    }
+    // If just "api", return "/"
+    if (path.equals("api")) {
+      return "/";
+    }
+    // Otherwise return as-is, ensuring it has a leading slash
+    if (path.startsWith("/")) {
+      return path;
+    }
+    return "/" + path;
+  }
+
+public:
+  // Constructors for unified handlers
+  ApiRoute(const String &p, WebModule::Method m,
+           WebModule::UnifiedRouteHandler h)
+      : webRoute(normalizeApiPath(p), m, h) {}
+
+  ApiRoute(const String &p, WebModule::Method m,
+           WebModule::UnifiedRouteHandler h, const String &ct)
+      : webRoute(normalizeApiPath(p), m, h, ct) {}
+
+  ApiRoute(const String &p, WebModule::Method m,
+           WebModule::UnifiedRouteHandler h, const String &ct,
+           const String &desc)
+      : webRoute(normalizeApiPath(p), m, h, ct, desc) {}
+
+  // Constructors with auth requirements
+  ApiRoute(const String &p, WebModule::Method m,
+           WebModule::UnifiedRouteHandler h, const AuthRequirements &auth)
+      : webRoute(normalizeApiPath(p), m, h, auth) {}
+
+  ApiRoute(const String &p, WebModule::Method m,
+           WebModule::UnifiedRouteHandler h, const AuthRequirements &auth,
+           const String &ct)
+      : webRoute(normalizeApiPath(p), m, h, auth, ct) {}
+
+  ApiRoute(const String &p, WebModule::Method m,
+           WebModule::UnifiedRouteHandler h, const AuthRequirements &auth,
+           const String &ct, const String &desc)
+      : webRoute(normalizeApiPath(p), m, h, auth, ct, desc) {}
+
+  // Constructors with OpenAPI documentation (taken by value so a temporary
+  // doc's owned text is moved, not copied)
+  ApiRoute(const String &p, WebModule::Method m,
+           WebModule::UnifiedRouteHandler h,
+           OpenAPIDocumentation documentation)
+      : webRoute(normalizeApiPath(p), m, h), docs(std::move(documentation)) {}
+
+  ApiRoute(const String &p, WebModule::Method m,
+           WebModule::UnifiedRouteHandler h, const AuthRequirements &auth,
+           OpenAPIDocumentation documentation)
+      : webRoute(normalizeApiPath(p), m, h, auth),
+        docs(std::move(documentation)) {}
+
+  ApiRoute(const String &p, WebModule::Method m,
+           WebModule::UnifiedRouteHandler h, const AuthRequirements &auth,
+           const String &ct, OpenAPIDocumentation documentation)
+      : webRoute(normalizeApiPath(p), m, h, auth, ct),
+        docs(std::move(documentation)) {}
+
+  // See WebRoute::cached()
+  ApiRoute &cached(uint32_t ttlMs, const char *varyParams = nullptr) {
+    webRoute.cached(ttlMs, varyParams);
+    return *this;
+  }
+
+  // See WebRoute::compressed()
+  ApiRoute &compressed(uint8_t windowBits = GzipStream::DEFAULT_WINDOW_BITS,
+                       size_t minBytes = 1024) {
+    webRoute.compressed(windowBits, minBytes);
+    return *this;
+  }
+
+  // Check the JSON body against `schema`, or the documented request schema
+  // when null, before the handler runs; invalid requests get a 400 and the
+  // handler is not called. The schema is compiled once when the route is
+  // registered (a schema that fails to compile fails the registration).
+  // With OpenAPI docs compiled out there is no documented schema, so pass
+  // it explicitly. See RequestValidator.
+  ApiRoute &validated(const char *schema = nullptr) {
+    validation.enabled = true;
+    validation.schema = schema;
+    return *this;
+  }
+};
+
+#endif // ROUTE_TYPES_H
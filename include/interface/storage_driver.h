@@ -0,0 +1,73 @@
+#ifndef STORAGE_DRIVER_H
+#define STORAGE_DRIVER_H
+
+#include <Arduino.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * IStorageDriver - Read access to stored objects for response streaming
+ *
+ * WebResponse::setStorageStreamContent(collection, key, mimeType,
+ * driverName) names an object; when the response is sent, the platform
+ * looks the driver up in StorageDriverRegistry and streams the object
+ * through it. Objects are opened as handles so several responses can be in
+ * flight on one driver.
+ *
+ * Byte ranges seek() to the start instead of reading past the prefix.
+ * Drivers whose objects sit in addressable memory (memory-mapped files,
+ * flash partitions) can also expose contiguousView(), which lets the
+ * platform hand the bytes to the socket without copying them.
+ *
+ * Drivers that can version objects cheaply (size and modification time,
+ * a write counter) expose etag(); platforms then send it as the ETag and
+ * answer a matching If-None-Match with 304 before reading the object.
+ */
+class IStorageDriver {
+public:
+  typedef int Handle;
+  static const Handle INVALID_HANDLE = -1;
+
+  virtual ~IStorageDriver() = default;
+
+  // Open collection/key for reading; INVALID_HANDLE when it does not exist
+  virtual Handle open(const String &collection, const String &key) = 0;
+  // Object size in bytes
+  virtual size_t size(Handle handle) const = 0;
+  // Move the read position; false when `offset` is past the end
+  virtual bool seek(Handle handle, size_t offset) = 0;
+  // Read up to `length` bytes at the read position; 0 at the end
+  virtual size_t read(Handle handle, uint8_t *buffer, size_t length) = 0;
+  virtual void close(Handle handle) = 0;
+
+  // The whole object as one readable span, valid until close(); nullptr
+  // when the backend cannot provide one
+  virtual const uint8_t *contiguousView(Handle handle) const {
+    return nullptr;
+  }
+
+  // Strong ETag of the object in header form ("\"...\""), which must change
+  // whenever its bytes do; "" when the backend cannot tell
+  virtual String etag(Handle handle) const { return String(); }
+};
+
+/**
+ * StorageDriverRegistry - Storage drivers by name
+ *
+ * The first driver registered becomes the default, used when a response
+ * names no driver (""). Drivers are not owned and must outlive their
+ * registration.
+ */
+class StorageDriverRegistry {
+public:
+  // Replaces a driver already registered under `name`
+  static void registerDriver(const String &name, IStorageDriver *driver);
+  static void unregisterDriver(const String &name);
+  static void setDefaultDriver(const String &name);
+
+  // Driver for `name` ("" for the default), nullptr when unknown
+  static IStorageDriver *getDriver(const String &name);
+  static size_t count();
+};
+
+#endif // STORAGE_DRIVER_H
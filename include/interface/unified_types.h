@@ -3,6 +3,7 @@
 
 #include <Arduino.h>
 #include <functional>
+#include <interface/utils/inplace_function.h>
 #include <interface/web_request.h>
 #include <interface/web_response.h>
 
@@ -15,8 +16,9 @@ typedef std::function<String(const String &requestBody,
                              const std::map<String, String> &params)>
     RouteHandler;
 
-// New unified route handler function signature
-typedef std::function<void(WebRequest &, WebResponse &)> UnifiedRouteHandler;
+// New unified route handler function signature. Stored inline (no heap) and
+// accepts lambdas, function pointers, std::function or (fn, context) pairs.
+typedef InplaceFunction<void(WebRequest &, WebResponse &)> UnifiedRouteHandler;
 } // namespace WebModule
 
 #endif // UNIFIED_TYPES_H
\ No newline at end of file
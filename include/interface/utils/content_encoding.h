@@ -0,0 +1,38 @@
+#ifndef CONTENT_ENCODING_H
+#define CONTENT_ENCODING_H
+
+#include <interface/utils/string_view.h>
+#include <stdint.h>
+
+// Content codings a response body can be stored in (smallest first)
+enum class ContentEncoding : uint8_t { BROTLI, GZIP, IDENTITY };
+
+/**
+ * Accept-Encoding negotiation (RFC 9110 section 12.5.3)
+ *
+ * Quality values are handled in thousandths; "*" covers codings not listed
+ * explicitly, and identity stays acceptable unless refused with q=0. When
+ * several available codings share the best quality the smaller one wins
+ * (br, then gzip, then identity).
+ */
+namespace ContentEncodings {
+
+// Token used in Content-Encoding headers ("br", "gzip", "identity")
+const char *name(ContentEncoding encoding);
+
+// Quality 0..1000 from the parameters of a list item ("q=0.8" -> 800);
+// absent or malformed values count as 1000. Shared with JsonFormats for
+// Accept.
+uint16_t qualityValue(StringView parameters);
+
+// Quality 0..1000 that `acceptEncoding` gives `coding`
+uint16_t quality(StringView acceptEncoding, StringView coding);
+
+// Best available encoding for the request; IDENTITY when nothing else is
+// acceptable (even if the client refused identity too)
+ContentEncoding negotiate(StringView acceptEncoding, bool gzipAvailable,
+                          bool brotliAvailable);
+
+} // namespace ContentEncodings
+
+#endif // CONTENT_ENCODING_H
@@ -0,0 +1,45 @@
+#ifndef ETAG_H
+#define ETAG_H
+
+#include <Arduino.h>
+#include <interface/utils/string_view.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Entity tags (RFC 9110 section 8.8.3)
+ *
+ * Tags are handled in their quoted header form: "\"abc\"" (strong) or
+ * "W/\"abc\"" (weak). Static content gets strong tags computed once, at
+ * build time (tools/generate_progmem_assets.py) or when content is
+ * registered; streamed JSON gets weak tags from ETag::Hasher.
+ */
+namespace ETag {
+
+// Incremental 64-bit FNV-1a over a body, fed chunk by chunk
+class Hasher {
+public:
+  void update(const char *data, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+      state = (state ^ static_cast<uint8_t>(data[i])) * 0x100000001b3ULL;
+    }
+  }
+  uint64_t digest() const { return state; }
+
+private:
+  uint64_t state = 0xcbf29ce484222325ULL;
+};
+
+// "\"<16 hex digits>\"", or "W/\"...\"" when weak
+String format(uint64_t hash, bool weak = false);
+
+// Strong tag for a complete body
+String compute(const uint8_t *data, size_t length);
+
+// If-None-Match check: weak comparison against each listed tag, "*"
+// matches anything
+bool matches(StringView ifNoneMatch, StringView etag);
+
+} // namespace ETag
+
+#endif // ETAG_H
@@ -0,0 +1,127 @@
+#ifndef GZIP_STREAM_H
+#define GZIP_STREAM_H
+
+#include <interface/utils/json_stream_writer.h>
+#include <interface/utils/string_view.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Compressed bytes buffered before a chunk is handed to the sink
+#ifndef GZIP_STREAM_OUTPUT_SIZE
+#define GZIP_STREAM_OUTPUT_SIZE 512
+#endif
+
+/**
+ * GzipStream - Streaming gzip encoder with a bounded window
+ *
+ * Compresses response bodies on the fly: write() text as it is produced
+ * and compressed chunks reach the sink, then finish() adds the trailer.
+ * The encoder is LZ77 over a 2^windowBits window with hash chains and
+ * fixed Huffman codes, emitted as a single deflate block, so nothing is
+ * buffered per block and heap use is fixed by the window:
+ * memoryFor(10) is about 5 KB, memoryFor(14) about 72 KB.
+ *
+ * maxChain bounds the candidates compared per position; lower is faster,
+ * higher finds longer matches. Output is standard gzip (RFC 1952).
+ */
+class GzipStream {
+public:
+  typedef JsonStreamWriter::ChunkSink ChunkSink;
+
+  static const uint8_t MIN_WINDOW_BITS = 9;
+  static const uint8_t MAX_WINDOW_BITS = 14;
+  static const uint8_t DEFAULT_WINDOW_BITS = 10;
+  static const uint8_t DEFAULT_MAX_CHAIN = 8;
+
+  // windowBits is clamped to [MIN_WINDOW_BITS, MAX_WINDOW_BITS]
+  explicit GzipStream(const ChunkSink &sink,
+                      uint8_t windowBits = DEFAULT_WINDOW_BITS,
+                      uint8_t maxChain = DEFAULT_MAX_CHAIN);
+  ~GzipStream();
+
+  GzipStream(const GzipStream &) = delete;
+  GzipStream &operator=(const GzipStream &) = delete;
+
+  // Returns false once the sink has failed or after finish()
+  bool write(const char *data, size_t length);
+  bool write(StringView text) { return write(text.data(), text.length()); }
+  // Compress what is buffered and write the gzip trailer
+  bool finish();
+
+  bool ok() const { return !failed; }
+  size_t bytesIn() const { return inputSize; }
+  size_t bytesOut() const { return outputSize; }
+
+  // Heap bytes a stream with this window allocates
+  static size_t memoryFor(uint8_t windowBits);
+
+private:
+  static uint8_t clampWindowBits(uint8_t windowBits);
+  static uint8_t hashBitsFor(uint8_t windowBits);
+
+  void compress(bool flush);
+  size_t longestMatch(size_t position, uint16_t candidate, size_t limit,
+                      size_t &distance) const;
+  void insert(size_t position);
+  uint32_t hashAt(size_t position) const;
+  void slide();
+
+  void writeLiteral(uint8_t byte);
+  void writeLengthSymbol(uint16_t symbol);
+  void writeMatch(size_t length, size_t distance);
+  void putBits(uint32_t value, uint8_t count);
+  void putByte(uint8_t byte);
+  void flushOutput();
+
+  ChunkSink sink;
+  uint8_t windowBits;
+  uint8_t hashBits;
+  uint8_t maxChain;
+  size_t windowSize;
+  uint8_t *window;    // 2 * windowSize bytes of history and lookahead
+  uint16_t *head;     // Newest position per hash, NIL when empty
+  uint16_t *previous; // Older position with the same hash, per position
+  size_t fill;        // Bytes in window
+  size_t position;    // Next byte to encode
+  uint32_t bitBuffer;
+  uint8_t bitCount;
+  uint32_t crc;
+  size_t inputSize;
+  size_t outputSize;
+  bool failed;
+  bool finished;
+  size_t outputLength;
+  char output[GZIP_STREAM_OUTPUT_SIZE];
+};
+
+/**
+ * ResponseCompressionPolicy - When a platform gzips a response on the fly
+ *
+ * Set per route with WebRoute::compressed(), or platform-wide with
+ * IWebPlatform::setResponseCompression() (which can filter by MIME type).
+ * Only bodies the handler produced are compressed: PROGMEM and storage
+ * content, responses that already carry Content-Encoding, and clients
+ * that do not accept gzip are sent as-is. Compressed responses use
+ * chunked transfer since their length is not known up front.
+ */
+struct ResponseCompressionPolicy {
+  static const size_t UNKNOWN_LENGTH = static_cast<size_t>(-1);
+
+  uint8_t windowBits = 0; // 0 disables; see GzipStream
+  uint8_t maxChain = GzipStream::DEFAULT_MAX_CHAIN;
+  // Smaller bodies are not worth the CPU; streamed bodies (unknown length)
+  // always qualify
+  size_t minBytes = 1024;
+  // Comma-separated MIME type prefixes, e.g. "application/json,text/";
+  // nullptr matches any. Must outlive the policy (normally a literal).
+  const char *mimeTypes = nullptr;
+
+  bool enabled() const { return windowBits != 0; }
+
+  // Whether a body of `length` bytes (UNKNOWN_LENGTH for streams) and
+  // `mimeType` should be gzipped for a client sending `acceptEncoding`
+  bool appliesTo(StringView acceptEncoding, StringView mimeType,
+                 size_t length) const;
+};
+
+#endif // GZIP_STREAM_H
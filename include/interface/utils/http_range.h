@@ -0,0 +1,48 @@
+#ifndef HTTP_RANGE_H
+#define HTTP_RANGE_H
+
+#include <Arduino.h>
+#include <interface/utils/string_view.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Byte span of a stored object selected by a Range request
+struct ByteRange {
+  size_t offset = 0;
+  size_t length = 0;
+};
+
+/**
+ * Byte range requests (RFC 9110 section 14)
+ *
+ * Only single ranges are served: "bytes=first-last", "bytes=first-" and
+ * "bytes=-suffix". Requests for several ranges are rejected with 416 rather
+ * than answered with multipart/byteranges, which would need buffering per
+ * part. Malformed or non-byte Range headers are ignored (full response),
+ * as the RFC requires.
+ */
+namespace HttpRange {
+
+enum class Outcome : uint8_t {
+  FULL,         // 200 with the whole object
+  PARTIAL,      // 206 with `range`
+  UNSATISFIABLE // 416
+};
+
+// Parse a Range header against an object of `size` bytes. `range` is the
+// whole object unless the outcome is PARTIAL.
+Outcome parse(StringView rangeHeader, size_t size, ByteRange &range);
+
+// If-Range precondition: true when absent, or when it names the current
+// representation - a strong ETag equal to `etag`, or a date equal to
+// `lastModified`. When false the Range header must be ignored.
+bool ifRangeHolds(StringView ifRange, StringView etag,
+                  StringView lastModified);
+
+// Content-Range value: "bytes 0-499/1234", or "bytes */1234" for a 416
+String contentRange(const ByteRange &range, size_t size);
+String unsatisfiedRange(size_t size);
+
+} // namespace HttpRange
+
+#endif // HTTP_RANGE_H
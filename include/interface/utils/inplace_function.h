@@ -0,0 +1,218 @@
+#ifndef INPLACE_FUNCTION_H
+#define INPLACE_FUNCTION_H
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Default inline capacity: room for `this` plus a few captured members
+#define INPLACE_FUNCTION_DEFAULT_CAPACITY (6 * sizeof(void *))
+
+template <typename Signature,
+          size_t Capacity = INPLACE_FUNCTION_DEFAULT_CAPACITY>
+class InplaceFunction;
+
+/**
+ * InplaceFunction - Copyable callable wrapper that never allocates
+ *
+ * Drop-in replacement for std::function for handlers that are stored and
+ * copied often (route tables). Callables are stored in a fixed inline
+ * buffer; one that does not fit is rejected at compile time instead of
+ * spilling to the heap. Trivially copyable callables (function pointers,
+ * lambdas capturing only pointers or integers) are copied with memcpy.
+ *
+ * For the cheapest dispatch, bind a plain function and a context pointer:
+ *
+ *   static void handleStatus(void *ctx, WebRequest &req, WebResponse &res);
+ *   WebModule::UnifiedRouteHandler handler(&handleStatus, this);
+ *
+ * Invoking an empty InplaceFunction does nothing and returns R().
+ */
+template <typename R, typename... Args, size_t Capacity>
+class InplaceFunction<R(Args...), Capacity> {
+  // Accepts callables invocable with Args; keeps the converting
+  // constructor out of unrelated overload sets
+  template <typename Fn> struct IsCallableImpl {
+    template <typename G>
+    static auto test(int)
+        -> decltype(std::declval<G &>()(std::declval<Args>()...),
+                    std::true_type());
+    template <typename G> static std::false_type test(...);
+    typedef decltype(test<Fn>(0)) type;
+  };
+  template <typename Fn> struct IsCallable : IsCallableImpl<Fn>::type {};
+
+public:
+  typedef R (*ContextFunction)(void *context, Args...);
+
+  InplaceFunction() noexcept : invoker(nullptr), ops(nullptr) {}
+  InplaceFunction(std::nullptr_t) noexcept : invoker(nullptr), ops(nullptr) {}
+
+  // Raw fast path: fn(context, args...)
+  InplaceFunction(ContextFunction fn, void *context) noexcept
+      : invoker(nullptr), ops(nullptr) {
+    if (fn) {
+      BoundContext bound = {fn, context};
+      memcpy(storage, &bound, sizeof(bound));
+      invoker = &invokeBound;
+    }
+  }
+
+  template <typename Fn, typename Decayed = typename std::decay<Fn>::type,
+            typename = typename std::enable_if<
+                !std::is_same<Decayed, InplaceFunction>::value &&
+                IsCallable<Decayed>::value>::type>
+  InplaceFunction(Fn &&fn) : invoker(nullptr), ops(nullptr) {
+    static_assert(sizeof(Decayed) <= Capacity,
+                  "Callable too large for InplaceFunction: capture less "
+                  "state or bind a context pointer instead");
+    static_assert(alignof(Decayed) <= alignof(std::max_align_t),
+                  "Callable alignment exceeds InplaceFunction storage");
+    static_assert(std::is_copy_constructible<Decayed>::value,
+                  "InplaceFunction requires a copyable callable");
+    if (isNull(fn)) {
+      return;
+    }
+    new (storage) Decayed(std::forward<Fn>(fn));
+    invoker = &invokeStored<Decayed>;
+    ops = OpsFor<Decayed>::get();
+  }
+
+  InplaceFunction(const InplaceFunction &other)
+      : invoker(other.invoker), ops(other.ops) {
+    if (ops) {
+      ops->copy(storage, other.storage);
+    } else if (invoker) {
+      memcpy(storage, other.storage, Capacity);
+    }
+  }
+
+  InplaceFunction(InplaceFunction &&other) noexcept
+      : invoker(other.invoker), ops(other.ops) {
+    if (ops) {
+      ops->move(storage, other.storage);
+    } else if (invoker) {
+      memcpy(storage, other.storage, Capacity);
+    }
+  }
+
+  InplaceFunction &operator=(const InplaceFunction &other) {
+    if (this != &other) {
+      InplaceFunction copy(other);
+      *this = std::move(copy);
+    }
+    return *this;
+  }
+
+  InplaceFunction &operator=(InplaceFunction &&other) noexcept {
+    if (this != &other) {
+      reset();
+      invoker = other.invoker;
+      ops = other.ops;
+      if (ops) {
+        ops->move(storage, other.storage);
+      } else if (invoker) {
+        memcpy(storage, other.storage, Capacity);
+      }
+    }
+    return *this;
+  }
+
+  InplaceFunction &operator=(std::nullptr_t) noexcept {
+    reset();
+    return *this;
+  }
+
+  ~InplaceFunction() { reset(); }
+
+  R operator()(Args... args) const {
+    if (!invoker) {
+      return R();
+    }
+    return invoker(const_cast<unsigned char *>(storage),
+                   std::forward<Args>(args)...);
+  }
+
+  explicit operator bool() const noexcept { return invoker != nullptr; }
+
+  static constexpr size_t capacity() { return Capacity; }
+
+private:
+  typedef R (*Invoker)(void *storage, Args...);
+
+  // Type-erased lifetime operations; null for trivially copyable callables
+  struct Ops {
+    void (*copy)(void *dst, const void *src);
+    void (*move)(void *dst, void *src);
+    void (*destroy)(void *target);
+  };
+
+  struct BoundContext {
+    ContextFunction fn;
+    void *context;
+  };
+
+  template <typename Fn, bool Trivial = std::is_trivially_copyable<Fn>::value>
+  struct OpsFor {
+    static const Ops *get() { return nullptr; }
+  };
+  template <typename Fn> struct OpsFor<Fn, false> {
+    static void copy(void *dst, const void *src) {
+      new (dst) Fn(*static_cast<const Fn *>(src));
+    }
+    static void move(void *dst, void *src) {
+      new (dst) Fn(std::move(*static_cast<Fn *>(src)));
+    }
+    static void destroy(void *target) { static_cast<Fn *>(target)->~Fn(); }
+    static const Ops *get() {
+      static const Ops ops = {&copy, &move, &destroy};
+      return &ops;
+    }
+  };
+
+  template <typename Fn> static R invokeStored(void *target, Args... args) {
+    return (*static_cast<Fn *>(target))(std::forward<Args>(args)...);
+  }
+
+  static R invokeBound(void *target, Args... args) {
+    BoundContext bound;
+    memcpy(&bound, target, sizeof(bound));
+    return bound.fn(bound.context, std::forward<Args>(args)...);
+  }
+
+  // Null function pointers and callables with an operator bool that is
+  // false (an empty std::function) convert to empty. Function references,
+  // lambdas and other function objects never are.
+  template <typename Fn> static bool isNull(const Fn &fn) {
+    return isNullImpl(fn, 0);
+  }
+  template <typename Ret, typename... Params>
+  static bool isNullImpl(Ret (*const &fn)(Params...), int) {
+    return fn == nullptr;
+  }
+  template <typename Fn, typename = decltype(&Fn::operator bool)>
+  static bool isNullImpl(const Fn &fn, int) {
+    return !fn;
+  }
+  template <typename Fn> static bool isNullImpl(const Fn &, long) {
+    return false;
+  }
+
+  void reset() noexcept {
+    if (ops) {
+      ops->destroy(storage);
+    }
+    invoker = nullptr;
+    ops = nullptr;
+  }
+
+  // Zeroed so the memcpy of a trivially copyable callable never reads
+  // bytes past the callable that were left uninitialized
+  alignas(std::max_align_t) unsigned char storage[Capacity] = {};
+  Invoker invoker;
+  const Ops *ops;
+};
+
+#endif // INPLACE_FUNCTION_H
@@ -0,0 +1,142 @@
+#ifndef JSON_DOCUMENT_POOL_H
+#define JSON_DOCUMENT_POOL_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <interface/utils/string_view.h>
+#include <memory>
+#include <stdint.h>
+#include <vector>
+
+class WebRequest;
+
+/**
+ * JsonDocumentPool - Reusable JSON documents sized from each route's history
+ *
+ * A fixed-size document for every JSON response is either too small (the
+ * builder's extra members are silently dropped) or paid for at its worst case
+ * by every request. The pool remembers, per route, the largest memoryUsage()
+ * a response has needed and sizes the next document from it with some
+ * headroom. Finished documents are kept and handed out again when they are
+ * large enough, so steady-state responses allocate no document at all.
+ *
+ * build() detects an overflowing document (JsonDocument::overflowed()) and
+ * runs the builder once more in a document of maxCapacity. The route's
+ * learned capacity then covers the larger response, so the retry is paid once
+ * per route, not per request. Builders must therefore tolerate being called
+ * twice.
+ *
+ * Memory is bounded: at most maxDocuments idle documents of at most
+ * maxCapacity bytes each, and MAX_ROUTES learned capacities.
+ *
+ * Not thread-safe; owned by the platform's request loop.
+ */
+class JsonDocumentPool {
+public:
+  static const size_t DEFAULT_MAX_DOCUMENTS = 2;
+  static const size_t DEFAULT_INITIAL_CAPACITY = 512;
+  static const size_t DEFAULT_MAX_CAPACITY = 16 * 1024;
+  static const size_t MAX_ROUTES = 32;
+
+  struct Stats {
+    uint32_t acquisitions = 0;
+    uint32_t hits = 0;          // Served by an idle pooled document
+    uint32_t overflows = 0;     // Builds retried in a larger document
+    uint32_t retryFailures = 0; // Still overflowed at maxCapacity
+
+    // Share of acquisitions served from the pool, 0-100
+    uint32_t hitRatePercent() const {
+      return acquisitions ? hits * 100 / acquisitions : 0;
+    }
+  };
+
+  // A document on loan from the pool; returned when the lease is destroyed
+  class Lease {
+  public:
+    Lease() = default;
+    Lease(Lease &&other) noexcept;
+    Lease &operator=(Lease &&other) noexcept;
+    ~Lease();
+
+    JsonDocument &document() { return *doc; }
+    const JsonDocument &document() const { return *doc; }
+    bool overflowed() const { return doc && doc->overflowed(); }
+
+  private:
+    friend class JsonDocumentPool;
+    Lease(JsonDocumentPool *pool, std::unique_ptr<DynamicJsonDocument> doc)
+        : pool(pool), doc(std::move(doc)) {}
+    void giveBack();
+
+    JsonDocumentPool *pool = nullptr;
+    std::unique_ptr<DynamicJsonDocument> doc;
+  };
+
+  explicit JsonDocumentPool(size_t maxDocuments = DEFAULT_MAX_DOCUMENTS,
+                            size_t initialCapacity = DEFAULT_INITIAL_CAPACITY,
+                            size_t maxCapacity = DEFAULT_MAX_CAPACITY);
+
+  // Run `builder` on a document rooted at a Root (JsonObject or JsonArray)
+  // and sized for `routeKey`, retrying once on overflow. The returned lease
+  // holds the finished document; overflowed() is still true only when the
+  // response did not fit in maxCapacity.
+  template <typename Root, typename Builder>
+  Lease build(StringView routeKey, Builder &&builder);
+
+  // Learning key for a response: the pattern of the route `request` matched,
+  // or an empty key when there is no request or it was not routed
+  static StringView routeKey(const WebRequest *request);
+
+  // Lease an empty document of at least `capacity` bytes
+  Lease acquire(size_t capacity);
+
+  // Document size for the next response on `routeKey`: the learned
+  // high-water mark plus headroom, or initialCapacity for unknown routes
+  size_t capacityFor(StringView routeKey) const;
+
+  // Raise the high-water mark of `routeKey` to `memoryUsage`
+  void learn(StringView routeKey, size_t memoryUsage);
+
+  // Drop idle documents and learned capacities (stats are kept)
+  void clear();
+
+  size_t idleDocuments() const { return idle.size(); }
+  size_t idleBytes() const;
+  const Stats &stats() const { return counters; }
+
+private:
+  struct RouteUsage {
+    String key;
+    size_t highWater;
+  };
+
+  void release(std::unique_ptr<DynamicJsonDocument> doc);
+
+  size_t maxDocuments;
+  size_t initialCapacity;
+  size_t maxCapacity;
+  std::vector<std::unique_ptr<DynamicJsonDocument>> idle;
+  std::vector<RouteUsage> routes;
+  Stats counters;
+};
+
+template <typename Root, typename Builder>
+JsonDocumentPool::Lease JsonDocumentPool::build(StringView routeKey,
+                                                Builder &&builder) {
+  Lease lease = acquire(capacityFor(routeKey));
+  Root root = lease.document().template to<Root>();
+  builder(root);
+  if (lease.overflowed()) {
+    counters.overflows++;
+    lease = acquire(maxCapacity);
+    root = lease.document().template to<Root>();
+    builder(root);
+    if (lease.overflowed()) {
+      counters.retryFailures++;
+    }
+  }
+  learn(routeKey, lease.document().memoryUsage());
+  return lease;
+}
+
+#endif // JSON_DOCUMENT_POOL_H
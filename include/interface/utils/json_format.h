@@ -0,0 +1,49 @@
+#ifndef JSON_FORMAT_H
+#define JSON_FORMAT_H
+
+#include <ArduinoJson.h>
+#include <interface/utils/string_view.h>
+#include <stdint.h>
+
+// Wire formats of JSON documents; MessagePack is the same data model,
+// binary and typically 20-40% smaller
+enum class JsonFormat : uint8_t { JSON, MSGPACK };
+
+/**
+ * JSON / MessagePack negotiation for API bodies
+ *
+ * Responses: negotiate() picks MessagePack only when the Accept header
+ * ranks application/msgpack (or application/x-msgpack) above
+ * application/json, by quality value and media range specificity. A
+ * missing header, a wildcard or a tie keeps JSON, so browsers and existing
+ * clients see no change.
+ *
+ * Requests: fromContentType() recognizes both formats, and deserialize()
+ * parses either into a JsonDocument, so handlers read the same
+ * JsonVariant whichever format the client sent.
+ */
+namespace JsonFormats {
+
+// "application/json" or "application/msgpack"
+const char *mimeType(JsonFormat format);
+
+// Quality 0..1000 that `accept` gives `mediaType` ("type/subtype"),
+// through an exact entry, "type/*" or "*/*"
+uint16_t quality(StringView accept, StringView mediaType);
+
+// Response format for a request's Accept header
+JsonFormat negotiate(StringView accept);
+
+// Format of a body with this Content-Type; false for anything else
+bool fromContentType(StringView contentType, JsonFormat &format);
+
+// Document capacity to parse a body of `length` bytes in `format`
+size_t documentCapacity(size_t length, JsonFormat format);
+
+// Parse `data` in `format` into `doc`
+DeserializationError deserialize(JsonDocument &doc, StringView data,
+                                 JsonFormat format);
+
+} // namespace JsonFormats
+
+#endif // JSON_FORMAT_H
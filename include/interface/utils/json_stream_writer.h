@@ -0,0 +1,128 @@
+#ifndef JSON_STREAM_WRITER_H
+#define JSON_STREAM_WRITER_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <interface/utils/inplace_function.h>
+#include <interface/utils/string_view.h>
+#include <stdint.h>
+
+// Bytes buffered before a chunk is handed to the sink
+#ifndef JSON_STREAM_BUFFER_SIZE
+#define JSON_STREAM_BUFFER_SIZE 256
+#endif
+
+// Deepest object/array nesting the writer tracks
+#define JSON_STREAM_MAX_DEPTH 32
+
+/**
+ * JsonStreamWriter - Incremental JSON serializer with a fixed buffer
+ *
+ * Emits JSON text as the caller walks its data, instead of building a
+ * JsonDocument first. Output collects in an inline buffer of
+ * JSON_STREAM_BUFFER_SIZE bytes and is passed to the ChunkSink each time
+ * the buffer fills, so memory use does not depend on the response size.
+ * Commas and string escaping are handled by the writer:
+ *
+ *   writer.beginObject();
+ *   writer.member("count", devices.size());
+ *   writer.key("devices").beginArray();
+ *   for (const Device &d : devices) {
+ *     writer.beginObject().member("id", d.id).member("on", d.on).endObject();
+ *   }
+ *   writer.endArray().endObject();
+ *
+ * value(JsonVariantConst) splices in an existing ArduinoJson value. If the
+ * sink reports failure (client gone) the writer stops emitting and ok()
+ * turns false; the caller may keep calling it harmlessly.
+ */
+class JsonStreamWriter {
+public:
+  // Receives each chunk of output; returns false to abort the stream
+  typedef InplaceFunction<bool(const char *data, size_t length)> ChunkSink;
+
+  explicit JsonStreamWriter(const ChunkSink &sink);
+
+  JsonStreamWriter &beginObject();
+  JsonStreamWriter &endObject();
+  JsonStreamWriter &beginArray();
+  JsonStreamWriter &endArray();
+
+  // Member name inside an object; the next value belongs to it
+  JsonStreamWriter &key(StringView name);
+
+  JsonStreamWriter &value(StringView text);
+  JsonStreamWriter &value(const char *text) { return value(StringView(text)); }
+  JsonStreamWriter &value(const String &text) {
+    return value(StringView(text));
+  }
+  JsonStreamWriter &value(bool flag);
+  JsonStreamWriter &value(int number) {
+    return value(static_cast<long>(number));
+  }
+  JsonStreamWriter &value(unsigned int number) {
+    return value(static_cast<unsigned long>(number));
+  }
+  JsonStreamWriter &value(long number);
+  JsonStreamWriter &value(unsigned long number);
+  JsonStreamWriter &value(long long number);
+  JsonStreamWriter &value(unsigned long long number);
+  JsonStreamWriter &value(double number); // NaN and infinities become null
+  JsonStreamWriter &value(JsonVariantConst json);
+  JsonStreamWriter &nullValue();
+
+  // Already-serialized JSON, copied verbatim
+  JsonStreamWriter &rawValue(StringView json);
+  // Already-serialized JSON with whitespace outside strings dropped
+  JsonStreamWriter &compactValue(StringView json);
+
+  template <typename T>
+  JsonStreamWriter &member(StringView name, const T &memberValue) {
+    key(name);
+    return value(memberValue);
+  }
+
+  // Hand any buffered output to the sink. Returns ok().
+  bool flush();
+
+  bool ok() const { return !failed; }
+  size_t bytesWritten() const { return written + used; }
+  size_t depth() const { return level; }
+
+private:
+  // Adapts the writer to ArduinoJson's Print-based serializers
+  class JsonPrint : public Print {
+  public:
+    explicit JsonPrint(JsonStreamWriter &writer) : writer(writer) {}
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t *data, size_t length) override;
+
+  private:
+    JsonStreamWriter &writer;
+  };
+
+  void beforeValue();
+  JsonStreamWriter &open(char bracket);
+  JsonStreamWriter &close(char bracket);
+  void writeEscaped(StringView text);
+  void put(char c) {
+    if (used == JSON_STREAM_BUFFER_SIZE) {
+      flush();
+    }
+    buffer[used++] = c;
+  }
+  void put(const char *data, size_t length);
+  void putDigits(unsigned long long number);
+
+  ChunkSink sink;
+  size_t written; // Bytes already accepted by the sink
+  uint16_t used;  // Bytes pending in buffer
+  uint8_t level;  // Current nesting depth
+  bool afterKey;  // A key was written and awaits its value
+  bool failed;
+  // Bit per level: set once the level holds an element (needs a comma)
+  uint32_t hasElement;
+  char buffer[JSON_STREAM_BUFFER_SIZE];
+};
+
+#endif // JSON_STREAM_WRITER_H
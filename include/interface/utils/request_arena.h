@@ -0,0 +1,74 @@
+#ifndef REQUEST_ARENA_H
+#define REQUEST_ARENA_H
+
+#include <interface/utils/string_view.h>
+#include <stdint.h>
+#include <vector>
+
+/**
+ * RequestArena - Single buffer holding all text of one HTTP request
+ *
+ * The raw request (or the pieces a server hands over) is appended once;
+ * path, headers, params and body are then offset/length Slices into that
+ * buffer instead of individually allocated Strings. Values that need
+ * decoding (percent-encoded params) are decoded into the same buffer, and
+ * only when they actually contain escapes.
+ *
+ * Slices stay valid as the buffer grows; StringViews obtained from view()
+ * are invalidated by the next append.
+ */
+class RequestArena {
+public:
+  struct Slice {
+    uint32_t offset;
+    uint32_t length;
+  };
+
+  enum FieldKind : uint8_t {
+    HEADER = 0, // Request header
+    PARAM = 1   // Query string or form parameter
+  };
+
+  struct Field {
+    FieldKind kind;
+    Slice name;
+    Slice value;
+  };
+
+  RequestArena() = default;
+
+  void reserve(size_t bytes, size_t fieldCount = 0);
+  void clear();
+
+  Slice append(const char *data, size_t length);
+  Slice append(StringView text) { return append(text.data(), text.length()); }
+
+  // Slice of text already stored in the arena (e.g. part of the raw request)
+  Slice sliceOf(StringView stored) const;
+
+  // Decoded copy of a percent-encoded value ('+' becomes a space). Returns
+  // `encoded` unchanged when there is nothing to decode.
+  Slice decode(Slice encoded);
+
+  void addField(FieldKind kind, Slice name, Slice value);
+
+  // Split "a=1&b=2" (already stored in the arena) into decoded PARAM fields
+  void addUrlEncodedFields(Slice source);
+
+  StringView view(Slice slice) const {
+    return StringView(buffer.data() + slice.offset, slice.length);
+  }
+
+  // First field of `kind` whose name matches; nullptr when absent
+  const Field *findField(FieldKind kind, StringView name,
+                         bool ignoreCase = false) const;
+
+  const std::vector<Field> &getFields() const { return fields; }
+  size_t bytesUsed() const { return buffer.size(); }
+
+private:
+  std::vector<char> buffer;
+  std::vector<Field> fields;
+};
+
+#endif // REQUEST_ARENA_H
@@ -0,0 +1,114 @@
+#ifndef REQUEST_VALIDATOR_H
+#define REQUEST_VALIDATOR_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <interface/utils/string_view.h>
+#include <stdint.h>
+#include <vector>
+
+// Per-route opt-in for request body validation (see ApiRoute::validated())
+struct RequestValidationPolicy {
+  bool enabled = false;
+  // JSON schema to enforce; nullptr uses the route's documented request
+  // schema (OpenAPIDoc::withRequestBody). Must outlive the route (normally
+  // a string literal).
+  const char *schema = nullptr;
+};
+
+/**
+ * RequestValidator - A JSON schema compiled into a flat rule table
+ *
+ * Compiling parses the schema once (at route registration) and keeps only
+ * what validation needs: one Rule per schema node with its accepted types,
+ * required flag, numeric bounds, length limit and enum values, plus the
+ * property names and error paths in one string pool. Validating walks the
+ * parsed request body against the table without allocating.
+ *
+ * Supported keywords: type (a name or a list), nullable, properties,
+ * required, items, enum (strings and numbers), minimum, maximum, maxLength
+ * (strings) and maxItems (arrays). Other keywords, such as $ref, formats or
+ * patterns, are accepted and not enforced. Schemas nested deeper than
+ * MAX_DEPTH are rejected.
+ */
+class RequestValidator {
+public:
+  static const uint8_t MAX_DEPTH = 8;
+
+  // Why a body was rejected; `path` is the offending field, e.g.
+  // "settings.level" or "tags[]", empty for the body itself. Both point
+  // into the validator or static storage.
+  struct Error {
+    const char *path = "";
+    const char *reason = "";
+  };
+
+  // Compile `schema`; false when it is not valid JSON, not an object or
+  // nests too deeply. A validator that failed to compile accepts nothing.
+  bool compile(StringView schema);
+
+  // Whether `body` satisfies the schema; on failure `error` says why
+  bool validate(JsonVariantConst body, Error &error) const;
+  bool validate(JsonVariantConst body) const {
+    Error error;
+    return validate(body, error);
+  }
+
+  bool compiled() const { return !rules.empty(); }
+  size_t ruleCount() const { return rules.size(); }
+  // Heap held by the compiled tables
+  size_t memoryUsage() const;
+
+private:
+  enum TypeBits : uint8_t {
+    TYPE_NULL = 1,
+    TYPE_BOOLEAN = 2,
+    TYPE_INTEGER = 4,
+    TYPE_NUMBER = 8, // Integers carry both bits
+    TYPE_STRING = 16,
+    TYPE_ARRAY = 32,
+    TYPE_OBJECT = 64
+  };
+
+  enum RuleFlags : uint8_t {
+    REQUIRED = 1,
+    HAS_MINIMUM = 2,
+    HAS_MAXIMUM = 4,
+    HAS_MAX_LENGTH = 8
+  };
+
+  static const uint16_t NO_RULE = 0xFFFF;
+
+  struct Rule {
+    uint16_t name = 0;       // Property name in `strings`
+    uint16_t path = 0;       // Error path in `strings`
+    uint16_t firstChild = 0; // Properties occupy consecutive rules
+    uint16_t childCount = 0;
+    uint16_t items = NO_RULE; // Rule for array elements
+    uint16_t firstEnum = 0;
+    uint16_t enumCount = 0;
+    uint16_t maxLength = 0;
+    uint8_t types = 0; // TypeBits; 0 accepts any type
+    uint8_t flags = 0;
+    double minimum = 0;
+    double maximum = 0;
+  };
+
+  struct EnumValue {
+    uint16_t text; // Offset in `strings`, or NO_RULE for a number
+    double number;
+  };
+
+  bool compileRule(JsonVariantConst schema, uint16_t index, uint8_t depth);
+  bool validateRule(const Rule &rule, JsonVariantConst value,
+                    Error &error) const;
+  bool matchesEnum(const Rule &rule, JsonVariantConst value) const;
+  uint16_t addString(StringView text);
+  const char *string(uint16_t offset) const { return &strings[offset]; }
+
+  std::vector<Rule> rules;
+  std::vector<EnumValue> enums;
+  std::vector<char> strings;
+};
+
+#endif // REQUEST_VALIDATOR_H
@@ -0,0 +1,107 @@
+#ifndef RESPONSE_CACHE_H
+#define RESPONSE_CACHE_H
+
+#include <Arduino.h>
+#include <interface/utils/string_view.h>
+#include <interface/web_module_types.h>
+#include <stdint.h>
+#include <utility>
+#include <vector>
+
+class WebRequest;
+
+// Per-route opt-in for response caching (see WebRoute::cached())
+struct ResponseCachePolicy {
+  uint32_t ttlMs = 0; // 0 disables caching
+  // Comma-separated query params that select distinct cached copies, e.g.
+  // "fields,limit". Other params are ignored. Must outlive the route
+  // (normally a string literal).
+  const char *varyParams = nullptr;
+
+  bool enabled() const { return ttlMs > 0; }
+};
+
+/**
+ * ResponseCache - Bounded LRU of finished GET responses with per-entry TTL
+ *
+ * Platforms consult the cache for routes that declare a ResponseCachePolicy:
+ * after routing and authentication, a fresh entry is sent as-is and the
+ * handler is not called; otherwise the handler runs and a 200 response is
+ * stored. Entries hold the final status, MIME type, headers and body.
+ *
+ * The cache is bounded by entry count and total body/header bytes; the least
+ * recently used entry is evicted first. Modules drop stale entries through
+ * IWebPlatform::invalidateResponseCache() when their state changes.
+ *
+ * Not thread-safe; owned by the platform's request loop.
+ */
+class ResponseCache {
+public:
+  static const size_t DEFAULT_MAX_ENTRIES = 16;
+  static const size_t DEFAULT_MAX_BYTES = 16 * 1024;
+
+  struct Entry {
+    int statusCode = 200;
+    String mimeType;
+    String body;
+    std::vector<std::pair<String, String>> headers;
+  };
+
+  struct Stats {
+    uint32_t hits = 0;
+    uint32_t misses = 0;
+    uint32_t stores = 0;
+    uint32_t evictions = 0; // LRU or size-bound evictions
+    uint32_t expirations = 0;
+    uint32_t invalidations = 0;
+  };
+
+  explicit ResponseCache(size_t maxEntries = DEFAULT_MAX_ENTRIES,
+                         size_t maxBytes = DEFAULT_MAX_BYTES);
+
+  // Cache key: path, method, the format negotiated from Accept (so JSON and
+  // MessagePack answers are cached apart) and the policy's vary params
+  static String key(WebModule::Method method, StringView path,
+                    const WebRequest &request,
+                    const ResponseCachePolicy &policy);
+
+  // Fresh entry for `key`, or nullptr. Valid until the next store(),
+  // invalidate() or clear().
+  const Entry *find(const String &key, uint32_t nowMs);
+
+  // Returns false when the entry alone exceeds the byte bound
+  bool store(const String &key, Entry entry, uint32_t ttlMs, uint32_t nowMs);
+
+  // Drop entries whose path is `pathPrefix` or lies below it; an empty
+  // prefix clears the cache. Returns the number dropped. Keys hold full
+  // request paths ("/api/<base path>/..."), so a module-relative prefix
+  // matches nothing.
+  size_t invalidate(StringView pathPrefix);
+  void clear();
+
+  size_t size() const { return slots.size(); }
+  size_t bytes() const { return totalBytes; }
+  const Stats &stats() const { return counters; }
+
+private:
+  struct Slot {
+    String key;
+    Entry entry;
+    uint32_t expiresAt;
+    uint32_t lastUsed; // Use counter for LRU order
+    size_t bytes;
+  };
+
+  static size_t footprint(const String &key, const Entry &entry);
+  void erase(size_t index);
+  void evictLeastRecentlyUsed();
+
+  size_t maxEntries;
+  size_t maxBytes;
+  size_t totalBytes;
+  uint32_t useCounter;
+  std::vector<Slot> slots;
+  Stats counters;
+};
+
+#endif // RESPONSE_CACHE_H
@@ -0,0 +1,106 @@
+#ifndef ROUTE_TRIE_H
+#define ROUTE_TRIE_H
+
+#include <Arduino.h>
+#include <cstring>
+#include <interface/web_module_types.h>
+#include <memory>
+#include <vector>
+
+/**
+ * RouteTrie - Compressed radix trie for resolving request paths to routes
+ *
+ * Stores route patterns made of static text, whole-segment "{param}"
+ * captures and an optional trailing "*" wildcard. Lookups walk the request
+ * path once, so match cost depends on the path length rather than on the
+ * number of registered routes. Both the real WebPlatform and
+ * MockWebPlatform use it to map (path, WebModule::Method) to the caller's
+ * route index.
+ *
+ * Precedence when several patterns could match: static text first, then a
+ * "{param}" segment, then the trailing wildcard.
+ */
+class RouteTrie {
+public:
+  static const size_t MAX_PARAMS = 8;
+  static const size_t METHOD_COUNT = 5; // WM_GET .. WM_PATCH
+
+  // Result of a lookup. Param values point into the matched path, so the
+  // path must outlive the Match; names point into the trie.
+  struct Match {
+    struct Param {
+      const char *name;
+      const char *value;
+      size_t length;
+    };
+
+    int routeId = -1;
+    const char *pattern = nullptr; // Pattern the route was registered with
+    size_t paramCount = 0;
+    Param params[MAX_PARAMS];
+
+    bool found() const { return routeId >= 0; }
+
+    // Convenience accessor - allocates, prefer params[] on hot paths
+    String getParam(const String &name) const;
+  };
+
+  RouteTrie();
+  ~RouteTrie();
+
+  RouteTrie(const RouteTrie &) = delete;
+  RouteTrie &operator=(const RouteTrie &) = delete;
+
+  // Register a pattern. Returns false if the pattern is malformed; an
+  // existing route for the same pattern and method is replaced.
+  bool insert(const String &pattern, WebModule::Method method, int routeId);
+
+  // Remove a pattern previously registered with insert()
+  bool remove(const String &pattern, WebModule::Method method);
+
+  // Resolve a request path (without query string)
+  bool match(const char *path, size_t length, WebModule::Method method,
+             Match &result) const;
+  bool match(const char *path, WebModule::Method method,
+             Match &result) const {
+    return match(path, path ? strlen(path) : 0, method, result);
+  }
+  bool match(const String &path, WebModule::Method method,
+             Match &result) const {
+    return match(path.c_str(), path.length(), method, result);
+  }
+
+  size_t size() const { return routeCount; }
+  void clear();
+
+private:
+  struct Entry {
+    String pattern;
+    int routeId;
+    std::vector<String> paramNames;
+  };
+
+  struct Node {
+    String prefix; // Compressed static label (never contains '{' or '*')
+    String indices; // First character of each static child, same order
+    std::vector<std::unique_ptr<Node>> children; // Static children
+    std::unique_ptr<Node> paramChild;            // "{name}" segment
+    int entries[METHOD_COUNT];         // Routes terminating here
+    int wildcardEntries[METHOD_COUNT]; // Routes ending in "*" here
+
+    Node();
+  };
+
+  std::unique_ptr<Node> root;
+  std::vector<Entry> entryTable; // Indexed by Node::entries values
+  size_t routeCount;
+
+  static Node *findChild(const Node *node, char first);
+  Node *insertStatic(Node *node, const char *text, size_t length);
+  bool matchNode(const Node *node, const char *path, size_t length,
+                 size_t pos, size_t method, Match &result) const;
+  bool finishMatch(int entryIndex, Match &result) const;
+  int *findSlot(const String &pattern, WebModule::Method method);
+};
+
+#endif // ROUTE_TRIE_H
@@ -1,29 +1,37 @@
 #ifndef ROUTE_VARIANT_H
 #define ROUTE_VARIANT_H
 
-// Forward declarations to avoid circular includes
-struct WebRoute;
-struct ApiRoute;
+#include <interface/route_types.h>
 
-// Simple variant-like class for C++11/14 compatibility
+// Simple variant-like class for C++11/14 compatibility. The route is stored
+// inline in a tagged union, so building and relocating vectors of routes
+// never allocates for the variant itself.
 class RouteVariant {
 private:
   enum Type { WEB_ROUTE, API_ROUTE } type;
   union {
-    WebRoute *webRoute;
-    ApiRoute *apiRoute;
+    WebRoute webRoute;
+    ApiRoute apiRoute;
   };
 
+  void destroy();
+
 public:
   // Constructors
   RouteVariant(const WebRoute &route);
   RouteVariant(const ApiRoute &route);
+  RouteVariant(WebRoute &&route) noexcept;
+  RouteVariant(ApiRoute &&route) noexcept;
 
   // Copy constructor
   RouteVariant(const RouteVariant &other);
 
-  // Assignment operator
+  // Move constructor - noexcept so std::vector relocates by moving
+  RouteVariant(RouteVariant &&other) noexcept;
+
+  // Assignment operators
   RouteVariant &operator=(const RouteVariant &other);
+  RouteVariant &operator=(RouteVariant &&other) noexcept;
 
   // Destructor
   ~RouteVariant();
@@ -42,4 +50,4 @@ template <typename T> bool holds_alternative(const RouteVariant &v);
 
 template <typename T> const T &get(const RouteVariant &v);
 
-#endif
\ No newline at end of file
+#endif
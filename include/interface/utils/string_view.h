@@ -0,0 +1,93 @@
+#ifndef STRING_VIEW_H
+#define STRING_VIEW_H
+
+#include <Arduino.h>
+#include <cstring>
+
+/**
+ * StringView - Non-owning view of a character range
+ *
+ * A C++11 stand-in for std::string_view used by the non-allocating request
+ * accessors (WebRequest::pathView() and friends). The viewed characters are
+ * not NUL-terminated in general; use data()/length() or toString(). A view
+ * is only valid while the object it was obtained from is alive and
+ * unmodified.
+ */
+class StringView {
+public:
+  static const size_t npos = static_cast<size_t>(-1);
+
+  constexpr StringView() : ptr(nullptr), len(0) {}
+  constexpr StringView(const char *data, size_t length)
+      : ptr(data), len(length) {}
+  StringView(const char *str) : ptr(str), len(str ? strlen(str) : 0) {}
+  StringView(const String &str) : ptr(str.c_str()), len(str.length()) {}
+
+  constexpr const char *data() const { return ptr; }
+  constexpr size_t length() const { return len; }
+  constexpr size_t size() const { return len; }
+  constexpr bool empty() const { return len == 0; }
+  constexpr char operator[](size_t index) const { return ptr[index]; }
+  const char *begin() const { return ptr; }
+  const char *end() const { return ptr + len; }
+
+  StringView substr(size_t pos, size_t count = npos) const {
+    if (pos > len) {
+      return StringView(ptr + len, 0);
+    }
+    size_t remaining = len - pos;
+    return StringView(ptr + pos, count < remaining ? count : remaining);
+  }
+
+  size_t find(char c, size_t pos = 0) const {
+    for (size_t i = pos; i < len; i++) {
+      if (ptr[i] == c) {
+        return i;
+      }
+    }
+    return npos;
+  }
+
+  bool equals(StringView other) const {
+    return len == other.len && (len == 0 || memcmp(ptr, other.ptr, len) == 0);
+  }
+
+  bool equalsIgnoreCase(StringView other) const {
+    if (len != other.len) {
+      return false;
+    }
+    for (size_t i = 0; i < len; i++) {
+      if (toLower(ptr[i]) != toLower(other.ptr[i])) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool startsWith(StringView prefix) const {
+    return prefix.len <= len && substr(0, prefix.len).equals(prefix);
+  }
+
+  // Copies the viewed characters into a new String (allocates)
+  String toString() const {
+    String result;
+    result.reserve(len);
+    for (size_t i = 0; i < len; i++) {
+      result += ptr[i];
+    }
+    return result;
+  }
+
+  friend bool operator==(StringView a, StringView b) { return a.equals(b); }
+  friend bool operator!=(StringView a, StringView b) { return !a.equals(b); }
+
+private:
+  static char toLower(char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+  }
+
+  const char *ptr;
+  size_t len;
+};
+
+#endif // STRING_VIEW_H
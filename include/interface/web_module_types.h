@@ -24,6 +24,9 @@ enum Method {
   WM_PATCH = 4
 };
 
+// Route set requested from a module (see IWebModule::forEachRoute)
+enum Transport { TRANSPORT_HTTP = 0, TRANSPORT_HTTPS = 1 };
+
 } // namespace WebModule
 
 // Utility functions for HTTP method conversion
@@ -7,10 +7,15 @@
 #endif
 
 #include <Arduino.h>
+#include <ArduinoJson.h>
 #include <interface/auth_types.h>
+#include <interface/http_headers.h>
+#include <interface/utils/request_arena.h>
+#include <interface/utils/string_view.h>
 #include <interface/web_module_types.h>
 #include <interface/webserver_typedefs.h>
 #include <map>
+#include <memory>
 
 // Common HTTP headers that should be collected by web servers
 // Note: Using const char* (non-const array) for WebServer compatibility
@@ -25,16 +30,41 @@ struct httpd_req;
  * for accessing request data across Arduino WebServer and ESP-IDF
  * HTTP server implementations without modules needing to know about
  * WebPlatform internals.
+ *
+ * Request text lives in one per-request RequestArena: path, body, client IP,
+ * headers and query/form params are slices into it rather than separate
+ * Strings and maps. The *View() accessors return non-allocating StringViews
+ * into the arena (valid for the lifetime of the request); the String getters
+ * remain for convenience and copy.
+ *
+ * Query string, form body and JSON body are parsed lazily, each at most
+ * once, on the first accessor that needs them, so routes that never read
+ * params pay nothing. The parsed JSON document is kept whole.
+ *
+ * Headers listed in WEB_PLATFORM_COMMON_HEADERS are indexed by HeaderId as
+ * they are stored, so getHeader(HeaderId::AUTHORIZATION) is an array lookup;
+ * any other header falls back to a case-insensitive scan of the arena.
  */
 class WebRequest {
 private:
-  String path;
+  // Sources parsed so far (bit flags)
+  enum ParsedSource : uint8_t {
+    PARSED_QUERY = 1,
+    PARSED_FORM = 2,
+    PARSED_JSON = 4
+  };
+
+  mutable RequestArena arena; // Raw request text plus decoded param values
+  RequestArena::Slice pathSlice;
+  RequestArena::Slice querySlice;
+  RequestArena::Slice bodySlice;
+  RequestArena::Slice clientIpSlice;
+  // Arena field index of each common header, NO_HEADER when absent
+  static constexpr uint8_t NO_HEADER = 0xFF;
+  uint8_t headerSlots[HttpHeaders::COUNT];
   WebModule::Method method;
-  String body;
-  String clientIp;
-  std::map<String, String> params;
-  std::map<String, String> headers;
-  std::map<String, String> jsonParams;
+  mutable uint8_t parsedSources;
+  mutable std::unique_ptr<DynamicJsonDocument> jsonDoc; // Null until parsed
   AuthContext authContext;    // Authentication information
   String matchedRoutePattern; // Route pattern that matched this request
   String moduleBasePath;      // Base path of the module handling this request
@@ -44,11 +74,23 @@ public:
   explicit WebRequest(WebServerClass *server);
   explicit WebRequest(httpd_req *req);
 
+  // Constructor from a raw HTTP/1.x request (request line, headers and
+  // body), copied into the arena once
+  WebRequest(const char *rawRequest, size_t length,
+             const String &clientIp = "");
+
   // Request information
-  String getPath() const { return path; }
+  String getPath() const { return pathView().toString(); }
   WebModule::Method getMethod() const { return method; }
-  String getBody() const { return body; }
-  String getClientIp() const { return clientIp; }
+  String getBody() const { return bodyView().toString(); }
+  String getClientIp() const { return arena.view(clientIpSlice).toString(); }
+
+  // Non-allocating accessors; missing params/headers yield an empty view
+  StringView pathView() const { return arena.view(pathSlice); }
+  StringView bodyView() const { return arena.view(bodySlice); }
+  StringView paramView(StringView name) const;
+  StringView headerView(StringView name) const; // Case-insensitive
+  StringView headerView(HeaderId id) const;
 
   // Path parameter helpers
   String getRouteParameter(
@@ -56,13 +98,15 @@ public:
 
   // URL parameters (query string and POST form data)
   String getParam(const String &name) const;
-  std::map<String, String> getAllParams() const { return params; }
+  std::map<String, String> getAllParams() const;
 
   // Headers
   String getHeader(const String &name) const;
+  String getHeader(HeaderId id) const { return headerView(id).toString(); }
 
-  // JSON parameter access
+  // JSON parameter access (top-level members of a JSON body)
   String getJsonParam(const String &name) const;
+  JsonVariantConst getJsonBody() const; // Null variant if not JSON
 
   // Authentication context
   const AuthContext &getAuthContext() const { return authContext; }
@@ -72,6 +116,9 @@ public:
   void setMatchedRoute(const char *routePattern) {
     matchedRoutePattern = routePattern ? String(routePattern) : "";
   }
+  // Pattern of the matched route, e.g. "/api/items/{id}"; empty before
+  // routing
+  const String &getMatchedRoute() const { return matchedRoutePattern; }
 
   // Module context (used by template processing)
   void setModuleBasePath(const String &basePath) { moduleBasePath = basePath; }
@@ -80,11 +127,14 @@ public:
 private:
   // Helper method to populate auth context for UI state (not authentication)
   void checkSessionInformation();
-  void parseQueryParams(const String &query);
-  void parseFormData(const String &formData);
-  void parseJsonData(const String &jsonData);
-  void parseRequestBody(const String &body, const String &contentType);
-  String urlDecode(const String &str);
+  void parseRawRequest(const char *rawRequest, size_t length);
+  void addHeader(StringView name, StringView value);
+  void ensureParamsParsed() const;
+  void ensureJsonParsed() const;
+  void parseQueryParams(RequestArena::Slice query) const;
+  void parseFormData(RequestArena::Slice formData) const;
+  void parseJsonData(StringView jsonData) const;
+  bool bodyHasContentType(const char *mimeType) const;
 
   void parseClientIp(httpd_req *req);
 };
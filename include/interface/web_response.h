@@ -3,8 +3,16 @@
 
 #include <Arduino.h>
 #include <ArduinoJson.h>
+#include <interface/progmem_asset.h>
+#include <interface/utils/content_encoding.h>
+#include <interface/utils/etag.h>
+#include <interface/utils/http_range.h>
+#include <interface/utils/json_format.h>
+#include <interface/utils/json_stream_writer.h>
+#include <interface/web_request.h>
 #include <interface/webserver_typedefs.h>
 #include <map>
+#include <string.h>
 
 struct httpd_req;
 typedef int esp_err_t;
@@ -16,8 +24,32 @@ typedef int esp_err_t;
  * for sending responses across Arduino WebServer and ESP-IDF HTTP
  * server implementations without modules needing to know about
  * WebPlatform internals.
+ *
+ * Large JSON bodies can be streamed: setJsonStreamContent() stores a
+ * callback that is run when the response is sent, writing through a
+ * JsonStreamWriter straight to the connection in chunks. The callback runs
+ * after the handler returns, so it must capture by value (or point at
+ * state that outlives the request).
+ *
+ * Platforms bind the request being answered (bindRequest()) before calling
+ * the handler, so setters can negotiate with it: setProgmemContent() with
+ * a ProgmemAsset sends the gzip or brotli copy when Accept-Encoding allows,
+ * and setNegotiatedJsonContent() sends MessagePack to clients that prefer
+ * it.
+ *
+ * Validators: setETag() answers 304 Not Modified when If-None-Match names
+ * the tag, and ProgmemAssets carry build-time tags. enableJsonStreamETag()
+ * has the platform hash the JSON stream in a first pass so polling clients
+ * get a 304 instead of the body.
+ *
+ * Storage streams honor single byte ranges: before sending, platforms call
+ * resolveRange() with the object size and stream only the selected span,
+ * seeking in the storage driver rather than reading past the prefix.
  */
 class WebResponse {
+public:
+  typedef InplaceFunction<void(JsonStreamWriter &)> JsonStreamCallback;
+
 private:
   int statusCode;
   String content;
@@ -27,29 +59,90 @@ private:
   bool responseSent;
   const char *progmemData;
   bool isProgmemContent;
+  size_t progmemLength = NUL_TERMINATED; // Binary (compressed) PROGMEM bodies
+  const WebRequest *boundRequest = nullptr;
   const JsonDocument *jsonDoc;
   bool isJsonContent;
+  JsonStreamCallback jsonStreamCallback;
+  bool isJsonStreamContent;
+  bool jsonStreamETag = false; // Weak ETag over the stream output
   String storageCollection;
   String storageKey;
   String storageDriverName;
   bool isStorageStreamContent;
 
 public:
+  // progmemLength of plain setProgmemContent() data: read up to the NUL
+  static const size_t NUL_TERMINATED = static_cast<size_t>(-1);
+
   WebResponse();
 
   // Response configuration
   void setStatus(int code);
   void setContent(const String &content, const String &mimeType = "text/html");
   void setProgmemContent(const char *progmemData, const String &mimeType);
+  inline void setProgmemContent(const ProgmemAsset &asset);
   void setJsonContent(const JsonDocument &doc);
+  // Serialize `doc` now in `format`; MessagePack bodies are binary
+  inline void setJsonContent(const JsonDocument &doc, JsonFormat format);
+  // setJsonContent() in the format the bound request's Accept header
+  // prefers (JSON when no request is bound)
+  inline void setNegotiatedJsonContent(const JsonDocument &doc);
+  void setJsonStreamContent(const JsonStreamCallback &writer,
+                            const String &mimeType = "application/json");
   void setStorageStreamContent(const String &collection, const String &key,
                                const String &mimeType,
                                const String &driverName = "");
   void setHeader(const String &name, const String &value);
   void redirect(const String &url, int code = 302);
 
+  // Sets the ETag header. Returns true, with the status switched to 304 Not
+  // Modified, when the bound request's If-None-Match already names the tag;
+  // the handler can then skip building content (any body is dropped).
+  inline bool setETag(const String &etag);
+
+  // Tag the JSON stream with a weak ETag computed while streaming: the
+  // platform runs the callback once to hash its output before sending, and
+  // answers 304 without the body when If-None-Match matches
+  void enableJsonStreamETag() { jsonStreamETag = true; }
+  String computeJsonStreamETag() const {
+    ETag::Hasher hasher;
+    writeJsonStream([&hasher](const char *data, size_t length) {
+      hasher.update(data, length);
+      return true;
+    });
+    return ETag::format(hasher.digest(), true);
+  }
+
+  // Apply the bound request's Range / If-Range to an object of
+  // `objectSize` bytes: advertises Accept-Ranges, and on a usable range sets
+  // 206 with Content-Range (or 416). `range` is the span to send. Only 200
+  // responses are ranged; called by platforms for storage streams.
+  inline HttpRange::Outcome resolveRange(size_t objectSize, ByteRange &range);
+
   bool hasProgmemContent() const { return isProgmemContent; }
   const char *getProgmemData() const { return progmemData; }
+  size_t getProgmemLength() const {
+    if (progmemLength != NUL_TERMINATED) {
+      return progmemLength;
+    }
+    return progmemData ? strlen(progmemData) : 0;
+  }
+  bool hasJsonStreamContent() const { return isJsonStreamContent; }
+
+  // Run the JSON stream callback, passing each chunk to `sink`. Returns the
+  // number of bytes the sink accepted; stops early if the sink fails.
+  size_t writeJsonStream(const JsonStreamWriter::ChunkSink &sink) const {
+    JsonStreamWriter writer(sink);
+    jsonStreamCallback(writer);
+    writer.flush();
+    return writer.bytesWritten();
+  }
+
+  // Request this response answers; called by the platform before the
+  // handler runs. The request must outlive the response's use of it.
+  void bindRequest(const WebRequest &request) { boundRequest = &request; }
+  const WebRequest *getBoundRequest() const { return boundRequest; }
 
   // Send response (called internally by WebPlatform)
   void sendTo(WebServerClass *server);
@@ -67,6 +160,31 @@ public:
   String getHeader(const String &name) const;
 
 private:
+  // Appends bytes, NULs included, to a String body
+  class ContentPrint : public Print {
+  public:
+    explicit ContentPrint(String &body) : body(body) {}
+    size_t write(uint8_t c) override {
+      body += static_cast<char>(c);
+      return 1;
+    }
+    size_t write(const uint8_t *data, size_t length) override {
+      for (size_t i = 0; i < length; i++) {
+        body += static_cast<char>(data[i]);
+      }
+      return length;
+    }
+
+  private:
+    String &body;
+  };
+
+  bool requestHasETag(StringView etag) const {
+    return boundRequest &&
+           ETag::matches(boundRequest->headerView(HeaderId::IF_NONE_MATCH),
+                         etag);
+  }
+
   void markHeadersSent() { headersSent = true; }
   void markResponseSent() { responseSent = true; }
 
@@ -77,15 +195,133 @@ private:
   // JSON streaming helper
   void streamJsonContent(const JsonDocument &doc, WebServerClass *server);
   esp_err_t streamJsonContent(const JsonDocument &doc, httpd_req *req);
+  void sendJsonStream(WebServerClass *server);
+  esp_err_t sendJsonStream(httpd_req *req);
 
   // Storage-based streaming helpers
   void streamFromStorage(const String &collection, const String &key,
                          WebServerClass *server, const String &driverName = "");
   esp_err_t streamFromStorage(const String &collection, const String &key,
                               httpd_req *req, const String &driverName = "");
+  // Ranged variants: the driver seeks to `offset` and sends `length` bytes
+  void streamFromStorage(const String &collection, const String &key,
+                         size_t offset, size_t length, WebServerClass *server,
+                         const String &driverName = "");
+  esp_err_t streamFromStorage(const String &collection, const String &key,
+                              size_t offset, size_t length, httpd_req *req,
+                              const String &driverName = "");
 
   // Allow WebPlatform to call private methods
   friend class WebPlatform;
+  friend class NativeWebPlatform; // Host loopback server (testing/)
 };
 
+inline bool WebResponse::setETag(const String &etag) {
+  setHeader("ETag", etag);
+  if (!requestHasETag(etag)) {
+    return false;
+  }
+  setStatus(304);
+  return true;
+}
+
+inline HttpRange::Outcome WebResponse::resolveRange(size_t objectSize,
+                                                    ByteRange &range) {
+  range.offset = 0;
+  range.length = objectSize;
+  setHeader("Accept-Ranges", "bytes");
+  if (!boundRequest || statusCode != 200) {
+    return HttpRange::Outcome::FULL;
+  }
+  StringView rangeHeader = boundRequest->headerView(HeaderId::RANGE);
+  if (rangeHeader.empty() ||
+      !HttpRange::ifRangeHolds(boundRequest->headerView(HeaderId::IF_RANGE),
+                               getHeader("ETag"), getHeader("Last-Modified"))) {
+    return HttpRange::Outcome::FULL;
+  }
+
+  HttpRange::Outcome outcome =
+      HttpRange::parse(rangeHeader, objectSize, range);
+  if (outcome == HttpRange::Outcome::PARTIAL) {
+    setStatus(206);
+    setHeader("Content-Range", HttpRange::contentRange(range, objectSize));
+  } else if (outcome == HttpRange::Outcome::UNSATISFIABLE) {
+    setStatus(416);
+    setHeader("Content-Range", HttpRange::unsatisfiedRange(objectSize));
+    range.length = 0;
+  }
+  return outcome;
+}
+
+inline void WebResponse::setJsonContent(const JsonDocument &doc,
+                                        JsonFormat format) {
+  if (format == JsonFormat::JSON) {
+    setJsonContent(doc);
+    return;
+  }
+  setContent(String(), JsonFormats::mimeType(format));
+  content.reserve(measureMsgPack(doc));
+  ContentPrint body(content);
+  serializeMsgPack(doc, body);
+}
+
+// Every negotiated answer carries Vary: Accept, JSON included: the body
+// depends on the request's Accept, so a shared cache must not hand a JSON
+// copy to a MessagePack-only client. The platform's response cache keys on
+// the negotiated format for the same reason.
+inline void WebResponse::setNegotiatedJsonContent(const JsonDocument &doc) {
+  JsonFormat format =
+      boundRequest
+          ? JsonFormats::negotiate(boundRequest->headerView(HeaderId::ACCEPT))
+          : JsonFormat::JSON;
+  if (boundRequest) {
+    setHeader("Vary", "Accept");
+  }
+  setJsonContent(doc, format);
+}
+
+// Picks the smallest encoding the bound request accepts (identity when no
+// request is bound) and sets Content-Encoding; Vary is set whenever a
+// compressed copy exists, since the choice depends on the request. With an
+// ETag, a matching If-None-Match becomes a 304 and flash is never read.
+inline void WebResponse::setProgmemContent(const ProgmemAsset &asset) {
+  StringView acceptEncoding =
+      boundRequest ? boundRequest->headerView(HeaderId::ACCEPT_ENCODING)
+                   : StringView();
+  ContentEncoding encoding = ContentEncodings::negotiate(
+      acceptEncoding, asset.gzip != nullptr, asset.brotli != nullptr);
+  if (asset.gzip || asset.brotli) {
+    setHeader("Vary", "Accept-Encoding");
+  }
+
+  if (asset.etag) {
+    // Each encoding is a different representation: "<tag>-gzip"
+    String etag = asset.etag;
+    if (encoding != ContentEncoding::IDENTITY && etag.endsWith("\"")) {
+      etag = etag.substring(0, etag.length() - 1);
+      etag += '-';
+      etag += ContentEncodings::name(encoding);
+      etag += '"';
+    }
+    if (setETag(etag)) {
+      return;
+    }
+  }
+
+  const uint8_t *data = asset.identity;
+  size_t length = asset.identityLength;
+  if (encoding == ContentEncoding::GZIP) {
+    data = asset.gzip;
+    length = asset.gzipLength;
+  } else if (encoding == ContentEncoding::BROTLI) {
+    data = asset.brotli;
+    length = asset.brotliLength;
+  }
+  setProgmemContent(reinterpret_cast<const char *>(data), asset.mimeType);
+  progmemLength = length;
+  if (encoding != ContentEncoding::IDENTITY) {
+    setHeader("Content-Encoding", ContentEncodings::name(encoding));
+  }
+}
+
 #endif // WEB_RESPONSE_H
\ No newline at end of file
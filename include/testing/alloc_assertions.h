@@ -0,0 +1,49 @@
+#ifndef ALLOC_ASSERTIONS_H
+#define ALLOC_ASSERTIONS_H
+
+#include <testing/alloc_scope.h>
+#include <unity.h>
+
+/**
+ * Unity assertions for heap allocation budgets (native builds)
+ *
+ * Each macro runs the statement(s) inside an AllocScope and fails the test
+ * when the budget is exceeded:
+ *
+ *   TEST_ASSERT_MAX_ALLOCS(2, module.handleStatus(request, response));
+ *   TEST_ASSERT_MAX_ALLOC_BYTES(1024, platform.registerModule("/x", &mod));
+ *   TEST_ASSERT_MAX_PEAK_BYTES(4096, { WebResponse r; handler(req, r); });
+ *   TEST_ASSERT_NO_ALLOCS(auth.has(AuthType::TOKEN));
+ *
+ * Budgets are only enforced when allocTrackingAvailable(); builds without
+ * WEB_PLATFORM_ALLOC_TRACKING (or without glibc) run the code and pass.
+ */
+
+#define WEB_PLATFORM_ASSERT_ALLOC_BUDGET(field, what, limit, ...)            \
+  do {                                                                         \
+    AllocScope allocBudgetScope;                                               \
+    __VA_ARGS__;                                                               \
+    allocBudgetScope.stop();                                                   \
+    if (allocTrackingAvailable()) {                                            \
+      TEST_ASSERT_LESS_OR_EQUAL_UINT64_MESSAGE(                                \
+          (limit), allocBudgetScope.stats().field,                             \
+          what " over budget in: " #__VA_ARGS__);                              \
+    }                                                                          \
+  } while (0)
+
+// At most `n` heap allocations
+#define TEST_ASSERT_MAX_ALLOCS(n, ...)                                         \
+  WEB_PLATFORM_ASSERT_ALLOC_BUDGET(count, "allocations", n, __VA_ARGS__)
+
+// At most `n` bytes requested in total
+#define TEST_ASSERT_MAX_ALLOC_BYTES(n, ...)                                    \
+  WEB_PLATFORM_ASSERT_ALLOC_BUDGET(bytes, "allocated bytes", n, __VA_ARGS__)
+
+// Live heap never rises more than `n` bytes above its starting level
+#define TEST_ASSERT_MAX_PEAK_BYTES(n, ...)                                     \
+  WEB_PLATFORM_ASSERT_ALLOC_BUDGET(peakLiveBytes, "peak live bytes", n,        \
+                                   __VA_ARGS__)
+
+#define TEST_ASSERT_NO_ALLOCS(...) TEST_ASSERT_MAX_ALLOCS(0, __VA_ARGS__)
+
+#endif // ALLOC_ASSERTIONS_H
@@ -0,0 +1,66 @@
+#ifndef ALLOC_SCOPE_H
+#define ALLOC_SCOPE_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Heap allocation instrumentation for native builds
+ *
+ * Off-device stand-in for watching heap churn: when the build defines
+ * WEB_PLATFORM_ALLOC_TRACKING, src/testing/alloc_scope_native.cpp replaces
+ * malloc/calloc/realloc/free and the global operator new/delete family and
+ * keeps process-wide counters. AllocScope turns those into deltas for a
+ * block of code:
+ *
+ *   AllocScope scope;
+ *   module.handleStatus(request, response);
+ *   AllocStats used = scope.stats(); // count, bytes, peakLiveBytes
+ *
+ * Counting needs glibc (interposing malloc elsewhere is not portable);
+ * without it, or without the build flag, allocTrackingAvailable() is false
+ * and every scope reports zeros. The counters are not thread-safe, which
+ * matches the single-threaded test and native server environments.
+ *
+ * For Unity budgets see testing/alloc_assertions.h.
+ */
+
+struct AllocStats {
+  uint64_t count = 0;         // Allocations (realloc counts as one)
+  uint64_t bytes = 0;         // Bytes requested
+  uint64_t peakLiveBytes = 0; // Highest live heap above the starting level
+};
+
+// Whether allocations are actually being counted in this build
+bool allocTrackingAvailable();
+
+// Process-wide totals since start-up; peakLiveBytes is the all-time peak
+AllocStats allocTotals();
+
+// Bytes currently allocated (usable sizes, so slightly above requested)
+uint64_t allocLiveBytes();
+
+class AllocScope {
+public:
+  AllocScope();
+  ~AllocScope();
+
+  AllocScope(const AllocScope &) = delete;
+  AllocScope &operator=(const AllocScope &) = delete;
+
+  // Activity since construction (or since stop() was called)
+  AllocStats stats() const;
+
+  // Freeze the stats, e.g. before assertion code allocates
+  void stop();
+
+private:
+  uint64_t startCount;
+  uint64_t startBytes;
+  uint64_t startLive;
+  uint64_t outerPeak; // Peak to restore for an enclosing scope
+  bool stopped;
+  AllocStats frozen;
+};
+
+#endif // ALLOC_SCOPE_H
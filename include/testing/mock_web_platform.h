@@ -21,12 +21,13 @@
 // Use interfaces instead of mocks
 #include <interface/auth_types.h>
 #include <interface/openapi_types.h>
-// Note: platform interface is now in main web_platform_interface.h
+#include <interface/utils/json_document_pool.h>
 #include <interface/utils/route_variant.h>
 #include <interface/web_module_interface.h>
 #include <interface/web_module_types.h>
 #include <interface/web_request.h>
 #include <interface/web_response.h>
+#include <web_platform_interface.h>
 
 // Include string compatibility helpers
 #include "interface/string_compat.h"
@@ -34,22 +35,41 @@
 // Enhanced JsonResponseBuilder with native testing compatibility
 class JsonResponseBuilder {
 public:
+  // Builds through the installed platform's createJsonResponse(), so the
+  // platform's pool, statistics and overflow handling apply. Without a
+  // platform provider, the builder's own pool() is used. Size is kept for
+  // source compatibility; documents are sized by the pool.
   template <size_t Size>
   static void createResponse(WebResponse &res,
                              std::function<void(JsonObject &)> builder) {
-    // Create JSON document for testing
-    StaticJsonDocument<Size> doc;
-    JsonObject root = doc.template to<JsonObject>();
-
-    // Call the builder function to populate the JSON
-    builder(root);
+    if (IWebPlatformProvider::instance) {
+      IWebPlatformProvider::getPlatformInstance().createJsonResponse(res,
+                                                                     builder);
+      return;
+    }
+    sendPooled(res, pool().build<JsonObject>(
+                        JsonDocumentPool::routeKey(res.getBoundRequest()),
+                        builder));
+  }
 
-    // Use std::string for native compatibility with ArduinoJson
-    std::string jsonString = StringCompat::serializeJsonToStdString(doc);
+  // Fallback pool when no platform provider is installed; clear() it to
+  // release idle documents
+  static JsonDocumentPool &pool() {
+    static JsonDocumentPool fallback;
+    return fallback;
+  }
 
-    // Convert to Arduino String for WebResponse
-    String arduinoString = toArduinoString(jsonString);
-    res.setContent(arduinoString, "application/json");
+  // Send a pooled document. A response that overflowed even the pool's
+  // largest document would be silently truncated JSON; report it instead.
+  static void sendPooled(WebResponse &res,
+                         const JsonDocumentPool::Lease &lease) {
+    if (lease.overflowed()) {
+      res.setStatus(500);
+      res.setContent("{\"success\":false,\"error\":\"Response too large\"}",
+                     "application/json");
+      return;
+    }
+    res.setNegotiatedJsonContent(lease.document());
   }
 };
 
@@ -132,6 +152,33 @@ public:
 
   String getClientIp() const { return mockClientIp; }
 
+  // Non-allocating accessors matching WebRequest (views into the mock)
+  StringView pathView() const { return StringView(mockPath); }
+  StringView bodyView() const { return StringView(mockBody); }
+
+  StringView paramView(StringView name) const {
+    auto it = mockParams.find(std::string(name.data(), name.length()));
+    return it != mockParams.end()
+               ? StringView(it->second.c_str(), it->second.length())
+               : StringView();
+  }
+
+  StringView headerView(StringView name) const {
+    for (const auto &pair : mockHeaders) {
+      if (name.equalsIgnoreCase(
+              StringView(pair.first.c_str(), pair.first.length()))) {
+        return StringView(pair.second.c_str(), pair.second.length());
+      }
+    }
+    return StringView();
+  }
+
+  StringView headerView(HeaderId id) const {
+    return headerView(StringView(HttpHeaders::name(id)));
+  }
+
+  String getHeader(HeaderId id) const { return headerView(id).toString(); }
+
   String getJsonParam(const String &name) const {
     std::string stdName = name.c_str();
     return mockJsonParams.count(stdName) ? mockJsonParams.at(stdName)
@@ -186,6 +233,15 @@ public:
     mockContentType = ct;
   }
 
+  // Mock has no request to negotiate with: always the identity copy
+  void setProgmemContent(const ProgmemAsset &asset) {
+    mockContent = "";
+    for (size_t i = 0; i < asset.identityLength; i++) {
+      mockContent += static_cast<char>(asset.identity[i]);
+    }
+    mockContentType = asset.mimeType;
+  }
+
   void setStatus(int code) { mockStatusCode = code; }
 
   void setHeader(const String &name, const String &value) {
@@ -0,0 +1,59 @@
+#ifndef NATIVE_STORAGE_DRIVER_H
+#define NATIVE_STORAGE_DRIVER_H
+
+#include <interface/storage_driver.h>
+#include <string>
+#include <vector>
+
+/**
+ * NativeFileStorageDriver - IStorageDriver over a host directory
+ *
+ * Objects live at <root>/<collection>/<key>. Files are memory-mapped on
+ * open, so contiguousView() lets NativeWebPlatform write bodies straight
+ * from the page cache with sendmsg() instead of copying them into the
+ * response buffer. With useMmap = false the driver reads through pread()
+ * only, which is how a driver without addressable storage behaves.
+ *
+ * etag() hashes the file's inode, size and nanosecond modification time
+ * as of open(), so a replaced or rewritten file gets a new tag.
+ *
+ * Collection and key must be single path segments; "..", "/" and empty
+ * names are refused. Linux only (NATIVE_PLATFORM builds).
+ */
+class NativeFileStorageDriver : public IStorageDriver {
+public:
+  explicit NativeFileStorageDriver(const std::string &root,
+                                   bool useMmap = true);
+  ~NativeFileStorageDriver() override;
+
+  NativeFileStorageDriver(const NativeFileStorageDriver &) = delete;
+  NativeFileStorageDriver &operator=(const NativeFileStorageDriver &) = delete;
+
+  Handle open(const String &collection, const String &key) override;
+  size_t size(Handle handle) const override;
+  bool seek(Handle handle, size_t offset) override;
+  size_t read(Handle handle, uint8_t *buffer, size_t length) override;
+  void close(Handle handle) override;
+  const uint8_t *contiguousView(Handle handle) const override;
+  String etag(Handle handle) const override;
+
+  size_t openCount() const;
+
+private:
+  struct OpenFile {
+    int fd = -1;
+    const uint8_t *map = nullptr;
+    size_t size = 0;
+    size_t position = 0;
+    uint64_t version = 0; // Hash of inode, size and mtime at open()
+  };
+
+  OpenFile *find(Handle handle);
+  const OpenFile *find(Handle handle) const;
+
+  std::string root;
+  bool useMmap;
+  std::vector<OpenFile> files; // Indexed by handle; fd < 0 when free
+};
+
+#endif // NATIVE_STORAGE_DRIVER_H
@@ -0,0 +1,248 @@
+#ifndef NATIVE_WEB_PLATFORM_H
+#define NATIVE_WEB_PLATFORM_H
+
+#include "route_table.h"
+#include <interface/storage_driver.h>
+#include <interface/utils/json_document_pool.h>
+#include <atomic>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <web_platform_interface.h>
+
+/**
+ * NativeWebPlatform - Loopback HTTP/1.1 server for load-testing modules
+ *
+ * A host (Linux) IWebPlatform that serves registered modules over a real
+ * socket, so handler throughput and tail latency can be measured with
+ * wrk-style load generators. One thread, non-blocking sockets and a single
+ * epoll loop; keep-alive and pipelined requests are supported. Each request
+ * becomes a real WebRequest, is routed through the same RouteTable as
+ * MockWebPlatform, checked against the route's AuthRequirements and
+ * answered from the handler's WebResponse.
+ *
+ * Authentication is deliberately minimal: TOKEN accepts
+ * "Authorization: Bearer <token>" for tokens added with addApiToken(),
+ * SESSION a "session=<id>" cookie added with addSession(), PAGE_TOKEN an
+ * X-CSRF-Token added with addPageToken(); LOCAL_ONLY always passes since
+ * every client is on loopback. There is no TLS, so HTTPS-only routes are
+ * served over plain HTTP.
+ *
+ * GET routes declared with WebRoute::cached() are answered from a
+ * ResponseCache after authentication, without calling the handler.
+ *
+ * Text and JSON bodies are gzipped on the fly (GzipStream, chunked
+ * transfer) for routes declared with WebRoute::compressed() or under the
+ * policy given to setResponseCompression(). Cached responses are stored
+ * and sent uncompressed.
+ *
+ * With WEB_PLATFORM_OPENAPI, GET /openapi.json streams the spec of the
+ * registered API routes (OpenAPISpecWriter).
+ *
+ * createJsonResponse() builds in documents from a JsonDocumentPool sized by
+ * each route's past responses; one that overflows even the largest document
+ * is answered with 500 rather than truncated JSON.
+ *
+ * Storage streams are read through StorageDriverRegistry drivers, with
+ * Range support. When a driver offers contiguousView() the body is sent
+ * from that memory with sendmsg() (zero-copy from the server's side);
+ * pipelined requests behind it wait until it has been written.
+ *
+ * Static bodies get strong ETags and 304 answers without the handler's
+ * help: storage streams use the driver's etag(), and PROGMEM content
+ * without a build-time tag is hashed once per address, since flash data
+ * never changes.
+ *
+ * Linux only (NATIVE_PLATFORM builds); see the native_server environment
+ * in platformio.ini.
+ */
+class NativeWebPlatform : public IWebPlatform {
+public:
+  static const uint16_t DEFAULT_PORT = 8080;
+  static const size_t MAX_HEADER_BYTES = 16 * 1024;
+  static const size_t MAX_BODY_BYTES = 1024 * 1024;
+
+  // Port 0 picks a free port; see getPort()
+  explicit NativeWebPlatform(uint16_t port = DEFAULT_PORT);
+  ~NativeWebPlatform() override;
+
+  NativeWebPlatform(const NativeWebPlatform &) = delete;
+  NativeWebPlatform &operator=(const NativeWebPlatform &) = delete;
+
+  // Start listening on 127.0.0.1. httpsOnly is ignored (no TLS).
+  void begin(const String &name) override;
+  void begin(const String &name, bool httpsOnly) override { begin(name); }
+  // Process pending socket events without blocking, then module handle()
+  void handle() override;
+
+  bool isConnected() const override { return listenFd >= 0; }
+  bool isHttpsEnabled() const override { return false; }
+  String getBaseUrl() const override;
+
+  void registerModule(const String &basePath, IWebModule *module) override;
+  void registerWebRoute(const String &path,
+                        WebModule::UnifiedRouteHandler handler,
+                        const AuthRequirements &auth,
+                        WebModule::Method method) override;
+  void registerApiRoute(const String &path,
+                        WebModule::UnifiedRouteHandler handler,
+                        const AuthRequirements &auth, WebModule::Method method,
+                        const OpenAPIDocumentation &docs) override;
+
+  size_t getRouteCount() const override { return routeTable.size(); }
+  void disableRoute(const String &path, WebModule::Method method) override {
+    routeTable.remove(path, method);
+  }
+
+  String getDeviceName() const override { return deviceName; }
+  void setErrorPage(int statusCode, const String &html) override {
+    errorPages[statusCode] = html;
+  }
+  void addGlobalRedirect(const String &fromPath,
+                         const String &toPath) override {
+    redirects[fromPath] = toPath;
+  }
+  void invalidateResponseCache(const String &pathPrefix) override {
+    responseCache.invalidate(pathPrefix);
+  }
+  void invalidateResponseCache(IWebModule *module,
+                               const String &routePath) override;
+  void
+  setResponseCompression(const ResponseCompressionPolicy &policy) override {
+    responseCompression = policy;
+  }
+
+  void createJsonResponse(WebResponse &res,
+                          std::function<void(JsonObject &)> builder) override;
+  void
+  createJsonArrayResponse(WebResponse &res,
+                          std::function<void(JsonArray &)> builder) override;
+
+  // Serve until stop() is called (safe from a signal handler)
+  void run();
+  void stop() { running = false; }
+
+  // Wait up to timeoutMs for socket activity and process it. Returns false
+  // when the server is not listening.
+  bool poll(int timeoutMs);
+
+  uint16_t getPort() const { return port; }
+  uint64_t getRequestCount() const { return requestCount; }
+  const ResponseCache &getResponseCache() const { return responseCache; }
+  const JsonDocumentPool &getJsonDocumentPool() const { return jsonPool; }
+
+  // OpenAPI document for the registered API routes; served at
+  // OpenAPISpecWriter::SPEC_PATH unless a route claims that path
+  bool writeOpenApiSpec(JsonStreamWriter &writer) const;
+
+  // Credentials accepted by the built-in authentication
+  void addApiToken(const String &token, const String &username = "api");
+  void addSession(const String &sessionId, const String &username);
+  void addPageToken(const String &token);
+
+  // Serve one complete raw request without a socket; returns the response
+  // bytes. keepAlive reports whether the connection may be reused. HEAD
+  // gets the GET headers without the body; methods no route can declare
+  // (OPTIONS, unknown tokens) get 501.
+  std::string handleRawRequest(const char *rawRequest, size_t length,
+                               bool &keepAlive,
+                               const String &clientIp = "127.0.0.1");
+
+private:
+  // Storage object sent from the driver's contiguous view after the
+  // connection's buffered output; the handle stays open until then
+  struct StorageBody {
+    IStorageDriver *driver = nullptr;
+    IStorageDriver::Handle handle = IStorageDriver::INVALID_HANDLE;
+    const uint8_t *data = nullptr;
+    size_t length = 0;
+    size_t sent = 0;
+
+    bool pending() const { return driver != nullptr; }
+    void release() {
+      if (driver) {
+        driver->close(handle);
+      }
+      *this = StorageBody();
+    }
+  };
+
+  struct Connection {
+    std::string input;
+    std::string output;
+    size_t outputSent = 0;
+    StorageBody body;
+    String clientIp;
+    bool closeAfterWrite = false;
+    bool wantWrite = false; // Registered for EPOLLOUT
+  };
+
+  struct Credential {
+    String secret;
+    String username;
+  };
+
+  void addRoute(const RouteTable::Route &route);
+  void acceptConnections();
+  void readFrom(int fd, Connection &connection);
+  void writeTo(int fd, Connection &connection);
+  void closeConnection(int fd);
+  void processInput(Connection &connection);
+
+  // Append the response to `out`. Storage bodies with a contiguous view
+  // are handed to `body` instead of copied when it is non-null.
+  void respond(const char *rawRequest, size_t length, bool &keepAlive,
+               const String &clientIp, std::string &out, StorageBody *body);
+  // Fills `response`, or returns the cached entry to send instead.
+  // `compression` receives the matched route's policy.
+  const ResponseCache::Entry *dispatch(WebRequest &request,
+                                       WebResponse &response,
+                                       ResponseCompressionPolicy &compression);
+  void storeInCache(const String &key, const ResponseCachePolicy &policy,
+                    const WebResponse &response);
+  void tagProgmemContent(WebResponse &response);
+  bool authorize(const AuthRequirements &auth, WebRequest &request) const;
+  void setPooledJson(WebResponse &res,
+                     const JsonDocumentPool::Lease &lease) const;
+  void sendError(WebResponse &response, int statusCode,
+                 const char *message) const;
+  static void serialize(const WebResponse &response, bool keepAlive,
+                        std::string &out);
+  // Clears keepAlive when the driver delivers fewer bytes than promised
+  void serializeStorage(WebResponse &response, bool &keepAlive,
+                        std::string &out, StorageBody *body) const;
+  static bool compressible(const WebRequest &request,
+                           const WebResponse &response,
+                           const ResponseCompressionPolicy &policy);
+  static void serializeCompressed(const WebResponse &response,
+                                  bool keepAlive,
+                                  const ResponseCompressionPolicy &policy,
+                                  std::string &out);
+  static void serialize(const ResponseCache::Entry &entry,
+                        const WebRequest &request, bool keepAlive,
+                        std::string &out);
+
+  uint16_t port;
+  int listenFd;
+  int epollFd;
+  std::atomic<bool> running;
+  uint64_t requestCount;
+  String deviceName;
+  RouteTable routeTable;
+  ResponseCache responseCache;
+  JsonDocumentPool jsonPool;
+  ResponseCompressionPolicy responseCompression;
+  std::vector<std::pair<String, IWebModule *>> modules; // Base path, module
+  // Strong tags of PROGMEM bodies by address, computed on first send
+  std::unordered_map<const char *, String> progmemETags;
+  std::unordered_map<int, Connection> connections;
+  std::map<int, String> errorPages;
+  std::map<String, String> redirects;
+  std::vector<Credential> apiTokens;
+  std::vector<Credential> sessions;
+  std::vector<String> pageTokens;
+};
+
+#endif // NATIVE_WEB_PLATFORM_H
@@ -0,0 +1,202 @@
+#ifndef ROUTE_TABLE_H
+#define ROUTE_TABLE_H
+
+#include <interface/auth_types.h>
+#include <interface/openapi_spec_writer.h>
+#include <interface/string_compat.h>
+#include <interface/unified_types.h>
+#include <interface/utils/route_trie.h>
+#include <interface/utils/request_validator.h>
+#include <interface/utils/route_variant.h>
+#include <interface/utils/string_view.h>
+#include <memory>
+#include <vector>
+
+/**
+ * RouteTable - Registered routes resolved through a RouteTrie
+ *
+ * Shared by the host-side platforms (MockWebPlatform, NativeWebPlatform)
+ * so they normalize module and /api paths the way the real WebPlatform
+ * does and resolve requests with the same precedence rules.
+ */
+class RouteTable {
+public:
+  struct Route {
+    String path; // Full path including module base path and /api prefix
+    WebModule::Method method;
+    WebModule::UnifiedRouteHandler handler;
+    AuthRequirements auth;
+    bool isApiRoute;
+    ResponseCachePolicy cachePolicy = ResponseCachePolicy();
+    ResponseCompressionPolicy compressionPolicy = ResponseCompressionPolicy();
+    OpenAPIDocumentation docs = OpenAPIDocumentation(); // API routes only
+    bool removed = false; // Disabled with remove(); kept for stable ids
+    RequestValidationPolicy validation = RequestValidationPolicy();
+    // Compiled by add() when validation is enabled; shared by copies
+    std::shared_ptr<const RequestValidator> validator = nullptr;
+  };
+
+  // Returns false when the pattern is malformed or the route's validation
+  // schema does not compile. A route for the same pattern and method
+  // replaces the earlier one.
+  bool add(const Route &route) {
+    std::shared_ptr<const RequestValidator> validator = route.validator;
+    if (route.validation.enabled && !validator) {
+      validator = compileValidator(route);
+      if (!validator) {
+        return false;
+      }
+    }
+    routes.push_back(route);
+    routes.back().validator = validator;
+    if (!routeTrie.insert(route.path, route.method,
+                          static_cast<int>(routes.size() - 1))) {
+      routes.pop_back();
+      return false;
+    }
+    for (size_t i = 0; i + 1 < routes.size(); i++) {
+      if (routes[i].method == route.method && routes[i].path == route.path) {
+        routes[i].removed = true;
+      }
+    }
+    return true;
+  }
+
+  // Route registered by a module mounted at `basePath`
+  static Route moduleRoute(const String &basePath,
+                           const RouteVariant &variant) {
+    if (variant.isApiRoute()) {
+      const WebRoute &route = variant.getApiRoute().webRoute;
+      return Route{apiPath(joinPath(basePath, route.path)),
+                   route.method,
+                   route.unifiedHandler,
+                   route.authRequirements,
+                   true,
+                   route.cachePolicy,
+                   route.compressionPolicy,
+                   variant.getApiRoute().docs,
+                   false,
+                   variant.getApiRoute().validation};
+    }
+    const WebRoute &route = variant.getWebRoute();
+    return Route{joinPath(basePath, route.path), route.method,
+                 route.unifiedHandler, route.authRequirements, false,
+                 route.cachePolicy, route.compressionPolicy};
+  }
+
+  // nullptr when no route matches; params in `match` point into `path`
+  const Route *find(const char *path, size_t length, WebModule::Method method,
+                    RouteTrie::Match &match) const {
+    if (!routeTrie.match(path, length, method, match)) {
+      return nullptr;
+    }
+    return &routes[match.routeId];
+  }
+
+  // Removes `path` or, failing that, its /api form
+  bool remove(const String &path, WebModule::Method method) {
+    String removedPath = path;
+    if (!routeTrie.remove(removedPath, method)) {
+      removedPath = apiPath(path);
+      if (!routeTrie.remove(removedPath, method)) {
+        return false;
+      }
+    }
+    for (Route &route : routes) {
+      if (!route.removed && route.method == method &&
+          route.path == removedPath) {
+        route.removed = true;
+      }
+    }
+    return true;
+  }
+
+  // The live API routes, for OpenAPISpecWriter::write(). Entries point into
+  // the table and stay valid until the next add().
+  void openApiOperations(
+      std::vector<OpenAPISpecWriter::Operation> &operations) const {
+    for (const Route &route : routes) {
+      if (route.isApiRoute && !route.removed) {
+        operations.push_back(OpenAPISpecWriter::Operation{
+            route.path.c_str(), route.method, route.auth, &route.docs});
+      }
+    }
+  }
+
+  size_t size() const { return routeTrie.size(); }
+
+  // Whether `prefix` names a live route's path or a path above one, as
+  // ResponseCache::invalidate() prefixes must. "{param}" segments match any
+  // value, so "/api/items/42" is under "/api/items/{id}".
+  bool hasPathUnder(StringView prefix) const {
+    for (const Route &route : routes) {
+      if (!route.removed && patternCovers(route.path, prefix)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // API routes live under /api; ApiRoute paths are already normalized
+  static String apiPath(const String &path) {
+    if (path.startsWith("/api/") || path.equals("/api")) {
+      return path;
+    }
+    return path.startsWith("/") ? "/api" + path : "/api/" + path;
+  }
+
+  static String joinPath(const String &basePath, const String &path) {
+    String base = basePath;
+    if (base.endsWith("/")) {
+      base = base.substring(0, base.length() - 1);
+    }
+    if (path.equals("/") || StringUtils::isStringEmpty(path)) {
+      return StringUtils::isStringEmpty(base) ? String("/") : base;
+    }
+    return path.startsWith("/") ? base + path : base + "/" + path;
+  }
+
+private:
+  static bool patternCovers(StringView pattern, StringView prefix) {
+    size_t p = 0;
+    size_t q = 0;
+    while (q < prefix.length()) {
+      if (p >= pattern.length()) {
+        return false;
+      }
+      size_t patternEnd = pattern.find('/', p);
+      patternEnd = patternEnd == StringView::npos ? pattern.length()
+                                                  : patternEnd;
+      size_t prefixEnd = prefix.find('/', q);
+      prefixEnd = prefixEnd == StringView::npos ? prefix.length() : prefixEnd;
+      StringView segment = pattern.substr(p, patternEnd - p);
+      if (segment == "*") {
+        return true;
+      }
+      bool param = segment.length() > 1 && segment[0] == '{';
+      if (!param && segment != prefix.substr(q, prefixEnd - q)) {
+        return false;
+      }
+      p = patternEnd + 1;
+      q = prefixEnd + 1;
+    }
+    return true;
+  }
+
+  static std::shared_ptr<const RequestValidator>
+  compileValidator(const Route &route) {
+    const char *schema = route.validation.schema
+                             ? route.validation.schema
+                             : route.docs.text(OpenAPIField::REQUEST_SCHEMA);
+    std::shared_ptr<RequestValidator> validator(new RequestValidator());
+    if (!validator->compile(schema)) {
+      return nullptr;
+    }
+    return validator;
+  }
+
+  std::vector<Route> routes;
+  RouteTrie routeTrie;
+};
+
+#endif // ROUTE_TABLE_H
@@ -2,6 +2,8 @@
 #define TESTING_PLATFORM_PROVIDER_H
 
 #include "mock_web_platform.h"
+#include "route_table.h"
+#include <interface/utils/json_document_pool.h>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -11,12 +13,21 @@
  * Single canonical mock platform
  */
 class MockWebPlatform : public IWebPlatform {
+public:
+  // Route as resolved by the mock router
+  typedef RouteTable::Route RegisteredRoute;
+
 private:
   String deviceName;
   bool connected = true;
   bool httpsEnabled = true;
   std::vector<std::pair<String, IWebModule *>> registeredModules;
   int routeCount = 0;
+  RouteTable routeTable;
+  String lastMatchedPath;
+  std::vector<String> cacheInvalidations;
+  ResponseCompressionPolicy responseCompression;
+  JsonDocumentPool jsonPool;
 
   // Callback functions for testing
   std::function<void(const String &)> warnCallback = [](const String &) {};
@@ -53,9 +64,13 @@ public:
     // Add routes from module to mock route count (handle null modules
     // gracefully)
     if (module) {
-      auto httpRoutes = module->getHttpRoutes();
-      auto httpsRoutes = module->getHttpsRoutes();
-      routeCount += httpRoutes.size() + httpsRoutes.size();
+      IWebModule::RouteVisitor visitor =
+          [this, &basePath](const RouteVariant &route) {
+            addModuleRoute(basePath, route);
+            routeCount++;
+          };
+      module->forEachRoute(visitor, WebModule::TRANSPORT_HTTP);
+      module->forEachRoute(visitor, WebModule::TRANSPORT_HTTPS);
     }
   }
 
@@ -70,6 +85,7 @@ public:
           "' starts with '/api/' or 'api/'. Consider using registerApiRoute() "
           "instead for better API documentation and path normalization.");
     }
+    addRoute(path, method, handler, auth, false);
     routeCount++;
   }
 
@@ -77,16 +93,67 @@ public:
                         WebModule::UnifiedRouteHandler handler,
                         const AuthRequirements &auth, WebModule::Method method,
                         const OpenAPIDocumentation &docs) override {
+    RegisteredRoute route{RouteTable::apiPath(path), method, handler, auth,
+                          true};
+    route.docs = docs;
+    addRoute(route);
     routeCount++;
   }
 
   size_t getRouteCount() const override { return routeCount; }
 
   void disableRoute(const String &path, WebModule::Method method) override {
+    routeTable.remove(path, method);
     if (routeCount > 0)
       routeCount--;
   }
 
+  // Warns about prefixes no registered route lies under; most often a
+  // module-relative path instead of the mounted one
+  void invalidateResponseCache(const String &pathPrefix) override {
+    cacheInvalidations.push_back(pathPrefix);
+    if (!StringUtils::isStringEmpty(pathPrefix) &&
+        !routeTable.hasPathUnder(pathPrefix)) {
+      warnCallback("WARNING: invalidateResponseCache() prefix '" +
+                   pathPrefix +
+                   "' matches no registered route; pass the mounted path, "
+                   "e.g. /api/<base path>/<route>, or the module and its "
+                   "route path");
+    }
+  }
+
+  // Records the mounted prefixes routePath resolves to for each base path
+  // the module was registered at, keeping the WebRoute and /api forms that
+  // lie above a registered route; warns when neither does
+  void invalidateResponseCache(IWebModule *module,
+                               const String &routePath) override {
+    bool matched = false;
+    for (const auto &modulePair : registeredModules) {
+      if (modulePair.second != module) {
+        continue;
+      }
+      String path = RouteTable::joinPath(modulePair.first, routePath);
+      String apiPath = RouteTable::apiPath(path);
+      if (routeTable.hasPathUnder(path)) {
+        cacheInvalidations.push_back(path);
+        matched = true;
+      }
+      if (apiPath != path && routeTable.hasPathUnder(apiPath)) {
+        cacheInvalidations.push_back(apiPath);
+        matched = true;
+      }
+    }
+    if (!matched) {
+      warnCallback("WARNING: invalidateResponseCache() route '" + routePath +
+                   "' matches no route of a registered module");
+    }
+  }
+
+  void
+  setResponseCompression(const ResponseCompressionPolicy &policy) override {
+    responseCompression = policy;
+  }
+
   String getDeviceName() const override { return deviceName; }
 
   void setErrorPage(int statusCode, const String &html) override {
@@ -100,35 +167,48 @@ public:
 
   void createJsonResponse(WebResponse &res,
                           std::function<void(JsonObject &)> builder) override {
-    // Create a document and call the builder
-    StaticJsonDocument<512> doc;
-    JsonObject root = doc.to<JsonObject>();
-    builder(root);
-
-    // Serialize to string
-    std::string jsonString = StringCompat::serializeJsonToStdString(doc);
-
-    // Set content
-    res.setContent(toArduinoString(jsonString), "application/json");
+    StringView route = JsonDocumentPool::routeKey(res.getBoundRequest());
+    setPooledJson(res, jsonPool.build<JsonObject>(route, builder));
   }
 
   void
   createJsonArrayResponse(WebResponse &res,
                           std::function<void(JsonArray &)> builder) override {
-    // Create a document and call the builder
-    StaticJsonDocument<512> doc;
-    JsonArray root = doc.to<JsonArray>();
-    builder(root);
-
-    // Serialize to string
-    std::string jsonString = StringCompat::serializeJsonToStdString(doc);
+    StringView route = JsonDocumentPool::routeKey(res.getBoundRequest());
+    setPooledJson(res, jsonPool.build<JsonArray>(route, builder));
+  }
 
-    // Set content
-    res.setContent(toArduinoString(jsonString), "application/json");
+  // Resolve a request path the way the real platform router does. Returns
+  // nullptr when no route matches. The path is copied so params in match
+  // stay valid until the next findRoute() call.
+  const RegisteredRoute *findRoute(const String &path,
+                                   WebModule::Method method,
+                                   RouteTrie::Match &match) {
+    lastMatchedPath = path;
+    return routeTable.find(lastMatchedPath.c_str(), lastMatchedPath.length(),
+                           method, match);
   }
 
   // Test utility methods
   void setConnected(bool conn) { connected = conn; }
+  // Prefixes passed to invalidateResponseCache(), oldest first
+  const std::vector<String> &getCacheInvalidations() const {
+    return cacheInvalidations;
+  }
+  // OpenAPI document for the recorded API routes, as the device would serve
+  // it; used by tools/openapi_extract to embed the spec at build time
+  bool writeOpenApiSpec(JsonStreamWriter &writer,
+                        const OpenAPISpecWriter::Info &info) const {
+    std::vector<OpenAPISpecWriter::Operation> operations;
+    routeTable.openApiOperations(operations);
+    return OpenAPISpecWriter::write(writer, info, operations);
+  }
+  // Documents behind createJsonResponse()/createJsonArrayResponse()
+  const JsonDocumentPool &getJsonDocumentPool() const { return jsonPool; }
+  // Last policy passed to setResponseCompression()
+  const ResponseCompressionPolicy &getResponseCompression() const {
+    return responseCompression;
+  }
   int getRegisteredModuleCount() const { return registeredModules.size(); }
   std::vector<std::pair<String, IWebModule *>> getRegisteredModules() const {
     return registeredModules;
@@ -146,6 +226,29 @@ public:
   void onDebug(std::function<void(const String &)> callback) {
     debugCallback = callback;
   }
+
+private:
+  void addRoute(const String &path, WebModule::Method method,
+                WebModule::UnifiedRouteHandler handler,
+                const AuthRequirements &auth, bool isApiRoute) {
+    addRoute(RegisteredRoute{path, method, handler, auth, isApiRoute});
+  }
+
+  void addRoute(const RegisteredRoute &route) {
+    if (!routeTable.add(route)) {
+      warnCallback("WARNING: Route '" + route.path +
+                   "' is malformed or its request schema does not compile");
+    }
+  }
+
+  void addModuleRoute(const String &basePath, const RouteVariant &variant) {
+    addRoute(RouteTable::moduleRoute(basePath, variant));
+  }
+
+  static void setPooledJson(WebResponse &res,
+                            const JsonDocumentPool::Lease &lease) {
+    JsonResponseBuilder::sendPooled(res, lease);
+  }
 };
 
 /**
@@ -9,7 +9,9 @@
 #include <functional>
 #include <interface/auth_types.h>
 #include <interface/openapi_factory.h>
+#include <interface/openapi_spec_writer.h>
 #include <interface/openapi_types.h>
+#include <interface/storage_driver.h>
 #include <interface/unified_types.h>
 #include <interface/utils/route_variant.h>
 #include <interface/web_module_interface.h>
@@ -71,6 +73,28 @@ public:
   virtual void addGlobalRedirect(const String &fromPath,
                                  const String &toPath) = 0;
 
+  // Response cache: drop cached GET responses (routes opt in with
+  // WebRoute::cached()) for pathPrefix and the paths below it. Modules call
+  // this when the state behind a cached route changes; an empty prefix
+  // clears the whole cache. Platforms without a cache ignore it.
+  // pathPrefix is the mounted request path, not the module-relative route
+  // path: "/api/<base path>/items" for an ApiRoute("/items") of a module
+  // registered at <base path>, "<base path>/items" for a WebRoute.
+  virtual void invalidateResponseCache(const String &pathPrefix = "") {}
+
+  // Module-scoped form: routePath is the path the module declared, resolved
+  // against the base path it was registered at for both its WebRoutes and
+  // ApiRoutes; empty covers all of the module's routes. From a module:
+  //   platform.invalidateResponseCache(this, "/readings");
+  virtual void invalidateResponseCache(IWebModule *module,
+                                       const String &routePath = "") {}
+
+  // Gzip qualifying responses on the fly for every route without its own
+  // WebRoute::compressed() policy, e.g. {10, 8, 2048, "application/json"}.
+  // A default policy turns it off. Platforms without compression ignore it.
+  virtual void
+  setResponseCompression(const ResponseCompressionPolicy &policy) {}
+
   // JSON response utilities
   virtual void
   createJsonResponse(WebResponse &res,
@@ -0,0 +1,182 @@
+#include <interface/openapi_components.h>
+#include <string>
+
+namespace {
+
+const char *baseName(OpenAPIComponents::Kind kind) {
+  switch (kind) {
+  case OpenAPIComponents::Kind::SUCCESS_RESPONSE:
+    return "SuccessResponse";
+  case OpenAPIComponents::Kind::ERROR_RESPONSE:
+    return "ErrorResponse";
+  case OpenAPIComponents::Kind::LIST_RESPONSE:
+    return "ListResponse";
+  default:
+    return "IdParameter";
+  }
+}
+
+bool isParameter(OpenAPIComponents::Kind kind) {
+  return kind == OpenAPIComponents::Kind::ID_PARAMETER;
+}
+
+void writeResultProperty(JsonStreamWriter &writer, bool example) {
+  writer.key("success")
+      .beginObject()
+      .member("type", "boolean")
+      .member("description", "Whether the operation was successful")
+      .member("example", example)
+      .endObject();
+}
+
+void writeStringProperty(JsonStreamWriter &writer, const char *name,
+                         const String &description, const char *example) {
+  writer.key(name)
+      .beginObject()
+      .member("type", "string")
+      .member("description", description)
+      .member("example", example)
+      .endObject();
+}
+
+} // namespace
+
+OpenAPIComponents &OpenAPIComponents::shared() {
+  static OpenAPIComponents registry;
+  return registry;
+}
+
+const OpenAPIComponents::Component &
+OpenAPIComponents::intern(Kind kind, const String &description,
+                          const String &parameter) {
+  size_t sameKind = 0;
+  for (const auto &component : components) {
+    if (component->kind != kind) {
+      continue;
+    }
+    if (component->description == description &&
+        component->parameter == parameter) {
+      return *component;
+    }
+    sameKind++;
+  }
+
+  // The first variant of a kind gets the plain name, later ones a number
+  std::unique_ptr<Component> component(new Component());
+  component->kind = kind;
+  component->name = baseName(kind);
+  if (sameKind > 0) {
+    component->name += String(static_cast<unsigned long>(sameKind + 1));
+  }
+  component->description = description;
+  component->parameter = parameter;
+  component->ref = String("{\"$ref\":\"#/components/") +
+                   (isParameter(kind) ? "parameters/" : "schemas/") +
+                   component->name + "\"}";
+  components.push_back(std::move(component));
+  return *components.back();
+}
+
+std::shared_ptr<const OpenAPIComponents::Component>
+OpenAPIComponents::standalone(Kind kind, const String &description,
+                              const String &parameter) {
+  std::shared_ptr<Component> component(new Component());
+  component->kind = kind;
+  component->name = baseName(kind);
+  component->description = description;
+  component->parameter = parameter;
+  return component;
+}
+
+void OpenAPIComponents::write(JsonStreamWriter &writer) const {
+  writeSection(writer, "schemas", false);
+  writeSection(writer, "parameters", true);
+}
+
+void OpenAPIComponents::writeSection(JsonStreamWriter &writer,
+                                     const char *section,
+                                     bool parameters) const {
+  bool open = false;
+  for (const auto &component : components) {
+    if (isParameter(component->kind) != parameters) {
+      continue;
+    }
+    if (!open) {
+      writer.key(section).beginObject();
+      open = true;
+    }
+    writer.key(component->name);
+    writeDefinition(writer, *component);
+  }
+  if (open) {
+    writer.endObject();
+  }
+}
+
+void OpenAPIComponents::writeDefinition(JsonStreamWriter &writer,
+                                        const Component &component) {
+  writer.beginObject();
+  switch (component.kind) {
+  case Kind::SUCCESS_RESPONSE:
+    writer.member("type", "object").key("properties").beginObject();
+    writeResultProperty(writer, true);
+    writeStringProperty(writer, "message", component.description,
+                        "Operation successful");
+    writer.endObject();
+    writer.key("required").beginArray().value("success").endArray();
+    break;
+  case Kind::ERROR_RESPONSE:
+    writer.member("type", "object").key("properties").beginObject();
+    writeResultProperty(writer, false);
+    writeStringProperty(writer, "error", component.description,
+                        "Operation failed");
+    writer.endObject();
+    writer.key("required")
+        .beginArray()
+        .value("success")
+        .value("error")
+        .endArray();
+    break;
+  case Kind::LIST_RESPONSE:
+    writer.member("type", "object").key("properties").beginObject();
+    writer.key("items")
+        .beginObject()
+        .member("type", "array")
+        .key("items")
+        .beginObject()
+        .endObject()
+        .member("description", component.description)
+        .endObject();
+    writer.key("total")
+        .beginObject()
+        .member("type", "integer")
+        .member("description", "Total number of items")
+        .endObject();
+    writer.endObject();
+    writer.key("required").beginArray().value("items").value("total");
+    writer.endArray();
+    break;
+  case Kind::ID_PARAMETER:
+    writer.member("name", component.parameter)
+        .member("in", "path")
+        .member("required", true);
+    writer.key("schema").beginObject().member("type", "string").endObject();
+    writer.member("description", component.description);
+    break;
+  }
+  writer.endObject();
+}
+
+String OpenAPISchemaRef::toString() const {
+  if (!component) {
+    return String();
+  }
+  std::string json;
+  JsonStreamWriter writer([&json](const char *data, size_t length) {
+    json.append(data, length);
+    return true;
+  });
+  OpenAPIComponents::writeDefinition(writer, *component);
+  writer.flush();
+  return String(json.c_str());
+}
@@ -0,0 +1,261 @@
+#include <algorithm>
+#include <interface/openapi_spec_writer.h>
+#include <string.h>
+
+namespace {
+
+const char *const OPENAPI_VERSION = "3.0.3";
+const char *const JSON_MIME_TYPE = "application/json";
+
+StringView trimStart(StringView json) {
+  size_t start = 0;
+  while (start < json.length() &&
+         (json[start] == ' ' || json[start] == '\n' || json[start] == '\r' ||
+          json[start] == '\t')) {
+    start++;
+  }
+  return json.substr(start);
+}
+
+// Whether the JSON object text has `key` as a direct member. A lexical scan,
+// without parsing: strings are skipped and only depth-1 keys compared.
+bool hasTopLevelKey(StringView json, StringView key) {
+  int depth = 0;
+  bool expectKey = false;
+  for (size_t i = 0; i < json.length(); i++) {
+    char c = json[i];
+    if (c == '"') {
+      size_t end = i + 1;
+      while (end < json.length() && json[end] != '"') {
+        end += json[end] == '\\' ? 2 : 1;
+      }
+      if (depth == 1 && expectKey &&
+          json.substr(i + 1, end - i - 1) == key) {
+        return true;
+      }
+      expectKey = false;
+      i = end;
+    } else if (c == '{' || c == '[') {
+      depth++;
+      expectKey = c == '{' && depth == 1;
+    } else if (c == '}' || c == ']') {
+      depth--;
+    } else if (c == ',' && depth == 1) {
+      expectKey = true;
+    }
+  }
+  return false;
+}
+
+void writePathParameters(JsonStreamWriter &writer, StringView path) {
+  writer.key("parameters").beginArray();
+  size_t pos = 0;
+  while ((pos = path.find('{', pos)) != StringView::npos) {
+    size_t end = path.find('}', pos);
+    if (end == StringView::npos) {
+      break;
+    }
+    writer.beginObject()
+        .member("name", path.substr(pos + 1, end - pos - 1))
+        .member("in", "path")
+        .member("required", true);
+    writer.key("schema").beginObject().member("type", "string").endObject();
+    writer.endObject();
+    pos = end + 1;
+  }
+  writer.endArray();
+}
+
+void writeJsonContent(JsonStreamWriter &writer, const char *schema,
+                      const char *example) {
+  writer.key("content").beginObject().key(JSON_MIME_TYPE).beginObject();
+  if (*schema) {
+    writer.key("schema").compactValue(schema);
+  }
+  if (*example) {
+    writer.key("example").compactValue(example);
+  }
+  writer.endObject().endObject();
+}
+
+void writeSecurity(JsonStreamWriter &writer, const AuthRequirements &auth) {
+  if (auth.has(AuthType::NONE) ||
+      !(auth.has(AuthType::TOKEN) || auth.has(AuthType::SESSION) ||
+        auth.has(AuthType::PAGE_TOKEN))) {
+    return;
+  }
+  writer.key("security").beginArray();
+  if (auth.has(AuthType::TOKEN)) {
+    writer.beginObject().key("bearerAuth").beginArray().endArray().endObject();
+  }
+  if (auth.has(AuthType::SESSION)) {
+    writer.beginObject().key("cookieAuth").beginArray().endArray().endObject();
+  }
+  if (auth.has(AuthType::PAGE_TOKEN)) {
+    writer.beginObject().key("csrfToken").beginArray().endArray().endObject();
+  }
+  writer.endArray();
+}
+
+void writeSecuritySchemes(JsonStreamWriter &writer) {
+  writer.key("securitySchemes").beginObject();
+  writer.key("bearerAuth")
+      .beginObject()
+      .member("type", "http")
+      .member("scheme", "bearer")
+      .endObject();
+  writer.key("cookieAuth")
+      .beginObject()
+      .member("type", "apiKey")
+      .member("in", "cookie")
+      .member("name", "session")
+      .endObject();
+  writer.key("csrfToken")
+      .beginObject()
+      .member("type", "apiKey")
+      .member("in", "header")
+      .member("name", "X-CSRF-Token")
+      .endObject();
+  writer.endObject();
+}
+
+bool operationBefore(const OpenAPISpecWriter::Operation &a,
+                     const OpenAPISpecWriter::Operation &b) {
+  int order = strcmp(a.path, b.path);
+  return order != 0 ? order < 0 : a.method < b.method;
+}
+
+} // namespace
+
+const char *OpenAPISpecWriter::methodName(WebModule::Method method) {
+  switch (method) {
+  case WebModule::WM_POST:
+    return "post";
+  case WebModule::WM_PUT:
+    return "put";
+  case WebModule::WM_DELETE:
+    return "delete";
+  case WebModule::WM_PATCH:
+    return "patch";
+  default:
+    return "get";
+  }
+}
+
+void OpenAPISpecWriter::writeOperation(JsonStreamWriter &writer,
+                                       const Operation &operation) {
+  static const OpenAPIDocumentation EMPTY_DOCS;
+  const OpenAPIDocumentation &docs =
+      operation.docs ? *operation.docs : EMPTY_DOCS;
+
+  writer.beginObject();
+  if (docs.has(OpenAPIField::SUMMARY)) {
+    writer.member("summary", docs.text(OpenAPIField::SUMMARY));
+  }
+  if (docs.has(OpenAPIField::DESCRIPTION)) {
+    writer.member("description", docs.text(OpenAPIField::DESCRIPTION));
+  }
+  if (docs.has(OpenAPIField::OPERATION_ID)) {
+    writer.member("operationId", docs.text(OpenAPIField::OPERATION_ID));
+  }
+  if (docs.has(OpenAPIField::TAGS)) {
+    writer.key("tags").beginArray();
+    StringView tags(docs.text(OpenAPIField::TAGS));
+    size_t pos = 0;
+    while (pos <= tags.length()) {
+      size_t end = tags.find(',', pos);
+      if (end == StringView::npos) {
+        end = tags.length();
+      }
+      writer.value(tags.substr(pos, end - pos));
+      pos = end + 1;
+    }
+    writer.endArray();
+  }
+
+  if (docs.has(OpenAPIField::PARAMETERS)) {
+    StringView parameters = trimStart(docs.text(OpenAPIField::PARAMETERS));
+    writer.key("parameters");
+    if (!parameters.empty() && parameters[0] == '[') {
+      writer.compactValue(parameters);
+    } else {
+      writer.beginArray().compactValue(parameters).endArray();
+    }
+  } else if (strchr(operation.path, '{')) {
+    writePathParameters(writer, operation.path);
+  }
+
+  if (docs.has(OpenAPIField::REQUEST_SCHEMA)) {
+    StringView body(docs.text(OpenAPIField::REQUEST_SCHEMA));
+    writer.key("requestBody");
+    if (hasTopLevelKey(body, "content")) {
+      writer.compactValue(body);
+    } else {
+      writer.beginObject().member("required", true);
+      writeJsonContent(writer, docs.text(OpenAPIField::REQUEST_SCHEMA),
+                       docs.text(OpenAPIField::REQUEST_EXAMPLE));
+      writer.endObject();
+    }
+  }
+
+  writer.key("responses");
+  if (docs.has(OpenAPIField::RESPONSES)) {
+    writer.compactValue(docs.text(OpenAPIField::RESPONSES));
+  } else {
+    writer.beginObject().key("200").beginObject();
+    writer.member("description", "Successful response");
+    if (docs.has(OpenAPIField::RESPONSE_SCHEMA) ||
+        docs.has(OpenAPIField::RESPONSE_EXAMPLE)) {
+      writeJsonContent(writer, docs.text(OpenAPIField::RESPONSE_SCHEMA),
+                       docs.text(OpenAPIField::RESPONSE_EXAMPLE));
+    }
+    writer.endObject().endObject();
+  }
+
+  writeSecurity(writer, operation.auth);
+  writer.endObject();
+}
+
+bool OpenAPISpecWriter::write(JsonStreamWriter &writer, const Info &info,
+                              std::vector<Operation> &operations) {
+  std::sort(operations.begin(), operations.end(), operationBefore);
+
+  writer.beginObject().member("openapi", OPENAPI_VERSION);
+  writer.key("info")
+      .beginObject()
+      .member("title", info.title)
+      .member("version", info.version);
+  if (info.description) {
+    writer.member("description", info.description);
+  }
+  writer.endObject();
+  if (info.serverUrl) {
+    writer.key("servers").beginArray().beginObject();
+    writer.member("url", info.serverUrl).endObject().endArray();
+  }
+
+  writer.key("paths").beginObject();
+  const char *openPath = nullptr;
+  for (const Operation &operation : operations) {
+    if (!openPath || strcmp(openPath, operation.path) != 0) {
+      if (openPath) {
+        writer.endObject();
+      }
+      writer.key(operation.path).beginObject();
+      openPath = operation.path;
+    }
+    writer.key(methodName(operation.method));
+    writeOperation(writer, operation);
+  }
+  if (openPath) {
+    writer.endObject();
+  }
+  writer.endObject();
+
+  writer.key("components").beginObject();
+  OpenAPIComponents::shared().write(writer);
+  writeSecuritySchemes(writer);
+  writer.endObject();
+  writer.endObject();
+  return writer.flush();
+}
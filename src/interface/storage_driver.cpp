@@ -0,0 +1,67 @@
+#include <interface/storage_driver.h>
+#include <utility>
+#include <vector>
+
+namespace {
+
+struct Registry {
+  std::vector<std::pair<String, IStorageDriver *>> drivers;
+  String defaultName;
+};
+
+// Function-local so drivers can register from static constructors
+Registry &registry() {
+  static Registry instance;
+  return instance;
+}
+
+} // namespace
+
+void StorageDriverRegistry::registerDriver(const String &name,
+                                           IStorageDriver *driver) {
+  if (!driver) {
+    return;
+  }
+  Registry &state = registry();
+  for (auto &entry : state.drivers) {
+    if (entry.first == name) {
+      entry.second = driver;
+      return;
+    }
+  }
+  state.drivers.push_back(std::make_pair(name, driver));
+  if (state.drivers.size() == 1) {
+    state.defaultName = name;
+  }
+}
+
+void StorageDriverRegistry::unregisterDriver(const String &name) {
+  Registry &state = registry();
+  for (size_t i = 0; i < state.drivers.size(); i++) {
+    if (state.drivers[i].first == name) {
+      state.drivers.erase(state.drivers.begin() + i);
+      break;
+    }
+  }
+  if (state.defaultName == name) {
+    state.defaultName =
+        state.drivers.empty() ? String() : state.drivers.front().first;
+  }
+}
+
+void StorageDriverRegistry::setDefaultDriver(const String &name) {
+  registry().defaultName = name;
+}
+
+IStorageDriver *StorageDriverRegistry::getDriver(const String &name) {
+  Registry &state = registry();
+  const String &wanted = name.length() > 0 ? name : state.defaultName;
+  for (const auto &entry : state.drivers) {
+    if (entry.first == wanted) {
+      return entry.second;
+    }
+  }
+  return nullptr;
+}
+
+size_t StorageDriverRegistry::count() { return registry().drivers.size(); }
@@ -0,0 +1,117 @@
+#include <interface/utils/content_encoding.h>
+
+namespace {
+
+const uint16_t NOT_LISTED = 0xFFFF;
+
+StringView trim(StringView text) {
+  while (!text.empty() && (text[0] == ' ' || text[0] == '\t')) {
+    text = text.substr(1);
+  }
+  while (!text.empty() && (text[text.length() - 1] == ' ' ||
+                           text[text.length() - 1] == '\t')) {
+    text = text.substr(0, text.length() - 1);
+  }
+  return text;
+}
+
+} // namespace
+
+namespace ContentEncodings {
+
+uint16_t qualityValue(StringView parameters) {
+  size_t pos = 0;
+  while (pos < parameters.length()) {
+    size_t end = parameters.find(';', pos);
+    if (end == StringView::npos) {
+      end = parameters.length();
+    }
+    StringView parameter = trim(parameters.substr(pos, end - pos));
+    if (parameter.length() >= 2 &&
+        (parameter[0] == 'q' || parameter[0] == 'Q') && parameter[1] == '=') {
+      StringView value = parameter.substr(2);
+      if (value.empty() || (value[0] != '0' && value[0] != '1')) {
+        return 1000;
+      }
+      uint16_t quality = value[0] == '1' ? 1000 : 0;
+      uint16_t scale = 100;
+      for (size_t i = 2; i < value.length() && i < 5 && value[1] == '.';
+           i++) {
+        if (value[i] < '0' || value[i] > '9') {
+          break;
+        }
+        quality += (value[i] - '0') * scale;
+        scale /= 10;
+      }
+      return quality > 1000 ? 1000 : quality;
+    }
+    pos = end + 1;
+  }
+  return 1000;
+}
+
+const char *name(ContentEncoding encoding) {
+  switch (encoding) {
+  case ContentEncoding::BROTLI:
+    return "br";
+  case ContentEncoding::GZIP:
+    return "gzip";
+  default:
+    return "identity";
+  }
+}
+
+uint16_t quality(StringView acceptEncoding, StringView coding) {
+  uint16_t listed = NOT_LISTED;
+  uint16_t wildcard = NOT_LISTED;
+  size_t pos = 0;
+  while (pos < acceptEncoding.length()) {
+    size_t end = acceptEncoding.find(',', pos);
+    if (end == StringView::npos) {
+      end = acceptEncoding.length();
+    }
+    StringView item = acceptEncoding.substr(pos, end - pos);
+    size_t semicolon = item.find(';');
+    StringView token = trim(item.substr(0, semicolon));
+    uint16_t value = semicolon == StringView::npos
+                         ? 1000
+                         : qualityValue(item.substr(semicolon + 1));
+    if (token.equalsIgnoreCase(coding)) {
+      listed = value;
+    } else if (token == "*") {
+      wildcard = value;
+    }
+    pos = end + 1;
+  }
+
+  if (listed != NOT_LISTED) {
+    return listed;
+  }
+  if (wildcard != NOT_LISTED) {
+    return wildcard;
+  }
+  // Unlisted codings are not acceptable, except identity
+  return coding.equalsIgnoreCase("identity") ? 1000 : 0;
+}
+
+ContentEncoding negotiate(StringView acceptEncoding, bool gzipAvailable,
+                          bool brotliAvailable) {
+  ContentEncoding best = ContentEncoding::IDENTITY;
+  uint16_t bestQuality = quality(acceptEncoding, "identity");
+  if (gzipAvailable) {
+    uint16_t gzip = quality(acceptEncoding, "gzip");
+    if (gzip > 0 && gzip >= bestQuality) {
+      best = ContentEncoding::GZIP;
+      bestQuality = gzip;
+    }
+  }
+  if (brotliAvailable) {
+    uint16_t brotli = quality(acceptEncoding, "br");
+    if (brotli > 0 && brotli >= bestQuality) {
+      best = ContentEncoding::BROTLI;
+    }
+  }
+  return best;
+}
+
+} // namespace ContentEncodings
@@ -0,0 +1,66 @@
+#include <interface/utils/etag.h>
+
+namespace {
+
+// Opaque part of a tag: W/"abc" and "abc" both compare as "abc"
+StringView opaque(StringView tag) {
+  if (tag.startsWith("W/")) {
+    tag = tag.substr(2);
+  }
+  return tag;
+}
+
+} // namespace
+
+namespace ETag {
+
+String format(uint64_t hash, bool weak) {
+  static const char HEX[] = "0123456789abcdef";
+  char text[24];
+  size_t pos = 0;
+  if (weak) {
+    text[pos++] = 'W';
+    text[pos++] = '/';
+  }
+  text[pos++] = '"';
+  for (int shift = 60; shift >= 0; shift -= 4) {
+    text[pos++] = HEX[(hash >> shift) & 0xF];
+  }
+  text[pos++] = '"';
+  text[pos] = '\0';
+  return String(text);
+}
+
+String compute(const uint8_t *data, size_t length) {
+  Hasher hasher;
+  hasher.update(reinterpret_cast<const char *>(data), length);
+  return format(hasher.digest());
+}
+
+bool matches(StringView ifNoneMatch, StringView etag) {
+  if (etag.empty()) {
+    return false;
+  }
+  StringView wanted = opaque(etag);
+  size_t pos = 0;
+  while (pos < ifNoneMatch.length()) {
+    size_t end = ifNoneMatch.find(',', pos);
+    if (end == StringView::npos) {
+      end = ifNoneMatch.length();
+    }
+    StringView candidate = ifNoneMatch.substr(pos, end - pos);
+    while (!candidate.empty() && candidate[0] == ' ') {
+      candidate = candidate.substr(1);
+    }
+    while (!candidate.empty() && candidate[candidate.length() - 1] == ' ') {
+      candidate = candidate.substr(0, candidate.length() - 1);
+    }
+    if (candidate == "*" || opaque(candidate) == wanted) {
+      return true;
+    }
+    pos = end + 1;
+  }
+  return false;
+}
+
+} // namespace ETag
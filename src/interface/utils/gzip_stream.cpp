@@ -0,0 +1,350 @@
+#include <interface/utils/content_encoding.h>
+#include <interface/utils/gzip_stream.h>
+#include <string.h>
+
+namespace {
+
+const size_t MIN_MATCH = 3;
+const size_t MAX_MATCH = 258;
+const uint16_t NIL = 0xFFFF;
+// A 3-byte match further back than this costs more bits than 3 literals
+const size_t TOO_FAR = 4096;
+
+// RFC 1951 section 3.2.5
+const uint16_t LENGTH_BASE[29] = {3,  4,  5,  6,   7,   8,   9,   10,  11, 13,
+                                  15, 17, 19, 23,  27,  31,  35,  43,  51, 59,
+                                  67, 83, 99, 115, 131, 163, 195, 227, 258};
+const uint8_t LENGTH_EXTRA[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1,
+                                  1, 1, 2, 2, 2, 2, 3, 3, 3, 3,
+                                  4, 4, 4, 4, 5, 5, 5, 5, 0};
+const uint16_t DISTANCE_BASE[30] = {
+    1,   2,   3,   4,   5,   7,    9,    13,   17,   25,
+    33,  49,  65,  97,  129, 193,  257,  385,  513,  769,
+    1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+const uint8_t DISTANCE_EXTRA[30] = {0, 0, 0, 0, 1, 1, 2,  2,  3,  3,
+                                    4, 4, 5, 5, 6, 6, 7,  7,  8,  8,
+                                    9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+struct CrcTable {
+  uint32_t entries[256];
+};
+
+constexpr CrcTable buildCrcTable() {
+  CrcTable table = {};
+  for (uint32_t i = 0; i < 256; i++) {
+    uint32_t value = i;
+    for (int bit = 0; bit < 8; bit++) {
+      value = (value & 1) ? 0xEDB88320u ^ (value >> 1) : value >> 1;
+    }
+    table.entries[i] = value;
+  }
+  return table;
+}
+
+constexpr CrcTable CRC_TABLE = buildCrcTable();
+
+uint32_t updateCrc(uint32_t crc, const char *data, size_t length) {
+  uint32_t value = crc ^ 0xFFFFFFFFu;
+  for (size_t i = 0; i < length; i++) {
+    value = CRC_TABLE.entries[(value ^ static_cast<uint8_t>(data[i])) & 0xFF] ^
+            (value >> 8);
+  }
+  return value ^ 0xFFFFFFFFu;
+}
+
+// Huffman codes are sent most significant bit first into an LSB-first
+// bit stream
+uint32_t reverseBits(uint32_t code, uint8_t length) {
+  uint32_t reversed = 0;
+  for (uint8_t i = 0; i < length; i++) {
+    reversed = (reversed << 1) | (code & 1);
+    code >>= 1;
+  }
+  return reversed;
+}
+
+StringView trim(StringView text) {
+  while (!text.empty() && text[0] == ' ') {
+    text = text.substr(1);
+  }
+  while (!text.empty() && text[text.length() - 1] == ' ') {
+    text = text.substr(0, text.length() - 1);
+  }
+  return text;
+}
+
+} // namespace
+
+GzipStream::GzipStream(const ChunkSink &sink, uint8_t windowBits,
+                       uint8_t maxChain)
+    : sink(sink), windowBits(clampWindowBits(windowBits)),
+      hashBits(hashBitsFor(this->windowBits)),
+      maxChain(maxChain ? maxChain : 1),
+      windowSize(static_cast<size_t>(1) << this->windowBits), window(nullptr),
+      head(nullptr), previous(nullptr), fill(0), position(0), bitBuffer(0),
+      bitCount(0), crc(0), inputSize(0), outputSize(0), failed(false),
+      finished(false), outputLength(0) {
+  // One allocation: window, then the two position tables
+  uint8_t *memory = new uint8_t[memoryFor(this->windowBits)];
+  window = memory;
+  head = reinterpret_cast<uint16_t *>(memory + 2 * windowSize);
+  previous = head + (static_cast<size_t>(1) << hashBits);
+  for (size_t i = 0; i < (static_cast<size_t>(1) << hashBits); i++) {
+    head[i] = NIL;
+  }
+
+  // Header: magic, deflate, no flags, no mtime, no extra flags, OS unknown
+  static const uint8_t HEADER[10] = {0x1f, 0x8b, 8, 0, 0, 0, 0, 0, 0, 0xff};
+  for (uint8_t byte : HEADER) {
+    putByte(byte);
+  }
+  putBits(1, 1); // BFINAL: the whole body is one block
+  putBits(1, 2); // BTYPE 01: fixed Huffman codes
+}
+
+GzipStream::~GzipStream() { delete[] window; }
+
+size_t GzipStream::memoryFor(uint8_t windowBits) {
+  windowBits = clampWindowBits(windowBits);
+  size_t size = static_cast<size_t>(1) << windowBits;
+  return 2 * size + sizeof(uint16_t) * size +
+         sizeof(uint16_t) * (static_cast<size_t>(1) << hashBitsFor(windowBits));
+}
+
+uint8_t GzipStream::clampWindowBits(uint8_t windowBits) {
+  if (windowBits < MIN_WINDOW_BITS) {
+    return MIN_WINDOW_BITS;
+  }
+  return windowBits > MAX_WINDOW_BITS ? MAX_WINDOW_BITS : windowBits;
+}
+
+uint8_t GzipStream::hashBitsFor(uint8_t windowBits) {
+  uint8_t bits = windowBits - 1;
+  return bits < 8 ? 8 : (bits > 12 ? 12 : bits);
+}
+
+bool GzipStream::write(const char *data, size_t length) {
+  if (failed || finished) {
+    return false;
+  }
+  crc = updateCrc(crc, data, length);
+  inputSize += length;
+  while (length > 0) {
+    if (fill == 2 * windowSize) {
+      slide();
+    }
+    size_t count = 2 * windowSize - fill;
+    if (count > length) {
+      count = length;
+    }
+    memcpy(window + fill, data, count);
+    fill += count;
+    data += count;
+    length -= count;
+    compress(false);
+  }
+  return !failed;
+}
+
+bool GzipStream::finish() {
+  if (finished) {
+    return !failed;
+  }
+  compress(true);
+  writeLengthSymbol(256); // End of block
+  if (bitCount > 0) {
+    putByte(static_cast<uint8_t>(bitBuffer));
+    bitBuffer = 0;
+    bitCount = 0;
+  }
+  uint32_t size = static_cast<uint32_t>(inputSize);
+  for (int shift = 0; shift < 32; shift += 8) {
+    putByte(static_cast<uint8_t>(crc >> shift));
+  }
+  for (int shift = 0; shift < 32; shift += 8) {
+    putByte(static_cast<uint8_t>(size >> shift));
+  }
+  flushOutput();
+  finished = true;
+  return !failed;
+}
+
+void GzipStream::compress(bool flush) {
+  while (position < fill) {
+    size_t available = fill - position;
+    if (!flush && available < MAX_MATCH) {
+      return; // Wait for lookahead so matches are not cut short
+    }
+    size_t limit = available < MAX_MATCH ? available : MAX_MATCH;
+    size_t length = 0;
+    size_t distance = 0;
+    if (limit >= MIN_MATCH) {
+      uint32_t hash = hashAt(position);
+      uint16_t candidate = head[hash];
+      previous[position & (windowSize - 1)] = candidate;
+      head[hash] = static_cast<uint16_t>(position);
+      length = longestMatch(position, candidate, limit, distance);
+      if (length == MIN_MATCH && distance > TOO_FAR) {
+        length = 0;
+      }
+    }
+
+    if (length >= MIN_MATCH) {
+      writeMatch(length, distance);
+      for (size_t i = 1; i < length; i++) {
+        if (position + i + MIN_MATCH <= fill) {
+          insert(position + i);
+        }
+      }
+      position += length;
+    } else {
+      writeLiteral(window[position]);
+      position++;
+    }
+  }
+}
+
+size_t GzipStream::longestMatch(size_t position, uint16_t candidate,
+                                size_t limit, size_t &distance) const {
+  size_t best = 0;
+  const uint8_t *current = window + position;
+  for (uint8_t chain = 0; chain < maxChain && candidate != NIL; chain++) {
+    // Entries further back than the window have been overwritten
+    if (candidate >= position || position - candidate >= windowSize) {
+      break;
+    }
+    const uint8_t *match = window + candidate;
+    if (match[best] == current[best] && match[0] == current[0]) {
+      size_t length = 0;
+      while (length < limit && match[length] == current[length]) {
+        length++;
+      }
+      if (length > best) {
+        best = length;
+        distance = position - candidate;
+        if (best == limit) {
+          break;
+        }
+      }
+    }
+    candidate = previous[candidate & (windowSize - 1)];
+  }
+  return best;
+}
+
+void GzipStream::insert(size_t position) {
+  uint32_t hash = hashAt(position);
+  previous[position & (windowSize - 1)] = head[hash];
+  head[hash] = static_cast<uint16_t>(position);
+}
+
+uint32_t GzipStream::hashAt(size_t position) const {
+  uint32_t key = (static_cast<uint32_t>(window[position]) << 16) |
+                 (static_cast<uint32_t>(window[position + 1]) << 8) |
+                 window[position + 2];
+  return (key * 2654435761u) >> (32 - hashBits);
+}
+
+// Drop the older half of the window; positions move down by windowSize
+void GzipStream::slide() {
+  memmove(window, window + windowSize, fill - windowSize);
+  fill -= windowSize;
+  position -= windowSize;
+  size_t heads = static_cast<size_t>(1) << hashBits;
+  for (size_t i = 0; i < heads; i++) {
+    head[i] = (head[i] == NIL || head[i] < windowSize)
+                  ? NIL
+                  : static_cast<uint16_t>(head[i] - windowSize);
+  }
+  for (size_t i = 0; i < windowSize; i++) {
+    previous[i] = (previous[i] == NIL || previous[i] < windowSize)
+                      ? NIL
+                      : static_cast<uint16_t>(previous[i] - windowSize);
+  }
+}
+
+void GzipStream::writeLiteral(uint8_t byte) {
+  if (byte < 144) {
+    putBits(reverseBits(0x30 + byte, 8), 8);
+  } else {
+    putBits(reverseBits(0x190 + (byte - 144), 9), 9);
+  }
+}
+
+void GzipStream::writeLengthSymbol(uint16_t symbol) {
+  if (symbol < 280) {
+    putBits(reverseBits(symbol - 256, 7), 7);
+  } else {
+    putBits(reverseBits(0xC0 + (symbol - 280), 8), 8);
+  }
+}
+
+void GzipStream::writeMatch(size_t length, size_t distance) {
+  uint8_t code = 28;
+  while (LENGTH_BASE[code] > length) {
+    code--;
+  }
+  writeLengthSymbol(257 + code);
+  putBits(static_cast<uint32_t>(length - LENGTH_BASE[code]),
+          LENGTH_EXTRA[code]);
+
+  code = 29;
+  while (DISTANCE_BASE[code] > distance) {
+    code--;
+  }
+  putBits(reverseBits(code, 5), 5);
+  putBits(static_cast<uint32_t>(distance - DISTANCE_BASE[code]),
+          DISTANCE_EXTRA[code]);
+}
+
+void GzipStream::putBits(uint32_t value, uint8_t count) {
+  bitBuffer |= value << bitCount;
+  bitCount += count;
+  while (bitCount >= 8) {
+    putByte(static_cast<uint8_t>(bitBuffer));
+    bitBuffer >>= 8;
+    bitCount -= 8;
+  }
+}
+
+void GzipStream::putByte(uint8_t byte) {
+  output[outputLength++] = static_cast<char>(byte);
+  if (outputLength == sizeof(output)) {
+    flushOutput();
+  }
+}
+
+void GzipStream::flushOutput() {
+  if (outputLength > 0 && !failed && !sink(output, outputLength)) {
+    failed = true;
+  }
+  outputSize += outputLength;
+  outputLength = 0;
+}
+
+bool ResponseCompressionPolicy::appliesTo(StringView acceptEncoding,
+                                          StringView mimeType,
+                                          size_t length) const {
+  if (!enabled() || (length != UNKNOWN_LENGTH && length < minBytes) ||
+      ContentEncodings::quality(acceptEncoding, "gzip") == 0) {
+    return false;
+  }
+  if (!mimeTypes) {
+    return true;
+  }
+  StringView prefixes(mimeTypes);
+  size_t pos = 0;
+  while (pos < prefixes.length()) {
+    size_t end = prefixes.find(',', pos);
+    if (end == StringView::npos) {
+      end = prefixes.length();
+    }
+    StringView prefix = trim(prefixes.substr(pos, end - pos));
+    if (!prefix.empty() && mimeType.length() >= prefix.length() &&
+        mimeType.substr(0, prefix.length()).equalsIgnoreCase(prefix)) {
+      return true;
+    }
+    pos = end + 1;
+  }
+  return false;
+}
@@ -0,0 +1,128 @@
+#include <interface/utils/http_range.h>
+
+namespace {
+
+StringView trim(StringView text) {
+  while (!text.empty() && (text[0] == ' ' || text[0] == '\t')) {
+    text = text.substr(1);
+  }
+  while (!text.empty() && (text[text.length() - 1] == ' ' ||
+                           text[text.length() - 1] == '\t')) {
+    text = text.substr(0, text.length() - 1);
+  }
+  return text;
+}
+
+// Decimal digits only; false on empty input or overflow
+bool parseSize(StringView digits, size_t &value) {
+  if (digits.empty()) {
+    return false;
+  }
+  value = 0;
+  for (char c : digits) {
+    if (c < '0' || c > '9') {
+      return false;
+    }
+    size_t next = value * 10 + static_cast<size_t>(c - '0');
+    if (next / 10 != value) {
+      return false;
+    }
+    value = next;
+  }
+  return true;
+}
+
+void appendSize(String &out, size_t value) {
+  char digits[24];
+  snprintf(digits, sizeof(digits), "%lu", static_cast<unsigned long>(value));
+  out += digits;
+}
+
+} // namespace
+
+namespace HttpRange {
+
+Outcome parse(StringView rangeHeader, size_t size, ByteRange &range) {
+  range.offset = 0;
+  range.length = size;
+
+  StringView spec = trim(rangeHeader);
+  if (spec.length() < 6 || !spec.substr(0, 6).equalsIgnoreCase("bytes=")) {
+    return Outcome::FULL;
+  }
+  spec = trim(spec.substr(6));
+  if (spec.find(',') != StringView::npos) {
+    return Outcome::UNSATISFIABLE;
+  }
+  size_t dash = spec.find('-');
+  if (dash == StringView::npos) {
+    return Outcome::FULL;
+  }
+  StringView firstText = trim(spec.substr(0, dash));
+  StringView lastText = trim(spec.substr(dash + 1));
+
+  size_t first = 0;
+  size_t last = 0;
+  if (firstText.empty()) {
+    // Suffix range: the final `last` bytes
+    if (!parseSize(lastText, last)) {
+      return Outcome::FULL;
+    }
+    if (last == 0 || size == 0) {
+      return Outcome::UNSATISFIABLE;
+    }
+    range.length = last < size ? last : size;
+    range.offset = size - range.length;
+    return Outcome::PARTIAL;
+  }
+
+  if (!parseSize(firstText, first)) {
+    return Outcome::FULL;
+  }
+  if (lastText.empty()) {
+    last = size ? size - 1 : 0;
+  } else if (!parseSize(lastText, last) || last < first) {
+    return Outcome::FULL;
+  }
+  if (first >= size) {
+    return Outcome::UNSATISFIABLE;
+  }
+  if (last >= size) {
+    last = size - 1;
+  }
+  range.offset = first;
+  range.length = last - first + 1;
+  return Outcome::PARTIAL;
+}
+
+bool ifRangeHolds(StringView ifRange, StringView etag,
+                  StringView lastModified) {
+  ifRange = trim(ifRange);
+  if (ifRange.empty()) {
+    return true;
+  }
+  if (ifRange[0] == '"' || ifRange.startsWith("W/")) {
+    // Strong comparison: weak tags never validate a range
+    return !ifRange.startsWith("W/") && !etag.startsWith("W/") &&
+           ifRange == trim(etag);
+  }
+  return !lastModified.empty() && ifRange == trim(lastModified);
+}
+
+String contentRange(const ByteRange &range, size_t size) {
+  String value = "bytes ";
+  appendSize(value, range.offset);
+  value += '-';
+  appendSize(value, range.offset + range.length - 1);
+  value += '/';
+  appendSize(value, size);
+  return value;
+}
+
+String unsatisfiedRange(size_t size) {
+  String value = "bytes */";
+  appendSize(value, size);
+  return value;
+}
+
+} // namespace HttpRange
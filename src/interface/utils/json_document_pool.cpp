@@ -0,0 +1,137 @@
+#include <interface/utils/json_document_pool.h>
+#include <interface/web_request.h>
+
+namespace {
+
+// Documents are sized in steps so nearby high-water marks share buffers
+const size_t CAPACITY_STEP = 64;
+
+size_t roundUp(size_t capacity) {
+  if (capacity == 0) {
+    return CAPACITY_STEP;
+  }
+  return (capacity + CAPACITY_STEP - 1) / CAPACITY_STEP * CAPACITY_STEP;
+}
+
+} // namespace
+
+JsonDocumentPool::Lease::Lease(Lease &&other) noexcept
+    : pool(other.pool), doc(std::move(other.doc)) {
+  other.pool = nullptr;
+}
+
+JsonDocumentPool::Lease &
+JsonDocumentPool::Lease::operator=(Lease &&other) noexcept {
+  if (this != &other) {
+    giveBack();
+    pool = other.pool;
+    doc = std::move(other.doc);
+    other.pool = nullptr;
+  }
+  return *this;
+}
+
+JsonDocumentPool::Lease::~Lease() { giveBack(); }
+
+void JsonDocumentPool::Lease::giveBack() {
+  if (pool && doc) {
+    pool->release(std::move(doc));
+  }
+  pool = nullptr;
+  doc.reset();
+}
+
+JsonDocumentPool::JsonDocumentPool(size_t maxDocuments, size_t initialCapacity,
+                                   size_t maxCapacity)
+    : maxDocuments(maxDocuments), initialCapacity(roundUp(initialCapacity)),
+      maxCapacity(roundUp(maxCapacity)) {
+  if (this->initialCapacity > this->maxCapacity) {
+    this->initialCapacity = this->maxCapacity;
+  }
+}
+
+StringView JsonDocumentPool::routeKey(const WebRequest *request) {
+  return request ? StringView(request->getMatchedRoute()) : StringView();
+}
+
+JsonDocumentPool::Lease JsonDocumentPool::acquire(size_t capacity) {
+  counters.acquisitions++;
+  // Smallest idle document that is large enough
+  size_t best = idle.size();
+  for (size_t i = 0; i < idle.size(); i++) {
+    if (idle[i]->capacity() >= capacity &&
+        (best == idle.size() ||
+         idle[i]->capacity() < idle[best]->capacity())) {
+      best = i;
+    }
+  }
+  if (best < idle.size()) {
+    std::unique_ptr<DynamicJsonDocument> doc = std::move(idle[best]);
+    idle[best] = std::move(idle.back());
+    idle.pop_back();
+    counters.hits++;
+    return Lease(this, std::move(doc));
+  }
+  return Lease(this, std::unique_ptr<DynamicJsonDocument>(
+                         new DynamicJsonDocument(roundUp(capacity))));
+}
+
+void JsonDocumentPool::release(std::unique_ptr<DynamicJsonDocument> doc) {
+  // A failed allocation leaves a zero-capacity document; not worth keeping
+  if (maxDocuments == 0 || doc->capacity() == 0) {
+    return;
+  }
+  doc->clear();
+  if (idle.size() < maxDocuments) {
+    idle.push_back(std::move(doc));
+    return;
+  }
+  // Full: keep the larger documents, they can serve any request
+  size_t smallest = 0;
+  for (size_t i = 1; i < idle.size(); i++) {
+    if (idle[i]->capacity() < idle[smallest]->capacity()) {
+      smallest = i;
+    }
+  }
+  if (doc->capacity() > idle[smallest]->capacity()) {
+    idle[smallest] = std::move(doc);
+  }
+}
+
+size_t JsonDocumentPool::capacityFor(StringView routeKey) const {
+  for (const RouteUsage &route : routes) {
+    if (StringView(route.key) == routeKey) {
+      size_t capacity = roundUp(route.highWater + route.highWater / 4);
+      return capacity < maxCapacity ? capacity : maxCapacity;
+    }
+  }
+  return initialCapacity;
+}
+
+void JsonDocumentPool::learn(StringView routeKey, size_t memoryUsage) {
+  for (RouteUsage &route : routes) {
+    if (StringView(route.key) == routeKey) {
+      if (memoryUsage > route.highWater) {
+        route.highWater = memoryUsage;
+      }
+      return;
+    }
+  }
+  // Routes beyond the bound keep using initialCapacity
+  if (routes.size() < MAX_ROUTES) {
+    routes.push_back(RouteUsage{routeKey.toString(), memoryUsage});
+  }
+}
+
+void JsonDocumentPool::clear() {
+  idle.clear();
+  routes.clear();
+}
+
+size_t JsonDocumentPool::idleBytes() const {
+  size_t bytes = 0;
+  for (const auto &doc : idle) {
+    bytes += doc->capacity();
+  }
+  return bytes;
+}
@@ -0,0 +1,120 @@
+#include <interface/utils/content_encoding.h>
+#include <interface/utils/json_format.h>
+
+namespace {
+
+const char *const JSON_MIME_TYPE = "application/json";
+const char *const MSGPACK_MIME_TYPE = "application/msgpack";
+// Pre-standard name still sent by many MessagePack clients
+const char *const MSGPACK_LEGACY_MIME_TYPE = "application/x-msgpack";
+
+// Match specificity of an Accept entry, most specific wins
+enum Specificity : uint8_t { NONE, ANY, SAME_TYPE, EXACT };
+
+StringView trim(StringView text) {
+  while (!text.empty() && (text[0] == ' ' || text[0] == '\t')) {
+    text = text.substr(1);
+  }
+  while (!text.empty() && (text[text.length() - 1] == ' ' ||
+                           text[text.length() - 1] == '\t')) {
+    text = text.substr(0, text.length() - 1);
+  }
+  return text;
+}
+
+// Media type of a Content-Type or Accept entry, without parameters
+StringView essence(StringView value) {
+  return trim(value.substr(0, value.find(';')));
+}
+
+Specificity specificity(StringView range, StringView mediaType) {
+  if (range.equalsIgnoreCase(mediaType)) {
+    return EXACT;
+  }
+  if (range == "*/*") {
+    return ANY;
+  }
+  size_t slash = mediaType.find('/');
+  if (range.length() == slash + 2 && range[slash] == '/' &&
+      range[slash + 1] == '*' &&
+      range.substr(0, slash).equalsIgnoreCase(mediaType.substr(0, slash))) {
+    return SAME_TYPE;
+  }
+  return NONE;
+}
+
+uint16_t msgPackQuality(StringView accept) {
+  uint16_t standard = JsonFormats::quality(accept, MSGPACK_MIME_TYPE);
+  uint16_t legacy = JsonFormats::quality(accept, MSGPACK_LEGACY_MIME_TYPE);
+  return standard > legacy ? standard : legacy;
+}
+
+} // namespace
+
+namespace JsonFormats {
+
+const char *mimeType(JsonFormat format) {
+  return format == JsonFormat::MSGPACK ? MSGPACK_MIME_TYPE : JSON_MIME_TYPE;
+}
+
+uint16_t quality(StringView accept, StringView mediaType) {
+  Specificity best = NONE;
+  uint16_t result = 0;
+  size_t pos = 0;
+  while (pos < accept.length()) {
+    size_t end = accept.find(',', pos);
+    if (end == StringView::npos) {
+      end = accept.length();
+    }
+    StringView item = accept.substr(pos, end - pos);
+    Specificity match = specificity(essence(item), mediaType);
+    if (match > best) {
+      best = match;
+      size_t semicolon = item.find(';');
+      result = semicolon == StringView::npos
+                   ? 1000
+                   : ContentEncodings::qualityValue(item.substr(semicolon + 1));
+    }
+    pos = end + 1;
+  }
+  return result;
+}
+
+JsonFormat negotiate(StringView accept) {
+  if (accept.empty()) {
+    return JsonFormat::JSON;
+  }
+  return msgPackQuality(accept) > quality(accept, JSON_MIME_TYPE)
+             ? JsonFormat::MSGPACK
+             : JsonFormat::JSON;
+}
+
+bool fromContentType(StringView contentType, JsonFormat &format) {
+  StringView type = essence(contentType);
+  if (type.equalsIgnoreCase(JSON_MIME_TYPE)) {
+    format = JsonFormat::JSON;
+    return true;
+  }
+  if (type.equalsIgnoreCase(MSGPACK_MIME_TYPE) ||
+      type.equalsIgnoreCase(MSGPACK_LEGACY_MIME_TYPE)) {
+    format = JsonFormat::MSGPACK;
+    return true;
+  }
+  return false;
+}
+
+size_t documentCapacity(size_t length, JsonFormat format) {
+  // MessagePack packs small values into a byte or two, each of which
+  // still takes a full slot in the document
+  return length * (format == JsonFormat::MSGPACK ? 8 : 2) + 256;
+}
+
+DeserializationError deserialize(JsonDocument &doc, StringView data,
+                                 JsonFormat format) {
+  if (format == JsonFormat::MSGPACK) {
+    return deserializeMsgPack(doc, data.data(), data.length());
+  }
+  return deserializeJson(doc, data.data(), data.length());
+}
+
+} // namespace JsonFormats
@@ -0,0 +1,249 @@
+#include <interface/utils/json_stream_writer.h>
+#include <math.h>
+#include <stdio.h>
+
+static_assert(JSON_STREAM_MAX_DEPTH <= 32,
+              "JsonStreamWriter tracks nesting in a 32-bit mask");
+static_assert(JSON_STREAM_BUFFER_SIZE > 0 && JSON_STREAM_BUFFER_SIZE <= 65535,
+              "JSON_STREAM_BUFFER_SIZE must fit the 16-bit fill counter");
+
+JsonStreamWriter::JsonStreamWriter(const ChunkSink &sink)
+    : sink(sink), written(0), used(0), level(0), afterKey(false),
+      failed(false), hasElement(0) {}
+
+bool JsonStreamWriter::flush() {
+  if (used > 0 && !failed) {
+    if (sink(buffer, used)) {
+      written += used;
+    } else {
+      failed = true;
+    }
+  }
+  used = 0;
+  return !failed;
+}
+
+void JsonStreamWriter::put(const char *data, size_t length) {
+  while (length > 0) {
+    if (used == JSON_STREAM_BUFFER_SIZE) {
+      flush();
+    }
+    size_t room = JSON_STREAM_BUFFER_SIZE - used;
+    size_t count = length < room ? length : room;
+    memcpy(buffer + used, data, count);
+    used += count;
+    data += count;
+    length -= count;
+  }
+}
+
+void JsonStreamWriter::putDigits(unsigned long long number) {
+  char digits[20];
+  size_t count = 0;
+  do {
+    digits[sizeof(digits) - ++count] = static_cast<char>('0' + number % 10);
+    number /= 10;
+  } while (number > 0);
+  put(digits + sizeof(digits) - count, count);
+}
+
+void JsonStreamWriter::beforeValue() {
+  if (afterKey) {
+    afterKey = false;
+    return;
+  }
+  if (level == 0) {
+    return;
+  }
+  uint32_t bit = 1u << (level - 1);
+  if (hasElement & bit) {
+    put(',');
+  }
+  hasElement |= bit;
+}
+
+JsonStreamWriter &JsonStreamWriter::open(char bracket) {
+  beforeValue();
+  put(bracket);
+  if (level < JSON_STREAM_MAX_DEPTH) {
+    level++;
+    hasElement &= ~(1u << (level - 1));
+  } else {
+    failed = true; // Deeper than we can track; output would be malformed
+  }
+  return *this;
+}
+
+JsonStreamWriter &JsonStreamWriter::close(char bracket) {
+  put(bracket);
+  if (level > 0) {
+    level--;
+  }
+  afterKey = false;
+  return *this;
+}
+
+JsonStreamWriter &JsonStreamWriter::beginObject() { return open('{'); }
+JsonStreamWriter &JsonStreamWriter::endObject() { return close('}'); }
+JsonStreamWriter &JsonStreamWriter::beginArray() { return open('['); }
+JsonStreamWriter &JsonStreamWriter::endArray() { return close(']'); }
+
+JsonStreamWriter &JsonStreamWriter::key(StringView name) {
+  beforeValue();
+  writeEscaped(name);
+  put(':');
+  afterKey = true;
+  return *this;
+}
+
+JsonStreamWriter &JsonStreamWriter::value(StringView text) {
+  beforeValue();
+  writeEscaped(text);
+  return *this;
+}
+
+JsonStreamWriter &JsonStreamWriter::value(bool flag) {
+  beforeValue();
+  if (flag) {
+    put("true", 4);
+  } else {
+    put("false", 5);
+  }
+  return *this;
+}
+
+JsonStreamWriter &JsonStreamWriter::value(long number) {
+  return value(static_cast<long long>(number));
+}
+
+JsonStreamWriter &JsonStreamWriter::value(unsigned long number) {
+  return value(static_cast<unsigned long long>(number));
+}
+
+JsonStreamWriter &JsonStreamWriter::value(long long number) {
+  beforeValue();
+  if (number < 0) {
+    put('-');
+    // Negate in unsigned space so LLONG_MIN does not overflow
+    putDigits(0ull - static_cast<unsigned long long>(number));
+  } else {
+    putDigits(static_cast<unsigned long long>(number));
+  }
+  return *this;
+}
+
+JsonStreamWriter &JsonStreamWriter::value(unsigned long long number) {
+  beforeValue();
+  putDigits(number);
+  return *this;
+}
+
+JsonStreamWriter &JsonStreamWriter::value(double number) {
+  if (isnan(number) || isinf(number)) {
+    return nullValue();
+  }
+  beforeValue();
+  char text[32];
+  int length = snprintf(text, sizeof(text), "%.9g", number);
+  put(text, length > 0 ? static_cast<size_t>(length) : 0);
+  return *this;
+}
+
+JsonStreamWriter &JsonStreamWriter::value(JsonVariantConst json) {
+  beforeValue();
+  JsonPrint print(*this);
+  serializeJson(json, print);
+  return *this;
+}
+
+JsonStreamWriter &JsonStreamWriter::nullValue() {
+  beforeValue();
+  put("null", 4);
+  return *this;
+}
+
+JsonStreamWriter &JsonStreamWriter::rawValue(StringView json) {
+  beforeValue();
+  put(json.data(), json.length());
+  return *this;
+}
+
+JsonStreamWriter &JsonStreamWriter::compactValue(StringView json) {
+  beforeValue();
+  bool inString = false;
+  bool escaped = false;
+  size_t runStart = 0;
+  for (size_t i = 0; i < json.length(); i++) {
+    char c = json[i];
+    if (inString) {
+      if (escaped) {
+        escaped = false;
+      } else if (c == '\\') {
+        escaped = true;
+      } else if (c == '"') {
+        inString = false;
+      }
+    } else if (c == '"') {
+      inString = true;
+    } else if (c == ' ' || c == '\n' || c == '\r' || c == '\t') {
+      put(json.data() + runStart, i - runStart);
+      runStart = i + 1;
+    }
+  }
+  put(json.data() + runStart, json.length() - runStart);
+  return *this;
+}
+
+void JsonStreamWriter::writeEscaped(StringView text) {
+  static const char HEX_DIGITS[] = "0123456789abcdef";
+  put('"');
+  size_t runStart = 0;
+  for (size_t i = 0; i < text.length(); i++) {
+    unsigned char c = static_cast<unsigned char>(text[i]);
+    if (c >= 0x20 && c != '"' && c != '\\') {
+      continue;
+    }
+    // Copy the plain run before the character needing an escape
+    put(text.data() + runStart, i - runStart);
+    runStart = i + 1;
+    put('\\');
+    switch (c) {
+    case '"':
+    case '\\':
+      put(static_cast<char>(c));
+      break;
+    case '\n':
+      put('n');
+      break;
+    case '\r':
+      put('r');
+      break;
+    case '\t':
+      put('t');
+      break;
+    case '\b':
+      put('b');
+      break;
+    case '\f':
+      put('f');
+      break;
+    default:
+      put("u00", 3);
+      put(HEX_DIGITS[c >> 4]);
+      put(HEX_DIGITS[c & 0x0F]);
+      break;
+    }
+  }
+  put(text.data() + runStart, text.length() - runStart);
+  put('"');
+}
+
+size_t JsonStreamWriter::JsonPrint::write(uint8_t c) {
+  writer.put(static_cast<char>(c));
+  return 1;
+}
+
+size_t JsonStreamWriter::JsonPrint::write(const uint8_t *data, size_t length) {
+  writer.put(reinterpret_cast<const char *>(data), length);
+  return length;
+}
@@ -0,0 +1,118 @@
+#include <interface/utils/request_arena.h>
+
+namespace {
+
+int hexValue(char c) {
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  }
+  if (c >= 'a' && c <= 'f') {
+    return c - 'a' + 10;
+  }
+  if (c >= 'A' && c <= 'F') {
+    return c - 'A' + 10;
+  }
+  return -1;
+}
+
+} // namespace
+
+void RequestArena::reserve(size_t bytes, size_t fieldCount) {
+  buffer.reserve(bytes);
+  fields.reserve(fieldCount);
+}
+
+void RequestArena::clear() {
+  buffer.clear();
+  fields.clear();
+}
+
+RequestArena::Slice RequestArena::append(const char *data, size_t length) {
+  Slice slice = {static_cast<uint32_t>(buffer.size()),
+                 static_cast<uint32_t>(length)};
+  if (length > 0) {
+    buffer.insert(buffer.end(), data, data + length);
+  }
+  return slice;
+}
+
+RequestArena::Slice RequestArena::sliceOf(StringView stored) const {
+  Slice slice = {static_cast<uint32_t>(stored.data() - buffer.data()),
+                 static_cast<uint32_t>(stored.length())};
+  return slice;
+}
+
+RequestArena::Slice RequestArena::decode(Slice encoded) {
+  bool needsDecoding = false;
+  for (uint32_t i = 0; i < encoded.length && !needsDecoding; i++) {
+    char c = buffer[encoded.offset + i];
+    needsDecoding = c == '%' || c == '+';
+  }
+  if (!needsDecoding) {
+    return encoded;
+  }
+
+  // Indices rather than pointers, since appending may move the buffer
+  Slice decoded = {static_cast<uint32_t>(buffer.size()), 0};
+  for (uint32_t i = 0; i < encoded.length; i++) {
+    char c = buffer[encoded.offset + i];
+    if (c == '+') {
+      c = ' ';
+    } else if (c == '%' && i + 2 < encoded.length &&
+               hexValue(buffer[encoded.offset + i + 1]) >= 0 &&
+               hexValue(buffer[encoded.offset + i + 2]) >= 0) {
+      c = static_cast<char>(hexValue(buffer[encoded.offset + i + 1]) * 16 +
+                            hexValue(buffer[encoded.offset + i + 2]));
+      i += 2;
+    }
+    buffer.push_back(c);
+    decoded.length++;
+  }
+  return decoded;
+}
+
+void RequestArena::addField(FieldKind kind, Slice name, Slice value) {
+  Field field = {kind, name, value};
+  fields.push_back(field);
+}
+
+void RequestArena::addUrlEncodedFields(Slice source) {
+  uint32_t pos = 0;
+  while (pos < source.length) {
+    uint32_t end = pos;
+    while (end < source.length && buffer[source.offset + end] != '&') {
+      end++;
+    }
+    if (end > pos) {
+      uint32_t eq = pos;
+      while (eq < end && buffer[source.offset + eq] != '=') {
+        eq++;
+      }
+      Slice name = {source.offset + pos, eq - pos};
+      Slice value = {source.offset + end, 0};
+      if (eq < end) {
+        value.offset = source.offset + eq + 1;
+        value.length = end - eq - 1;
+      }
+      Slice decodedName = decode(name);
+      addField(PARAM, decodedName, decode(value));
+    }
+    pos = end + 1;
+  }
+}
+
+const RequestArena::Field *RequestArena::findField(FieldKind kind,
+                                                   StringView name,
+                                                   bool ignoreCase) const {
+  for (const Field &field : fields) {
+    if (field.kind != kind) {
+      continue;
+    }
+    StringView fieldName = view(field.name);
+    if (ignoreCase ? fieldName.equalsIgnoreCase(name)
+                   : fieldName.equals(name)) {
+      return &field;
+    }
+  }
+  return nullptr;
+}
@@ -0,0 +1,346 @@
+#include <interface/utils/request_validator.h>
+#include <math.h>
+#include <string.h>
+#include <string>
+
+namespace {
+
+// Parse budget for a schema: retried larger when ArduinoJson runs out
+const size_t PARSE_CAPACITY_FACTOR = 2;
+const size_t PARSE_CAPACITY_SLACK = 256;
+const int PARSE_ATTEMPTS = 3;
+
+const char *const WRONG_TYPE = "has the wrong type";
+
+size_t utf8Length(const char *text) {
+  size_t length = 0;
+  for (; *text; text++) {
+    if ((static_cast<uint8_t>(*text) & 0xC0) != 0x80) {
+      length++;
+    }
+  }
+  return length;
+}
+
+} // namespace
+
+bool RequestValidator::compile(StringView schema) {
+  rules.clear();
+  enums.clear();
+  strings.assign(1, '\0'); // Offset 0 is the empty string
+
+  // Each schema level is an object plus its "properties" object; a full
+  // request body adds three more
+  DeserializationOption::NestingLimit nesting(MAX_DEPTH * 2 + 5);
+  size_t capacity = schema.length() * PARSE_CAPACITY_FACTOR +
+                    PARSE_CAPACITY_SLACK;
+  for (int attempt = 0; attempt < PARSE_ATTEMPTS; attempt++) {
+    DynamicJsonDocument doc(capacity);
+    DeserializationError parsed =
+        deserializeJson(doc, schema.data(), schema.length(), nesting);
+    if (parsed == DeserializationError::NoMemory) {
+      capacity *= 2;
+      continue;
+    }
+    if (parsed) {
+      break;
+    }
+    // A full request body object: its application/json schema
+    JsonVariantConst root = doc.as<JsonVariantConst>();
+    if (root["content"].is<JsonObjectConst>()) {
+      root = root["content"]["application/json"]["schema"];
+    }
+    rules.resize(1);
+    if (!compileRule(root, 0, 0)) {
+      break;
+    }
+    rules.shrink_to_fit();
+    enums.shrink_to_fit();
+    strings.shrink_to_fit();
+    return true;
+  }
+  rules.clear();
+  enums.clear();
+  strings.clear();
+  return false;
+}
+
+uint16_t RequestValidator::addString(StringView text) {
+  if (strings.size() + text.length() + 1 >= NO_RULE) {
+    return NO_RULE;
+  }
+  uint16_t offset = static_cast<uint16_t>(strings.size());
+  strings.insert(strings.end(), text.data(), text.data() + text.length());
+  strings.push_back('\0');
+  return offset;
+}
+
+bool RequestValidator::compileRule(JsonVariantConst schema, uint16_t index,
+                                   uint8_t depth) {
+  if (depth >= MAX_DEPTH || !schema.is<JsonObjectConst>()) {
+    return false;
+  }
+  JsonObjectConst object = schema.as<JsonObjectConst>();
+
+  // Type names; unknown names are schema errors
+  static const struct {
+    const char *name;
+    uint8_t bits;
+  } TYPE_NAMES[] = {{"null", TYPE_NULL},       {"boolean", TYPE_BOOLEAN},
+                    {"integer", TYPE_INTEGER}, {"number", TYPE_NUMBER},
+                    {"string", TYPE_STRING},   {"array", TYPE_ARRAY},
+                    {"object", TYPE_OBJECT}};
+  uint8_t types = 0;
+  JsonVariantConst type = object["type"];
+  size_t typeCount = type.is<JsonArrayConst>() ? type.size() : 1;
+  for (size_t i = 0; i < typeCount && !type.isNull(); i++) {
+    const char *name = type.is<JsonArrayConst>() ? type[i].as<const char *>()
+                                                  : type.as<const char *>();
+    uint8_t bits = 0;
+    for (const auto &entry : TYPE_NAMES) {
+      if (name && strcmp(name, entry.name) == 0) {
+        bits = entry.bits;
+      }
+    }
+    if (!bits) {
+      return false;
+    }
+    types |= bits;
+  }
+  if (types && object["nullable"].as<bool>()) {
+    types |= TYPE_NULL;
+  }
+
+  Rule rule = rules[index];
+  rule.types = types;
+  if (object["minimum"].is<double>()) {
+    rule.flags |= HAS_MINIMUM;
+    rule.minimum = object["minimum"].as<double>();
+  }
+  if (object["maximum"].is<double>()) {
+    rule.flags |= HAS_MAXIMUM;
+    rule.maximum = object["maximum"].as<double>();
+  }
+  JsonVariantConst maxLength = object.containsKey("maxLength")
+                                  ? object["maxLength"]
+                                  : object["maxItems"];
+  if (maxLength.is<double>()) {
+    double limit = maxLength.as<double>();
+    rule.flags |= HAS_MAX_LENGTH;
+    rule.maxLength = limit < 0 ? 0 : limit > 0xFFFF ? 0xFFFF : limit;
+  }
+
+  JsonVariantConst allowed = object["enum"];
+  if (allowed.is<JsonArrayConst>()) {
+    rule.firstEnum = static_cast<uint16_t>(enums.size());
+    for (JsonVariantConst value : allowed.as<JsonArrayConst>()) {
+      EnumValue entry = {NO_RULE, 0};
+      if (value.is<const char *>()) {
+        entry.text = addString(value.as<const char *>());
+        if (entry.text == NO_RULE) {
+          return false;
+        }
+      } else if (value.is<double>()) {
+        entry.number = value.as<double>();
+      } else {
+        return false; // Only string and number enums are supported
+      }
+      enums.push_back(entry);
+    }
+    rule.enumCount = static_cast<uint16_t>(enums.size() - rule.firstEnum);
+  }
+
+  // Properties, then names that are required without being described,
+  // as one run of consecutive child rules
+  JsonObjectConst properties = object["properties"];
+  JsonVariantConst required = object["required"];
+  size_t childCount = properties.size();
+  if (required.is<JsonArrayConst>()) {
+    for (JsonVariantConst name : required.as<JsonArrayConst>()) {
+      if (!name.is<const char *>()) {
+        return false;
+      }
+      if (!properties.containsKey(name.as<const char *>())) {
+        childCount++;
+      }
+    }
+  }
+  if (rules.size() + childCount + 1 >= NO_RULE) {
+    return false;
+  }
+  rule.firstChild = static_cast<uint16_t>(rules.size());
+  rules.resize(rules.size() + childCount);
+
+  std::string parentPath = string(rule.path);
+  auto childPath = [&parentPath](StringView name) {
+    std::string path = parentPath;
+    if (!path.empty()) {
+      path += '.';
+    }
+    path.append(name.data(), name.length());
+    return path;
+  };
+  uint16_t child = rule.firstChild;
+  for (JsonPairConst property : properties) {
+    const char *name = property.key().c_str();
+    std::string path = childPath(name);
+    rules[child].name = addString(name);
+    rules[child].path = addString(StringView(path.data(), path.length()));
+    if (rules[child].path == NO_RULE ||
+        !compileRule(property.value(), child, depth + 1)) {
+      return false;
+    }
+    child++;
+  }
+  if (required.is<JsonArrayConst>()) {
+    for (JsonVariantConst name : required.as<JsonArrayConst>()) {
+      const char *text = name.as<const char *>();
+      uint16_t match = rule.firstChild;
+      while (match < child && strcmp(string(rules[match].name), text) != 0) {
+        match++;
+      }
+      if (match == child) {
+        std::string path = childPath(text);
+        rules[child].name = addString(text);
+        rules[child].path = addString(StringView(path.data(), path.length()));
+        if (rules[child].path == NO_RULE) {
+          return false;
+        }
+        child++;
+      }
+      rules[match].flags |= REQUIRED;
+    }
+  }
+  rule.childCount = static_cast<uint16_t>(child - rule.firstChild);
+
+  JsonVariantConst items = object["items"];
+  if (items.is<JsonObjectConst>()) {
+    rule.items = static_cast<uint16_t>(rules.size());
+    rules.push_back(Rule());
+    std::string path = parentPath + "[]";
+    rules[rule.items].path =
+        addString(StringView(path.data(), path.length()));
+    if (rules[rule.items].path == NO_RULE ||
+        !compileRule(items, rule.items, depth + 1)) {
+      return false;
+    }
+  }
+
+  // Children were compiled into `rules` directly; merge this rule's own
+  // fields back without touching their names and paths
+  uint16_t name = rules[index].name;
+  uint16_t path = rules[index].path;
+  rules[index] = rule;
+  rules[index].name = name;
+  rules[index].path = path;
+  return true;
+}
+
+bool RequestValidator::validate(JsonVariantConst body, Error &error) const {
+  if (rules.empty()) {
+    error.path = "";
+    error.reason = "cannot be validated";
+    return false;
+  }
+  return validateRule(rules[0], body, error);
+}
+
+bool RequestValidator::validateRule(const Rule &rule, JsonVariantConst value,
+                                    Error &error) const {
+  auto fail = [&](const Rule &failed, const char *reason) {
+    error.path = string(failed.path);
+    error.reason = reason;
+    return false;
+  };
+
+  uint8_t actual;
+  if (value.isNull()) {
+    actual = TYPE_NULL;
+  } else if (value.is<bool>()) {
+    actual = TYPE_BOOLEAN;
+  } else if (value.is<double>()) {
+    double number = value.as<double>();
+    actual = number == floor(number) ? TYPE_INTEGER | TYPE_NUMBER
+                                     : TYPE_NUMBER;
+  } else if (value.is<const char *>()) {
+    actual = TYPE_STRING;
+  } else if (value.is<JsonArrayConst>()) {
+    actual = TYPE_ARRAY;
+  } else {
+    actual = TYPE_OBJECT;
+  }
+  if (rule.types && !(rule.types & actual)) {
+    return fail(rule, WRONG_TYPE);
+  }
+
+  if (actual & TYPE_NUMBER) {
+    double number = value.as<double>();
+    if ((rule.flags & HAS_MINIMUM) && number < rule.minimum) {
+      return fail(rule, "is below the minimum");
+    }
+    if ((rule.flags & HAS_MAXIMUM) && number > rule.maximum) {
+      return fail(rule, "is above the maximum");
+    }
+  } else if (actual == TYPE_STRING) {
+    if ((rule.flags & HAS_MAX_LENGTH) &&
+        utf8Length(value.as<const char *>()) > rule.maxLength) {
+      return fail(rule, "is too long");
+    }
+  } else if (actual == TYPE_ARRAY) {
+    JsonArrayConst array = value.as<JsonArrayConst>();
+    if ((rule.flags & HAS_MAX_LENGTH) && array.size() > rule.maxLength) {
+      return fail(rule, "has too many items");
+    }
+    if (rule.items != NO_RULE) {
+      for (JsonVariantConst element : array) {
+        if (!validateRule(rules[rule.items], element, error)) {
+          return false;
+        }
+      }
+    }
+  } else if (actual == TYPE_OBJECT) {
+    JsonObjectConst object = value.as<JsonObjectConst>();
+    for (uint16_t i = 0; i < rule.childCount; i++) {
+      const Rule &child = rules[rule.firstChild + i];
+      const char *name = string(child.name);
+      JsonVariantConst member = object[name];
+      if (member.isNull() && !object.containsKey(name)) {
+        if (child.flags & REQUIRED) {
+          return fail(child, "is required");
+        }
+        continue;
+      }
+      if (!validateRule(child, member, error)) {
+        return false;
+      }
+    }
+  }
+
+  if (rule.enumCount && !matchesEnum(rule, value)) {
+    return fail(rule, "is not an allowed value");
+  }
+  return true;
+}
+
+bool RequestValidator::matchesEnum(const Rule &rule,
+                                   JsonVariantConst value) const {
+  const char *text = value.is<const char *>() ? value.as<const char *>()
+                                              : nullptr;
+  bool number = !text && value.is<double>() && !value.is<bool>();
+  for (uint16_t i = 0; i < rule.enumCount; i++) {
+    const EnumValue &allowed = enums[rule.firstEnum + i];
+    if (allowed.text != NO_RULE) {
+      if (text && strcmp(text, string(allowed.text)) == 0) {
+        return true;
+      }
+    } else if (number && value.as<double>() == allowed.number) {
+      return true;
+    }
+  }
+  return false;
+}
+
+size_t RequestValidator::memoryUsage() const {
+  return rules.capacity() * sizeof(Rule) +
+         enums.capacity() * sizeof(EnumValue) + strings.capacity();
+}
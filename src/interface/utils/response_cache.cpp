@@ -0,0 +1,171 @@
+#include <interface/utils/json_format.h>
+#include <interface/utils/response_cache.h>
+#include <interface/web_request.h>
+
+namespace {
+
+// Key layout: "<path> <method digit><format digit>?name=value&..." so
+// invalidate() can match on the path alone
+const char PATH_END = ' ';
+
+// Wrap-safe millis() comparison
+bool reached(uint32_t nowMs, uint32_t deadline) {
+  return static_cast<int32_t>(nowMs - deadline) >= 0;
+}
+
+} // namespace
+
+ResponseCache::ResponseCache(size_t maxEntries, size_t maxBytes)
+    : maxEntries(maxEntries ? maxEntries : 1), maxBytes(maxBytes),
+      totalBytes(0), useCounter(0) {}
+
+String ResponseCache::key(WebModule::Method method, StringView path,
+                          const WebRequest &request,
+                          const ResponseCachePolicy &policy) {
+  String result;
+  result.reserve(path.length() + 3);
+  for (char c : path) {
+    result += c;
+  }
+  result += PATH_END;
+  result += static_cast<char>('0' + static_cast<int>(method));
+  // Negotiated handlers answer JSON or MessagePack from the same route
+  JsonFormat format =
+      JsonFormats::negotiate(request.headerView(HeaderId::ACCEPT));
+  result += static_cast<char>('0' + static_cast<int>(format));
+
+  StringView params(policy.varyParams);
+  char separator = '?';
+  size_t pos = 0;
+  while (pos < params.length()) {
+    size_t end = params.find(',', pos);
+    if (end == StringView::npos) {
+      end = params.length();
+    }
+    StringView name = params.substr(pos, end - pos);
+    while (!name.empty() && name[0] == ' ') {
+      name = name.substr(1);
+    }
+    if (!name.empty()) {
+      result += separator;
+      for (char c : name) {
+        result += c;
+      }
+      result += '=';
+      for (char c : request.paramView(name)) {
+        result += c;
+      }
+      separator = '&';
+    }
+    pos = end + 1;
+  }
+  return result;
+}
+
+const ResponseCache::Entry *ResponseCache::find(const String &key,
+                                                uint32_t nowMs) {
+  for (size_t i = 0; i < slots.size(); i++) {
+    if (slots[i].key != key) {
+      continue;
+    }
+    if (reached(nowMs, slots[i].expiresAt)) {
+      erase(i);
+      counters.expirations++;
+      break;
+    }
+    slots[i].lastUsed = ++useCounter;
+    counters.hits++;
+    return &slots[i].entry;
+  }
+  counters.misses++;
+  return nullptr;
+}
+
+bool ResponseCache::store(const String &key, Entry entry, uint32_t ttlMs,
+                          uint32_t nowMs) {
+  size_t size = footprint(key, entry);
+  for (size_t i = 0; i < slots.size(); i++) {
+    if (slots[i].key == key) {
+      erase(i);
+      break;
+    }
+  }
+  if (size > maxBytes) {
+    return false;
+  }
+  while (!slots.empty() &&
+         (slots.size() >= maxEntries || totalBytes + size > maxBytes)) {
+    evictLeastRecentlyUsed();
+  }
+
+  Slot slot;
+  slot.key = key;
+  slot.entry = std::move(entry);
+  slot.expiresAt = nowMs + ttlMs;
+  slot.lastUsed = ++useCounter;
+  slot.bytes = size;
+  slots.push_back(std::move(slot));
+  totalBytes += size;
+  counters.stores++;
+  return true;
+}
+
+size_t ResponseCache::invalidate(StringView pathPrefix) {
+  if (pathPrefix.empty()) {
+    size_t dropped = slots.size();
+    clear();
+    counters.invalidations += dropped;
+    return dropped;
+  }
+  bool prefixIsDirectory = pathPrefix[pathPrefix.length() - 1] == '/';
+  size_t dropped = 0;
+  size_t i = 0;
+  while (i < slots.size()) {
+    StringView key(slots[i].key);
+    // "/api/status" covers "/api/status" and "/api/status/x", not
+    // "/api/statusx"
+    bool matches = key.startsWith(pathPrefix) &&
+                   (prefixIsDirectory || key[pathPrefix.length()] == '/' ||
+                    key[pathPrefix.length()] == PATH_END);
+    if (matches) {
+      erase(i);
+      dropped++;
+    } else {
+      i++;
+    }
+  }
+  counters.invalidations += dropped;
+  return dropped;
+}
+
+void ResponseCache::clear() {
+  slots.clear();
+  totalBytes = 0;
+}
+
+size_t ResponseCache::footprint(const String &key, const Entry &entry) {
+  size_t size = key.length() + entry.mimeType.length() + entry.body.length();
+  for (const auto &header : entry.headers) {
+    size += header.first.length() + header.second.length();
+  }
+  return size;
+}
+
+void ResponseCache::erase(size_t index) {
+  totalBytes -= slots[index].bytes;
+  if (index + 1 < slots.size()) {
+    slots[index] = std::move(slots.back());
+  }
+  slots.pop_back();
+}
+
+void ResponseCache::evictLeastRecentlyUsed() {
+  size_t oldest = 0;
+  for (size_t i = 1; i < slots.size(); i++) {
+    if (slots[i].lastUsed < slots[oldest].lastUsed) {
+      oldest = i;
+    }
+  }
+  erase(oldest);
+  counters.evictions++;
+}
@@ -0,0 +1,288 @@
+#include <cstring>
+#include <interface/utils/route_trie.h>
+
+RouteTrie::Node::Node() {
+  for (size_t i = 0; i < METHOD_COUNT; i++) {
+    entries[i] = -1;
+    wildcardEntries[i] = -1;
+  }
+}
+
+String RouteTrie::Match::getParam(const String &name) const {
+  for (size_t i = 0; i < paramCount; i++) {
+    if (params[i].name && name.equals(params[i].name)) {
+      String value;
+      value.reserve(params[i].length);
+      for (size_t j = 0; j < params[i].length; j++) {
+        value += params[i].value[j];
+      }
+      return value;
+    }
+  }
+  return "";
+}
+
+RouteTrie::RouteTrie() : root(new Node()), routeCount(0) {}
+
+RouteTrie::~RouteTrie() = default;
+
+void RouteTrie::clear() {
+  root.reset(new Node());
+  entryTable.clear();
+  routeCount = 0;
+}
+
+RouteTrie::Node *RouteTrie::findChild(const Node *node, char first) {
+  // Scanning the packed index avoids touching every child node
+  const char *indices = node->indices.c_str();
+  for (size_t i = 0; i < node->children.size(); i++) {
+    if (indices[i] == first) {
+      return node->children[i].get();
+    }
+  }
+  return nullptr;
+}
+
+RouteTrie::Node *RouteTrie::insertStatic(Node *node, const char *text,
+                                         size_t length) {
+  while (length > 0) {
+    Node *child = findChild(node, text[0]);
+
+    if (!child) {
+      std::unique_ptr<Node> leaf(new Node());
+      leaf->prefix.reserve(length);
+      for (size_t i = 0; i < length; i++) {
+        leaf->prefix += text[i];
+      }
+      node->indices += text[0];
+      node->children.push_back(std::move(leaf));
+      return node->children.back().get();
+    }
+
+    // Longest common prefix between the existing edge and the new text
+    size_t prefixLength = child->prefix.length();
+    size_t common = 0;
+    while (common < prefixLength && common < length &&
+           child->prefix[common] == text[common]) {
+      common++;
+    }
+
+    if (common < prefixLength) {
+      // Split the edge: child keeps the shared part, tail takes the rest
+      std::unique_ptr<Node> tail(new Node());
+      tail->prefix = child->prefix.substring(common);
+      tail->children.swap(child->children);
+      tail->paramChild.swap(child->paramChild);
+      for (size_t i = 0; i < METHOD_COUNT; i++) {
+        tail->entries[i] = child->entries[i];
+        tail->wildcardEntries[i] = child->wildcardEntries[i];
+        child->entries[i] = -1;
+        child->wildcardEntries[i] = -1;
+      }
+      tail->indices = child->indices;
+      child->indices = String(tail->prefix[0]);
+      child->prefix = child->prefix.substring(0, common);
+      child->children.push_back(std::move(tail));
+    }
+
+    node = child;
+    text += common;
+    length -= common;
+  }
+  return node;
+}
+
+bool RouteTrie::insert(const String &pattern, WebModule::Method method,
+                       int routeId) {
+  size_t methodIndex = static_cast<size_t>(method);
+  if (methodIndex >= METHOD_COUNT || pattern.length() == 0 || routeId < 0) {
+    return false;
+  }
+
+  const char *text = pattern.c_str();
+  size_t length = pattern.length();
+
+  // Validate the whole pattern before touching the trie so a malformed
+  // pattern never leaves half-built branches behind
+  std::vector<String> paramNames;
+  bool wildcard = false;
+  for (size_t i = 0; i < length; i++) {
+    if (text[i] == '{') {
+      int close = pattern.indexOf('}', i);
+      size_t after = static_cast<size_t>(close) + 1;
+      if (close < 0 || after == i + 2 || (i > 0 && text[i - 1] != '/') ||
+          (after < length && text[after] != '/')) {
+        return false;
+      }
+      paramNames.push_back(pattern.substring(i + 1, close));
+      i = close;
+    } else if (text[i] == '*') {
+      if (i + 1 != length || (i > 0 && text[i - 1] != '/')) {
+        return false;
+      }
+      paramNames.push_back("*");
+      wildcard = true;
+    } else if (text[i] == '}') {
+      return false;
+    }
+  }
+  if (paramNames.size() > MAX_PARAMS) {
+    return false;
+  }
+
+  Node *node = root.get();
+  size_t i = 0;
+  while (i < length) {
+    if (text[i] == '{') {
+      if (!node->paramChild) {
+        node->paramChild.reset(new Node());
+      }
+      node = node->paramChild.get();
+      i = pattern.indexOf('}', i) + 1;
+    } else if (text[i] == '*') {
+      break;
+    } else {
+      size_t end = i;
+      while (end < length && text[end] != '{' && text[end] != '*') {
+        end++;
+      }
+      node = insertStatic(node, text + i, end - i);
+      i = end;
+    }
+  }
+
+  int *slot = wildcard ? &node->wildcardEntries[methodIndex]
+                       : &node->entries[methodIndex];
+  if (*slot >= 0) {
+    Entry &existing = entryTable[*slot];
+    existing.pattern = pattern;
+    existing.routeId = routeId;
+    existing.paramNames = paramNames;
+    return true;
+  }
+
+  Entry entry;
+  entry.pattern = pattern;
+  entry.routeId = routeId;
+  entry.paramNames = paramNames;
+  entryTable.push_back(entry);
+  *slot = static_cast<int>(entryTable.size() - 1);
+  routeCount++;
+  return true;
+}
+
+int *RouteTrie::findSlot(const String &pattern, WebModule::Method method) {
+  size_t methodIndex = static_cast<size_t>(method);
+  if (methodIndex >= METHOD_COUNT) {
+    return nullptr;
+  }
+
+  const char *text = pattern.c_str();
+  size_t length = pattern.length();
+  Node *node = root.get();
+  size_t i = 0;
+  while (i < length) {
+    if (text[i] == '{') {
+      int close = pattern.indexOf('}', i);
+      if (close < 0 || !node->paramChild) {
+        return nullptr;
+      }
+      node = node->paramChild.get();
+      i = close + 1;
+    } else if (text[i] == '*') {
+      return &node->wildcardEntries[methodIndex];
+    } else {
+      Node *child = findChild(node, text[i]);
+      size_t prefixLength = child ? child->prefix.length() : 0;
+      if (!child || length - i < prefixLength ||
+          strncmp(text + i, child->prefix.c_str(), prefixLength) != 0) {
+        return nullptr;
+      }
+      node = child;
+      i += prefixLength;
+    }
+  }
+  return &node->entries[methodIndex];
+}
+
+bool RouteTrie::remove(const String &pattern, WebModule::Method method) {
+  int *slot = findSlot(pattern, method);
+  if (!slot || *slot < 0) {
+    return false;
+  }
+  // The entry stays in the table as a tombstone; empty nodes are kept since
+  // routes are rarely removed after boot
+  entryTable[*slot].routeId = -1;
+  *slot = -1;
+  routeCount--;
+  return true;
+}
+
+bool RouteTrie::match(const char *path, size_t length,
+                      WebModule::Method method, Match &result) const {
+  result.routeId = -1;
+  result.pattern = nullptr;
+  result.paramCount = 0;
+  size_t methodIndex = static_cast<size_t>(method);
+  if (!path || methodIndex >= METHOD_COUNT) {
+    return false;
+  }
+  return matchNode(root.get(), path, length, 0, methodIndex, result);
+}
+
+bool RouteTrie::matchNode(const Node *node, const char *path, size_t length,
+                          size_t pos, size_t method, Match &result) const {
+  if (pos == length && node->entries[method] >= 0) {
+    return finishMatch(node->entries[method], result);
+  }
+
+  if (pos < length) {
+    // At most one static child can start with the next character
+    const Node *child = findChild(node, path[pos]);
+    if (child) {
+      size_t prefixLength = child->prefix.length();
+      if (length - pos >= prefixLength &&
+          memcmp(path + pos, child->prefix.c_str(), prefixLength) == 0 &&
+          matchNode(child, path, length, pos + prefixLength, method,
+                    result)) {
+        return true;
+      }
+    }
+
+    if (node->paramChild && result.paramCount < MAX_PARAMS) {
+      size_t end = pos;
+      while (end < length && path[end] != '/') {
+        end++;
+      }
+      if (end > pos) {
+        size_t index = result.paramCount++;
+        result.params[index].value = path + pos;
+        result.params[index].length = end - pos;
+        if (matchNode(node->paramChild.get(), path, length, end, method,
+                      result)) {
+          return true;
+        }
+        result.paramCount = index;
+      }
+    }
+  }
+
+  if (node->wildcardEntries[method] >= 0 && result.paramCount < MAX_PARAMS) {
+    size_t index = result.paramCount++;
+    result.params[index].value = path + pos;
+    result.params[index].length = length - pos;
+    return finishMatch(node->wildcardEntries[method], result);
+  }
+  return false;
+}
+
+bool RouteTrie::finishMatch(int entryIndex, Match &result) const {
+  const Entry &entry = entryTable[entryIndex];
+  result.routeId = entry.routeId;
+  result.pattern = entry.pattern.c_str();
+  for (size_t i = 0; i < result.paramCount && i < entry.paramNames.size();
+       i++) {
+    result.params[i].name = entry.paramNames[i].c_str();
+  }
+  return true;
+}
@@ -1,25 +1,19 @@
+#include <interface/http_headers.h>
 #include <interface/web_request.h>
 #include <web_platform_interface.h>
 
-// Common HTTP headers that should be collected by web servers
+// Common HTTP headers that should be collected by web servers, in HeaderId
+// order
 // Note: Using const char* (non-const array) for WebServer compatibility
-const char *COMMON_HTTP_HEADERS[] = {"Host",
-                                     "User-Agent",
-                                     "Accept",
-                                     "Accept-Language",
-                                     "Accept-Encoding",
-                                     "Content-Type",
-                                     "Content-Length",
-                                     "Authorization",
-                                     "Cookie",
-                                     "X-CSRF-Token",
-                                     "X-Requested-With",
-                                     "Referer",
-                                     "Cache-Control",
-                                     "Connection",
-                                     "Pragma"};
+#define WEB_PLATFORM_HEADER_NAME(id, name) name,
+const char *COMMON_HTTP_HEADERS[] = {
+    WEB_PLATFORM_COMMON_HEADERS(WEB_PLATFORM_HEADER_NAME)};
+#undef WEB_PLATFORM_HEADER_NAME
 const size_t COMMON_HTTP_HEADERS_COUNT =
     sizeof(COMMON_HTTP_HEADERS) / sizeof(COMMON_HTTP_HEADERS[0]);
+static_assert(sizeof(COMMON_HTTP_HEADERS) / sizeof(COMMON_HTTP_HEADERS[0]) ==
+                  HttpHeaders::COUNT,
+              "COMMON_HTTP_HEADERS must match HeaderId");
 
 // Definition of the static IWebPlatformProvider instance
 IWebPlatformProvider *IWebPlatformProvider::instance = nullptr;
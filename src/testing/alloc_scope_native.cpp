@@ -0,0 +1,213 @@
+#ifdef NATIVE_PLATFORM
+
+#include <testing/alloc_scope.h>
+
+#if defined(WEB_PLATFORM_ALLOC_TRACKING) && defined(__GLIBC__)
+
+#include <cerrno>
+#include <malloc.h>
+#include <new>
+
+// glibc supports replacing malloc by defining these symbols; the originals
+// stay reachable under their __libc_ names. Every allocating entry point is
+// replaced so that frees always match a counted allocation.
+extern "C" {
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t count, size_t size);
+void *__libc_realloc(void *ptr, size_t size);
+void *__libc_memalign(size_t alignment, size_t size);
+void __libc_free(void *ptr);
+}
+
+namespace {
+
+uint64_t allocationCount = 0;
+uint64_t allocationBytes = 0;
+uint64_t liveBytes = 0;
+uint64_t peakLiveBytes = 0;
+
+void *track(void *ptr, size_t requested) {
+  if (ptr) {
+    allocationCount++;
+    allocationBytes += requested;
+    liveBytes += malloc_usable_size(ptr);
+    if (liveBytes > peakLiveBytes) {
+      peakLiveBytes = liveBytes;
+    }
+  }
+  return ptr;
+}
+
+void untrack(void *ptr) {
+  if (ptr) {
+    size_t size = malloc_usable_size(ptr);
+    liveBytes -= size < liveBytes ? size : liveBytes;
+  }
+}
+
+void *allocate(size_t size) { return track(__libc_malloc(size), size); }
+
+void *allocateAligned(size_t alignment, size_t size) {
+  return track(__libc_memalign(alignment, size), size);
+}
+
+void release(void *ptr) {
+  untrack(ptr);
+  __libc_free(ptr);
+}
+
+void *allocateOrThrow(size_t size) {
+  void *ptr = allocate(size ? size : 1);
+  if (!ptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void *allocateAlignedOrThrow(size_t size, std::align_val_t alignment) {
+  void *ptr = allocateAligned(static_cast<size_t>(alignment), size ? size : 1);
+  if (!ptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+} // namespace
+
+extern "C" {
+
+void *malloc(size_t size) { return allocate(size); }
+
+void *calloc(size_t count, size_t size) {
+  return track(__libc_calloc(count, size), count * size);
+}
+
+void *realloc(void *ptr, size_t size) {
+  // Measure the old block first: realloc may free it
+  untrack(ptr);
+  void *moved = __libc_realloc(ptr, size);
+  if (!moved && ptr && size) {
+    liveBytes += malloc_usable_size(ptr); // Failed; the old block survives
+    return nullptr;
+  }
+  return track(moved, size);
+}
+
+void free(void *ptr) { release(ptr); }
+
+void *memalign(size_t alignment, size_t size) {
+  return allocateAligned(alignment, size);
+}
+
+void *aligned_alloc(size_t alignment, size_t size) {
+  return allocateAligned(alignment, size);
+}
+
+int posix_memalign(void **out, size_t alignment, size_t size) {
+  void *ptr = allocateAligned(alignment, size);
+  if (!ptr) {
+    return ENOMEM;
+  }
+  *out = ptr;
+  return 0;
+}
+
+void *valloc(size_t size) { return allocateAligned(4096, size); }
+
+} // extern "C"
+
+// operator new is routed straight to the counters rather than through
+// libstdc++'s version, so each C++ allocation is counted exactly once
+
+void *operator new(size_t size) { return allocateOrThrow(size); }
+void *operator new[](size_t size) { return allocateOrThrow(size); }
+void *operator new(size_t size, const std::nothrow_t &) noexcept {
+  return allocate(size ? size : 1);
+}
+void *operator new[](size_t size, const std::nothrow_t &) noexcept {
+  return allocate(size ? size : 1);
+}
+void *operator new(size_t size, std::align_val_t alignment) {
+  return allocateAlignedOrThrow(size, alignment);
+}
+void *operator new[](size_t size, std::align_val_t alignment) {
+  return allocateAlignedOrThrow(size, alignment);
+}
+
+void operator delete(void *ptr) noexcept { release(ptr); }
+void operator delete[](void *ptr) noexcept { release(ptr); }
+void operator delete(void *ptr, size_t) noexcept { release(ptr); }
+void operator delete[](void *ptr, size_t) noexcept { release(ptr); }
+void operator delete(void *ptr, const std::nothrow_t &) noexcept {
+  release(ptr);
+}
+void operator delete[](void *ptr, const std::nothrow_t &) noexcept {
+  release(ptr);
+}
+void operator delete(void *ptr, std::align_val_t) noexcept { release(ptr); }
+void operator delete[](void *ptr, std::align_val_t) noexcept { release(ptr); }
+void operator delete(void *ptr, size_t, std::align_val_t) noexcept {
+  release(ptr);
+}
+void operator delete[](void *ptr, size_t, std::align_val_t) noexcept {
+  release(ptr);
+}
+
+bool allocTrackingAvailable() { return true; }
+
+AllocStats allocTotals() {
+  AllocStats totals;
+  totals.count = allocationCount;
+  totals.bytes = allocationBytes;
+  totals.peakLiveBytes = peakLiveBytes;
+  return totals;
+}
+
+uint64_t allocLiveBytes() { return liveBytes; }
+
+AllocScope::AllocScope()
+    : startCount(allocationCount), startBytes(allocationBytes),
+      startLive(liveBytes), outerPeak(peakLiveBytes), stopped(false) {
+  peakLiveBytes = liveBytes;
+}
+
+AllocScope::~AllocScope() {
+  if (outerPeak > peakLiveBytes) {
+    peakLiveBytes = outerPeak;
+  }
+}
+
+AllocStats AllocScope::stats() const {
+  if (stopped) {
+    return frozen;
+  }
+  AllocStats delta;
+  delta.count = allocationCount - startCount;
+  delta.bytes = allocationBytes - startBytes;
+  delta.peakLiveBytes =
+      peakLiveBytes > startLive ? peakLiveBytes - startLive : 0;
+  return delta;
+}
+
+#else // Counting unavailable: scopes report zeros
+
+bool allocTrackingAvailable() { return false; }
+AllocStats allocTotals() { return AllocStats(); }
+uint64_t allocLiveBytes() { return 0; }
+
+AllocScope::AllocScope()
+    : startCount(0), startBytes(0), startLive(0), outerPeak(0),
+      stopped(false) {}
+AllocScope::~AllocScope() {}
+AllocStats AllocScope::stats() const { return AllocStats(); }
+
+#endif
+
+void AllocScope::stop() {
+  if (!stopped) {
+    frozen = stats();
+    stopped = true;
+  }
+}
+
+#endif // NATIVE_PLATFORM
@@ -0,0 +1,152 @@
+#if defined(NATIVE_PLATFORM) && defined(__linux__)
+// Host filesystem storage driver with memory-mapped reads
+
+#include <fcntl.h>
+#include <interface/utils/etag.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <testing/native_storage_driver.h>
+#include <unistd.h>
+
+namespace {
+
+bool isPathSegment(const String &name) {
+  return name.length() > 0 && name != "." && name != ".." &&
+         strchr(name.c_str(), '/') == nullptr;
+}
+
+} // namespace
+
+NativeFileStorageDriver::NativeFileStorageDriver(const std::string &root,
+                                                 bool useMmap)
+    : root(root), useMmap(useMmap) {}
+
+NativeFileStorageDriver::~NativeFileStorageDriver() {
+  for (size_t i = 0; i < files.size(); i++) {
+    close(static_cast<Handle>(i));
+  }
+}
+
+IStorageDriver::Handle NativeFileStorageDriver::open(const String &collection,
+                                                     const String &key) {
+  if (!isPathSegment(collection) || !isPathSegment(key)) {
+    return INVALID_HANDLE;
+  }
+  std::string path = root + "/" + collection.c_str() + "/" + key.c_str();
+  int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return INVALID_HANDLE;
+  }
+  struct stat info;
+  if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) {
+    ::close(fd);
+    return INVALID_HANDLE;
+  }
+
+  OpenFile file;
+  file.fd = fd;
+  file.size = static_cast<size_t>(info.st_size);
+  const uint64_t stamp[] = {
+      static_cast<uint64_t>(info.st_ino), static_cast<uint64_t>(info.st_size),
+      static_cast<uint64_t>(info.st_mtim.tv_sec),
+      static_cast<uint64_t>(info.st_mtim.tv_nsec)};
+  ETag::Hasher hasher;
+  hasher.update(reinterpret_cast<const char *>(stamp), sizeof(stamp));
+  file.version = hasher.digest();
+  if (useMmap && file.size > 0) {
+    void *map = mmap(nullptr, file.size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (map != MAP_FAILED) {
+      madvise(map, file.size, MADV_SEQUENTIAL);
+      file.map = static_cast<const uint8_t *>(map);
+    }
+  }
+
+  for (size_t i = 0; i < files.size(); i++) {
+    if (files[i].fd < 0) {
+      files[i] = file;
+      return static_cast<Handle>(i);
+    }
+  }
+  files.push_back(file);
+  return static_cast<Handle>(files.size() - 1);
+}
+
+size_t NativeFileStorageDriver::size(Handle handle) const {
+  const OpenFile *file = find(handle);
+  return file ? file->size : 0;
+}
+
+bool NativeFileStorageDriver::seek(Handle handle, size_t offset) {
+  OpenFile *file = find(handle);
+  if (!file || offset > file->size) {
+    return false;
+  }
+  file->position = offset;
+  return true;
+}
+
+size_t NativeFileStorageDriver::read(Handle handle, uint8_t *buffer,
+                                     size_t length) {
+  OpenFile *file = find(handle);
+  if (!file || file->position >= file->size) {
+    return 0;
+  }
+  if (length > file->size - file->position) {
+    length = file->size - file->position;
+  }
+  if (file->map) {
+    memcpy(buffer, file->map + file->position, length);
+  } else {
+    ssize_t count = pread(file->fd, buffer, length, file->position);
+    length = count > 0 ? static_cast<size_t>(count) : 0;
+  }
+  file->position += length;
+  return length;
+}
+
+void NativeFileStorageDriver::close(Handle handle) {
+  OpenFile *file = find(handle);
+  if (!file) {
+    return;
+  }
+  if (file->map) {
+    munmap(const_cast<uint8_t *>(file->map), file->size);
+  }
+  ::close(file->fd);
+  *file = OpenFile();
+}
+
+const uint8_t *NativeFileStorageDriver::contiguousView(Handle handle) const {
+  const OpenFile *file = find(handle);
+  return file ? file->map : nullptr;
+}
+
+String NativeFileStorageDriver::etag(Handle handle) const {
+  const OpenFile *file = find(handle);
+  return file ? ETag::format(file->version) : String();
+}
+
+size_t NativeFileStorageDriver::openCount() const {
+  size_t count = 0;
+  for (const OpenFile &file : files) {
+    count += file.fd >= 0 ? 1 : 0;
+  }
+  return count;
+}
+
+NativeFileStorageDriver::OpenFile *
+NativeFileStorageDriver::find(Handle handle) {
+  if (handle < 0 || static_cast<size_t>(handle) >= files.size() ||
+      files[handle].fd < 0) {
+    return nullptr;
+  }
+  return &files[handle];
+}
+
+const NativeFileStorageDriver::OpenFile *
+NativeFileStorageDriver::find(Handle handle) const {
+  return const_cast<NativeFileStorageDriver *>(this)->find(handle);
+}
+
+#endif // NATIVE_PLATFORM && __linux__
@@ -0,0 +1,1012 @@
+#if defined(NATIVE_PLATFORM) && defined(__linux__)
+// Loopback HTTP server implementing IWebPlatform on Linux hosts
+
+#include <arpa/inet.h>
+#include <chrono>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <testing/native_web_platform.h>
+#include <unistd.h>
+
+namespace {
+
+const size_t MAX_EVENTS = 64;
+const size_t READ_CHUNK = 16 * 1024;
+const size_t STORAGE_CHUNK = 16 * 1024;
+
+const char *reasonPhrase(int statusCode) {
+  switch (statusCode) {
+  case 200:
+    return "OK";
+  case 201:
+    return "Created";
+  case 204:
+    return "No Content";
+  case 206:
+    return "Partial Content";
+  case 301:
+    return "Moved Permanently";
+  case 302:
+    return "Found";
+  case 304:
+    return "Not Modified";
+  case 400:
+    return "Bad Request";
+  case 401:
+    return "Unauthorized";
+  case 403:
+    return "Forbidden";
+  case 404:
+    return "Not Found";
+  case 413:
+    return "Payload Too Large";
+  case 416:
+    return "Range Not Satisfiable";
+  case 431:
+    return "Request Header Fields Too Large";
+  case 500:
+    return "Internal Server Error";
+  case 501:
+    return "Not Implemented";
+  default:
+    return "Unknown";
+  }
+}
+
+bool setNonBlocking(int fd) {
+  int flags = fcntl(fd, F_GETFL, 0);
+  return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+// Length of the complete request starting at `offset`, 0 while more bytes
+// are needed. Oversized requests set `errorStatus` (431 or 413).
+size_t completeRequestLength(const std::string &input, size_t offset,
+                             int &errorStatus) {
+  errorStatus = 0;
+  size_t headerEnd = input.find("\r\n\r\n", offset);
+  if (headerEnd == std::string::npos) {
+    if (input.size() - offset > NativeWebPlatform::MAX_HEADER_BYTES) {
+      errorStatus = 431;
+    }
+    return 0;
+  }
+  headerEnd += 4;
+
+  // Only Content-Length framing; chunked request bodies are not supported
+  size_t contentLength = 0;
+  StringView headers(input.data() + offset, headerEnd - offset);
+  size_t pos = 0;
+  while (pos < headers.length()) {
+    size_t lineEnd = headers.find('\n', pos);
+    if (lineEnd == StringView::npos) {
+      break;
+    }
+    StringView line = headers.substr(pos, lineEnd - pos);
+    static const StringView CONTENT_LENGTH("content-length:", 15);
+    if (line.length() > CONTENT_LENGTH.length() &&
+        line.substr(0, CONTENT_LENGTH.length())
+            .equalsIgnoreCase(CONTENT_LENGTH)) {
+      for (char c : line.substr(CONTENT_LENGTH.length())) {
+        if (c >= '0' && c <= '9') {
+          contentLength = contentLength * 10 + (c - '0');
+          if (contentLength > NativeWebPlatform::MAX_BODY_BYTES) {
+            errorStatus = 413;
+            return 0;
+          }
+        } else if (c != ' ' && c != '\t') {
+          break;
+        }
+      }
+    }
+    pos = lineEnd + 1;
+  }
+
+  size_t total = headerEnd - offset + contentLength;
+  return input.size() - offset >= total ? total : 0;
+}
+
+bool wantsKeepAlive(const WebRequest &request, StringView rawRequest) {
+  StringView connection = request.headerView(HeaderId::CONNECTION);
+  if (connection.equalsIgnoreCase("close")) {
+    return false;
+  }
+  if (connection.equalsIgnoreCase("keep-alive")) {
+    return true;
+  }
+  // HTTP/1.0 closes unless asked otherwise
+  StringView requestLine = rawRequest.substr(0, rawRequest.find('\r'));
+  static const StringView HTTP_10("HTTP/1.0", 8);
+  return !(requestLine.length() >= HTTP_10.length() &&
+           requestLine.substr(requestLine.length() - HTTP_10.length()) ==
+               HTTP_10);
+}
+
+// HEAD is routed as GET and answered without the body. Methods with no
+// WebModule::Method (OPTIONS, unknown tokens) are never routed.
+enum class RequestMethod : uint8_t { ROUTED, HEAD, UNSUPPORTED };
+
+RequestMethod requestMethod(StringView rawRequest) {
+  StringView token = rawRequest.substr(0, rawRequest.find(' '));
+  if (token == "HEAD") {
+    return RequestMethod::HEAD;
+  }
+  if (token == "GET" || token == "POST" || token == "PUT" ||
+      token == "DELETE" || token == "PATCH") {
+    return RequestMethod::ROUTED;
+  }
+  return RequestMethod::UNSUPPORTED;
+}
+
+void appendString(std::string &out, const String &text) {
+  out.append(text.c_str(), text.length());
+}
+
+// millis() is an ArduinoFake mock on the host; use the real clock
+unsigned long nowMs() {
+  return static_cast<unsigned long>(
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+}
+
+void appendStatusLine(std::string &out, int statusCode) {
+  char line[64];
+  int length = snprintf(line, sizeof(line), "HTTP/1.1 %d %s\r\n",
+                        statusCode, reasonPhrase(statusCode));
+  out.append(line, length);
+}
+
+void appendHeader(std::string &out, const String &name, const String &value) {
+  appendString(out, name);
+  out += ": ";
+  appendString(out, value);
+  out += "\r\n";
+}
+
+void appendConnection(std::string &out, bool keepAlive) {
+  out += keepAlive ? "Connection: keep-alive\r\n" : "Connection: close\r\n";
+}
+
+// Content-Length and the blank line ending the headers
+void appendContentLength(std::string &out, size_t length) {
+  char line[64];
+  int lineLength =
+      snprintf(line, sizeof(line), "Content-Length: %zu\r\n\r\n", length);
+  out.append(line, lineLength);
+}
+
+void appendBody(std::string &out, const char *body, size_t length) {
+  appendContentLength(out, length);
+  out.append(body, length);
+}
+
+} // namespace
+
+NativeWebPlatform::NativeWebPlatform(uint16_t port)
+    : port(port), listenFd(-1), epollFd(-1), running(false),
+      requestCount(0) {}
+
+NativeWebPlatform::~NativeWebPlatform() {
+  for (auto &entry : connections) {
+    entry.second.body.release();
+    close(entry.first);
+  }
+  if (listenFd >= 0) {
+    close(listenFd);
+  }
+  if (epollFd >= 0) {
+    close(epollFd);
+  }
+}
+
+void NativeWebPlatform::begin(const String &name) {
+  deviceName = name;
+  if (listenFd >= 0) {
+    return;
+  }
+
+  listenFd = socket(AF_INET, SOCK_STREAM, 0);
+  int reuse = 1;
+  setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+  sockaddr_in address = {};
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  address.sin_port = htons(port);
+  socklen_t addressLength = sizeof(address);
+  if (listenFd < 0 ||
+      bind(listenFd, reinterpret_cast<sockaddr *>(&address),
+           sizeof(address)) != 0 ||
+      listen(listenFd, SOMAXCONN) != 0 || !setNonBlocking(listenFd) ||
+      getsockname(listenFd, reinterpret_cast<sockaddr *>(&address),
+                  &addressLength) != 0) {
+    fprintf(stderr, "NativeWebPlatform: cannot listen on port %u: %s\n",
+            static_cast<unsigned>(port), strerror(errno));
+    if (listenFd >= 0) {
+      close(listenFd);
+      listenFd = -1;
+    }
+    return;
+  }
+  port = ntohs(address.sin_port);
+
+  epollFd = epoll_create1(0);
+  epoll_event event = {};
+  event.events = EPOLLIN;
+  event.data.fd = listenFd;
+  epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &event);
+}
+
+void NativeWebPlatform::handle() {
+  poll(0);
+  for (const auto &entry : modules) {
+    entry.second->handle();
+  }
+}
+
+String NativeWebPlatform::getBaseUrl() const {
+  return "http://127.0.0.1:" + String(static_cast<int>(port));
+}
+
+void NativeWebPlatform::registerModule(const String &basePath,
+                                       IWebModule *module) {
+  if (!module) {
+    return;
+  }
+  modules.push_back(std::make_pair(basePath, module));
+  // No TLS here: HTTPS routes are served over plain HTTP as well. A route
+  // in both sets is registered twice and the second copy replaces the first.
+  IWebModule::RouteVisitor visitor = [this,
+                                      &basePath](const RouteVariant &route) {
+    addRoute(RouteTable::moduleRoute(basePath, route));
+  };
+  module->forEachRoute(visitor, WebModule::TRANSPORT_HTTP);
+  module->forEachRoute(visitor, WebModule::TRANSPORT_HTTPS);
+}
+
+void NativeWebPlatform::invalidateResponseCache(IWebModule *module,
+                                                const String &routePath) {
+  // Joined like RouteTable::moduleRoute(); the path is dropped in both
+  // its WebRoute and /api forms since either kind may sit under it
+  for (const auto &entry : modules) {
+    if (entry.second == module) {
+      String path = RouteTable::joinPath(entry.first, routePath);
+      responseCache.invalidate(path);
+      responseCache.invalidate(RouteTable::apiPath(path));
+    }
+  }
+}
+
+void NativeWebPlatform::registerWebRoute(
+    const String &path, WebModule::UnifiedRouteHandler handler,
+    const AuthRequirements &auth, WebModule::Method method) {
+  addRoute(RouteTable::Route{path, method, handler, auth, false});
+}
+
+void NativeWebPlatform::registerApiRoute(
+    const String &path, WebModule::UnifiedRouteHandler handler,
+    const AuthRequirements &auth, WebModule::Method method,
+    const OpenAPIDocumentation &docs) {
+  RouteTable::Route route{RouteTable::apiPath(path), method, handler, auth,
+                         true};
+  route.docs = docs;
+  addRoute(route);
+}
+
+void NativeWebPlatform::addRoute(const RouteTable::Route &route) {
+  if (!routeTable.add(route)) {
+    fprintf(stderr, "NativeWebPlatform: route '%s' is malformed, a "
+                    "duplicate or has an invalid request schema\n",
+            route.path.c_str());
+  }
+}
+
+void NativeWebPlatform::createJsonResponse(
+    WebResponse &res, std::function<void(JsonObject &)> builder) {
+  StringView route = JsonDocumentPool::routeKey(res.getBoundRequest());
+  setPooledJson(res, jsonPool.build<JsonObject>(route, builder));
+}
+
+void NativeWebPlatform::createJsonArrayResponse(
+    WebResponse &res, std::function<void(JsonArray &)> builder) {
+  StringView route = JsonDocumentPool::routeKey(res.getBoundRequest());
+  setPooledJson(res, jsonPool.build<JsonArray>(route, builder));
+}
+
+void NativeWebPlatform::setPooledJson(
+    WebResponse &res, const JsonDocumentPool::Lease &lease) const {
+  if (lease.overflowed()) {
+    // Truncated JSON would look like a valid, incomplete answer
+    sendError(res, 500, "Response too large");
+    return;
+  }
+  res.setNegotiatedJsonContent(lease.document());
+}
+
+bool NativeWebPlatform::writeOpenApiSpec(JsonStreamWriter &writer) const {
+  std::vector<OpenAPISpecWriter::Operation> operations;
+  routeTable.openApiOperations(operations);
+  String serverUrl = getBaseUrl();
+  OpenAPISpecWriter::Info info;
+  info.title = deviceName.length() ? deviceName.c_str() : info.title;
+  info.serverUrl = serverUrl.c_str();
+  return OpenAPISpecWriter::write(writer, info, operations);
+}
+
+void NativeWebPlatform::addApiToken(const String &token,
+                                    const String &username) {
+  apiTokens.push_back(Credential{token, username});
+}
+
+void NativeWebPlatform::addSession(const String &sessionId,
+                                   const String &username) {
+  sessions.push_back(Credential{sessionId, username});
+}
+
+void NativeWebPlatform::addPageToken(const String &token) {
+  pageTokens.push_back(token);
+}
+
+void NativeWebPlatform::run() {
+  running = true;
+  while (running && poll(100)) {
+    for (const auto &entry : modules) {
+      entry.second->handle();
+    }
+  }
+}
+
+bool NativeWebPlatform::poll(int timeoutMs) {
+  if (epollFd < 0) {
+    return false;
+  }
+  epoll_event events[MAX_EVENTS];
+  int count = epoll_wait(epollFd, events, MAX_EVENTS, timeoutMs);
+  for (int i = 0; i < count; i++) {
+    int fd = events[i].data.fd;
+    if (fd == listenFd) {
+      acceptConnections();
+      continue;
+    }
+    auto it = connections.find(fd);
+    if (it == connections.end()) {
+      continue;
+    }
+    if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+      readFrom(fd, it->second);
+    } else if (events[i].events & EPOLLOUT) {
+      writeTo(fd, it->second);
+    }
+  }
+  return count >= 0 || errno == EINTR;
+}
+
+void NativeWebPlatform::acceptConnections() {
+  while (true) {
+    sockaddr_in peer = {};
+    socklen_t peerLength = sizeof(peer);
+    int fd = accept(listenFd, reinterpret_cast<sockaddr *>(&peer), &peerLength);
+    if (fd < 0) {
+      return; // EAGAIN: backlog drained
+    }
+    setNonBlocking(fd);
+    int noDelay = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+
+    Connection &connection = connections[fd];
+    char ip[INET_ADDRSTRLEN] = "";
+    inet_ntop(AF_INET, &peer.sin_addr, ip, sizeof(ip));
+    connection.clientIp = ip;
+
+    epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.fd = fd;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event);
+  }
+}
+
+void NativeWebPlatform::readFrom(int fd, Connection &connection) {
+  char buffer[READ_CHUNK];
+  while (true) {
+    ssize_t received = recv(fd, buffer, sizeof(buffer), 0);
+    if (received > 0) {
+      connection.input.append(buffer, received);
+      continue;
+    }
+    if (received == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) {
+      closeConnection(fd); // Peer closed or failed
+      return;
+    }
+    break;
+  }
+  processInput(connection);
+  writeTo(fd, connection);
+}
+
+void NativeWebPlatform::processInput(Connection &connection) {
+  // Pipelined requests are answered in order
+  size_t offset = 0;
+  while (!connection.closeAfterWrite && !connection.body.pending() &&
+         offset < connection.input.size()) {
+    int errorStatus = 0;
+    size_t length =
+        completeRequestLength(connection.input, offset, errorStatus);
+    if (errorStatus != 0) {
+      WebResponse response;
+      sendError(response, errorStatus, reasonPhrase(errorStatus));
+      serialize(response, false, connection.output);
+      connection.closeAfterWrite = true;
+      break;
+    }
+    if (length == 0) {
+      break;
+    }
+    bool keepAlive = true;
+    respond(connection.input.data() + offset, length, keepAlive,
+            connection.clientIp, connection.output, &connection.body);
+    connection.closeAfterWrite = !keepAlive;
+    offset += length;
+  }
+  connection.input.erase(0, offset);
+}
+
+void NativeWebPlatform::writeTo(int fd, Connection &connection) {
+  StorageBody &body = connection.body;
+  while (connection.outputSent < connection.output.size() ||
+         body.sent < body.length) {
+    // Buffered headers/bodies, then the storage body from driver memory
+    iovec parts[2];
+    msghdr message = {};
+    message.msg_iov = parts;
+    if (connection.outputSent < connection.output.size()) {
+      parts[message.msg_iovlen].iov_base = const_cast<char *>(
+          connection.output.data() + connection.outputSent);
+      parts[message.msg_iovlen].iov_len =
+          connection.output.size() - connection.outputSent;
+      message.msg_iovlen++;
+    }
+    if (body.sent < body.length) {
+      parts[message.msg_iovlen].iov_base =
+          const_cast<uint8_t *>(body.data + body.sent);
+      parts[message.msg_iovlen].iov_len = body.length - body.sent;
+      message.msg_iovlen++;
+    }
+
+    ssize_t sent = sendmsg(fd, &message, MSG_NOSIGNAL);
+    if (sent > 0) {
+      size_t buffered = connection.output.size() - connection.outputSent;
+      size_t fromOutput = static_cast<size_t>(sent) < buffered
+                              ? static_cast<size_t>(sent)
+                              : buffered;
+      connection.outputSent += fromOutput;
+      body.sent += static_cast<size_t>(sent) - fromOutput;
+      continue;
+    }
+    if (errno == EAGAIN || errno == EWOULDBLOCK) {
+      if (!connection.wantWrite) {
+        epoll_event event = {};
+        event.events = EPOLLIN | EPOLLOUT;
+        event.data.fd = fd;
+        epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &event);
+        connection.wantWrite = true;
+      }
+      return;
+    }
+    closeConnection(fd);
+    return;
+  }
+
+  connection.output.clear();
+  connection.outputSent = 0;
+  bool heldInput = body.pending() && !connection.input.empty();
+  body.release();
+  if (connection.closeAfterWrite) {
+    closeConnection(fd);
+    return;
+  }
+  if (heldInput) {
+    // Pipelined requests that waited behind the storage body
+    processInput(connection);
+    writeTo(fd, connection);
+    return;
+  }
+  if (connection.wantWrite) {
+    epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.fd = fd;
+    epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &event);
+    connection.wantWrite = false;
+  }
+}
+
+void NativeWebPlatform::closeConnection(int fd) {
+  auto it = connections.find(fd);
+  if (it != connections.end()) {
+    it->second.body.release();
+  }
+  epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+  close(fd);
+  connections.erase(fd);
+}
+
+std::string NativeWebPlatform::handleRawRequest(const char *rawRequest,
+                                                size_t length,
+                                                bool &keepAlive,
+                                                const String &clientIp) {
+  std::string out;
+  respond(rawRequest, length, keepAlive, clientIp, out, nullptr);
+  return out;
+}
+
+void NativeWebPlatform::respond(const char *rawRequest, size_t length,
+                                bool &keepAlive, const String &clientIp,
+                                std::string &out, StorageBody *body) {
+  WebRequest request(rawRequest, length, clientIp);
+  WebResponse response;
+  response.bindRequest(request);
+  RequestMethod method = requestMethod(StringView(rawRequest, length));
+  ResponseCompressionPolicy compression;
+  const ResponseCache::Entry *cached = nullptr;
+  if (method == RequestMethod::UNSUPPORTED) {
+    sendError(response, 501, "Not implemented");
+  } else {
+    cached = dispatch(request, response, compression);
+  }
+  requestCount++;
+
+  keepAlive = wantsKeepAlive(request, StringView(rawRequest, length));
+  if (!compression.enabled()) {
+    compression = responseCompression;
+  }
+  size_t start = out.size();
+  if (cached) {
+    serialize(*cached, request, keepAlive, out);
+  } else if (response.isStorageStreamContent) {
+    serializeStorage(response, keepAlive, out, body);
+  } else if (compressible(request, response, compression)) {
+    serializeCompressed(response, keepAlive, compression, out);
+  } else {
+    serialize(response, keepAlive, out);
+  }
+
+  if (method == RequestMethod::HEAD) {
+    // The GET headers, Content-Length included, without the body
+    size_t headerEnd = out.find("\r\n\r\n", start);
+    if (headerEnd != std::string::npos) {
+      out.resize(headerEnd + 4);
+    }
+    if (body) {
+      body->release();
+    }
+  }
+}
+
+const ResponseCache::Entry *
+NativeWebPlatform::dispatch(WebRequest &request, WebResponse &response,
+                            ResponseCompressionPolicy &compression) {
+  StringView path = request.pathView();
+  if (!redirects.empty()) {
+    auto redirect = redirects.find(path.toString());
+    if (redirect != redirects.end()) {
+      response.redirect(redirect->second);
+      return nullptr;
+    }
+  }
+
+  RouteTrie::Match match;
+  const RouteTable::Route *route =
+      routeTable.find(path.data(), path.length(), request.getMethod(), match);
+  if (!route) {
+#if OPENAPI_ENABLED
+    if (request.getMethod() == WebModule::WM_GET &&
+        path == OpenAPISpecWriter::SPEC_PATH) {
+      response.setJsonStreamContent(
+          [this](JsonStreamWriter &writer) { writeOpenApiSpec(writer); });
+      return nullptr;
+    }
+#endif
+    sendError(response, 404, "Not found");
+    return nullptr;
+  }
+  if (!authorize(route->auth, request)) {
+    sendError(response, 401, "Authentication required");
+    return nullptr;
+  }
+  RequestValidator::Error invalid;
+  if (route->validator &&
+      !route->validator->validate(request.getJsonBody(), invalid)) {
+    String message = "Invalid request body: ";
+    message += *invalid.path ? invalid.path : "body";
+    message += " ";
+    message += invalid.reason;
+    sendError(response, 400, message.c_str());
+    return nullptr;
+  }
+
+  bool cacheable = route->cachePolicy.enabled() &&
+                   request.getMethod() == WebModule::WM_GET;
+  String cacheKey;
+  if (cacheable) {
+    cacheKey = ResponseCache::key(request.getMethod(), path, request,
+                                  route->cachePolicy);
+    const ResponseCache::Entry *entry = responseCache.find(cacheKey, nowMs());
+    if (entry) {
+      return entry;
+    }
+  }
+
+  compression = route->compressionPolicy;
+  request.setMatchedRoute(match.pattern);
+  route->handler(request, response);
+  tagProgmemContent(response);
+  if (cacheable && !response.isStorageStreamContent) {
+    storeInCache(cacheKey, route->cachePolicy, response);
+  }
+  return nullptr;
+}
+
+void NativeWebPlatform::storeInCache(const String &key,
+                                     const ResponseCachePolicy &policy,
+                                     const WebResponse &response) {
+  // Only complete successes, never per-client state, and nothing that
+  // varies by request headers the key does not include (Accept is keyed
+  // through the negotiated format)
+  auto vary = response.headers.find("Vary");
+  if (response.statusCode != 200 ||
+      response.headers.find("Set-Cookie") != response.headers.end() ||
+      (vary != response.headers.end() &&
+       !vary->second.equalsIgnoreCase("Accept"))) {
+    return;
+  }
+  ResponseCache::Entry entry;
+  entry.statusCode = response.statusCode;
+  entry.mimeType = response.mimeType;
+  entry.body = response.getContent();
+  for (const auto &header : response.headers) {
+    entry.headers.push_back(header);
+  }
+  responseCache.store(key, std::move(entry), policy.ttlMs, nowMs());
+}
+
+void NativeWebPlatform::tagProgmemContent(WebResponse &response) {
+  if (!response.isProgmemContent || !response.progmemData ||
+      response.statusCode != 200 ||
+      response.headers.find("ETag") != response.headers.end()) {
+    return;
+  }
+  auto tagged = progmemETags.find(response.progmemData);
+  if (tagged == progmemETags.end()) {
+    String etag = ETag::compute(
+        reinterpret_cast<const uint8_t *>(response.progmemData),
+        response.getProgmemLength());
+    tagged = progmemETags.emplace(response.progmemData, etag).first;
+  }
+  response.setETag(tagged->second);
+}
+
+bool NativeWebPlatform::authorize(const AuthRequirements &auth,
+                                  WebRequest &request) const {
+  if (!auth.requiresAuth()) {
+    return true;
+  }
+
+  AuthContext context;
+  if (auth.has(AuthType::TOKEN)) {
+    static const StringView BEARER("Bearer ", 7);
+    StringView header = request.headerView(HeaderId::AUTHORIZATION);
+    if (header.startsWith(BEARER)) {
+      StringView token = header.substr(BEARER.length());
+      for (const Credential &credential : apiTokens) {
+        if (token == StringView(credential.secret)) {
+          context.isAuthenticated = true;
+          context.authenticatedVia = AuthType::TOKEN;
+          context.token = credential.secret;
+          context.username = credential.username;
+          break;
+        }
+      }
+    }
+  }
+  if (!context.isAuthenticated && auth.has(AuthType::SESSION)) {
+    // Cookie: a=1; session=<id>; b=2
+    static const StringView SESSION("session=", 8);
+    StringView cookies = request.headerView(HeaderId::COOKIE);
+    size_t pos = 0;
+    while (pos < cookies.length() && !context.isAuthenticated) {
+      size_t end = cookies.find(';', pos);
+      if (end == StringView::npos) {
+        end = cookies.length();
+      }
+      StringView cookie = cookies.substr(pos, end - pos);
+      while (!cookie.empty() && cookie[0] == ' ') {
+        cookie = cookie.substr(1);
+      }
+      if (cookie.startsWith(SESSION)) {
+        StringView id = cookie.substr(SESSION.length());
+        for (const Credential &credential : sessions) {
+          if (id == StringView(credential.secret)) {
+            context.isAuthenticated = true;
+            context.authenticatedVia = AuthType::SESSION;
+            context.sessionId = credential.secret;
+            context.username = credential.username;
+            break;
+          }
+        }
+      }
+      pos = end + 1;
+    }
+  }
+  if (!context.isAuthenticated && auth.has(AuthType::PAGE_TOKEN)) {
+    StringView token = request.headerView(HeaderId::X_CSRF_TOKEN);
+    for (const String &pageToken : pageTokens) {
+      if (!token.empty() && token == StringView(pageToken)) {
+        context.isAuthenticated = true;
+        context.authenticatedVia = AuthType::PAGE_TOKEN;
+        break;
+      }
+    }
+  }
+
+  if (context.isAuthenticated) {
+    context.authenticatedAt = nowMs();
+    request.setAuthContext(context);
+    return true;
+  }
+  // Every client of a loopback server is local
+  return auth.has(AuthType::LOCAL_ONLY);
+}
+
+void NativeWebPlatform::sendError(WebResponse &response, int statusCode,
+                                  const char *message) const {
+  response.setStatus(statusCode);
+  auto page = errorPages.find(statusCode);
+  if (page != errorPages.end()) {
+    response.setContent(page->second, "text/html");
+    return;
+  }
+  String body = "{\"success\":false,\"error\":\"";
+  body += message;
+  body += "\"}";
+  response.setContent(body, "application/json");
+}
+
+void NativeWebPlatform::serialize(const WebResponse &response, bool keepAlive,
+                                  std::string &out) {
+  // Streamed JSON with a weak ETag is hashed in a first pass, so a matching
+  // If-None-Match is answered without sending the body
+  int statusCode = response.statusCode;
+  String streamETag;
+  if (response.isJsonStreamContent && response.jsonStreamETag &&
+      statusCode == 200) {
+    streamETag = response.computeJsonStreamETag();
+    if (response.requestHasETag(streamETag)) {
+      statusCode = 304;
+    }
+  }
+
+  appendStatusLine(out, statusCode);
+  for (const auto &header : response.headers) {
+    appendHeader(out, header.first, header.second);
+  }
+  if (streamETag.length() > 0) {
+    appendHeader(out, "ETag", streamETag);
+  }
+  if (statusCode == 304) {
+    appendConnection(out, keepAlive);
+    out += "\r\n";
+    return;
+  }
+  if (response.mimeType.length() > 0) {
+    appendHeader(out, "Content-Type", response.mimeType);
+  }
+  appendConnection(out, keepAlive);
+
+  if (response.isJsonStreamContent) {
+    out += "Transfer-Encoding: chunked\r\n\r\n";
+    response.writeJsonStream([&out](const char *data, size_t length) {
+      char size[20];
+      int sizeLength = snprintf(size, sizeof(size), "%zx\r\n", length);
+      out.append(size, sizeLength);
+      out.append(data, length);
+      out += "\r\n";
+      return true;
+    });
+    out += "0\r\n\r\n";
+    return;
+  }
+
+  const char *body = response.content.c_str();
+  size_t bodyLength = response.content.length();
+  if (response.isProgmemContent && response.progmemData) {
+    body = response.progmemData;
+    bodyLength = response.getProgmemLength();
+  }
+  appendBody(out, body, bodyLength);
+}
+
+void NativeWebPlatform::serializeStorage(WebResponse &response,
+                                         bool &keepAlive, std::string &out,
+                                         StorageBody *body) const {
+  IStorageDriver *driver =
+      StorageDriverRegistry::getDriver(response.storageDriverName);
+  IStorageDriver::Handle handle =
+      driver ? driver->open(response.storageCollection, response.storageKey)
+             : IStorageDriver::INVALID_HANDLE;
+  if (handle == IStorageDriver::INVALID_HANDLE) {
+    if (driver) {
+      sendError(response, 404, "Not found");
+    } else {
+      sendError(response, 501, "Storage driver not registered");
+    }
+    serialize(response, keepAlive, out);
+    return;
+  }
+
+  // The driver's tag unless the handler set its own; validated before any
+  // byte is read, and it also backs If-Range
+  String etag = response.headers.find("ETag") == response.headers.end()
+                    ? driver->etag(handle)
+                    : String();
+  if (etag.length() > 0 && response.statusCode == 200 &&
+      response.setETag(etag)) {
+    driver->close(handle);
+    serialize(response, keepAlive, out);
+    return;
+  }
+
+  ByteRange range;
+  response.resolveRange(driver->size(handle), range);
+  appendStatusLine(out, response.statusCode);
+  for (const auto &header : response.headers) {
+    appendHeader(out, header.first, header.second);
+  }
+  if (response.mimeType.length() > 0) {
+    appendHeader(out, "Content-Type", response.mimeType);
+  }
+  appendConnection(out, keepAlive);
+  appendContentLength(out, range.length);
+
+  const uint8_t *view = driver->contiguousView(handle);
+  if (view && body && range.length > 0) {
+    body->driver = driver;
+    body->handle = handle;
+    body->data = view + range.offset;
+    body->length = range.length;
+    body->sent = 0;
+    return; // Closed once written
+  }
+  if (view) {
+    out.append(reinterpret_cast<const char *>(view + range.offset),
+               range.length);
+  } else if (range.length > 0) {
+    size_t start = out.size();
+    out.resize(start + range.length);
+    size_t filled = 0;
+    if (driver->seek(handle, range.offset)) {
+      while (filled < range.length) {
+        size_t want = range.length - filled;
+        size_t count = driver->read(
+            handle, reinterpret_cast<uint8_t *>(&out[start + filled]),
+            want < STORAGE_CHUNK ? want : STORAGE_CHUNK);
+        if (count == 0) {
+          break;
+        }
+        filled += count;
+      }
+    }
+    if (filled < range.length) {
+      // Content-Length is already out: end the connection after the bytes
+      // read so the client sees a truncated transfer, not a valid body
+      out.resize(start + filled);
+      keepAlive = false;
+    }
+  }
+  driver->close(handle);
+}
+
+bool NativeWebPlatform::compressible(const WebRequest &request,
+                                     const WebResponse &response,
+                                     const ResponseCompressionPolicy &policy) {
+  // Handler-produced bodies only: PROGMEM assets carry their own encodings
+  if (!policy.enabled() || response.isProgmemContent ||
+      response.statusCode < 200 || response.statusCode == 204 ||
+      response.statusCode == 304 ||
+      response.headers.find("Content-Encoding") != response.headers.end()) {
+    return false;
+  }
+  size_t length = response.isJsonStreamContent
+                      ? ResponseCompressionPolicy::UNKNOWN_LENGTH
+                      : response.content.length();
+  return policy.appliesTo(request.headerView(HeaderId::ACCEPT_ENCODING),
+                          StringView(response.mimeType), length);
+}
+
+void NativeWebPlatform::serializeCompressed(
+    const WebResponse &response, bool keepAlive,
+    const ResponseCompressionPolicy &policy, std::string &out) {
+  // The weak stream ETag covers the uncompressed JSON, which gzip leaves
+  // semantically unchanged; a match is answered uncompressed as a 304
+  String streamETag;
+  if (response.isJsonStreamContent && response.jsonStreamETag &&
+      response.statusCode == 200) {
+    streamETag = response.computeJsonStreamETag();
+    if (response.requestHasETag(streamETag)) {
+      serialize(response, keepAlive, out);
+      return;
+    }
+  }
+
+  appendStatusLine(out, response.statusCode);
+  String vary = "Accept-Encoding";
+  for (const auto &header : response.headers) {
+    if (header.first.equalsIgnoreCase("Vary")) {
+      vary = header.second + ", " + vary;
+    } else if (!header.first.equalsIgnoreCase("Content-Length")) {
+      appendHeader(out, header.first, header.second);
+    }
+  }
+  appendHeader(out, "Vary", vary);
+  if (streamETag.length() > 0) {
+    appendHeader(out, "ETag", streamETag);
+  }
+  if (response.mimeType.length() > 0) {
+    appendHeader(out, "Content-Type", response.mimeType);
+  }
+  appendConnection(out, keepAlive);
+  out += "Content-Encoding: gzip\r\nTransfer-Encoding: chunked\r\n\r\n";
+
+  GzipStream gzip(
+      [&out](const char *data, size_t length) {
+        char size[20];
+        int sizeLength = snprintf(size, sizeof(size), "%zx\r\n", length);
+        out.append(size, sizeLength);
+        out.append(data, length);
+        out += "\r\n";
+        return true;
+      },
+      policy.windowBits, policy.maxChain);
+  if (response.isJsonStreamContent) {
+    response.writeJsonStream([&gzip](const char *data, size_t length) {
+      return gzip.write(data, length);
+    });
+  } else {
+    gzip.write(response.content.c_str(), response.content.length());
+  }
+  gzip.finish();
+  out += "0\r\n\r\n";
+}
+
+void NativeWebPlatform::serialize(const ResponseCache::Entry &entry,
+                                  const WebRequest &request, bool keepAlive,
+                                  std::string &out) {
+  bool notModified = false;
+  for (const auto &header : entry.headers) {
+    if (header.first.equalsIgnoreCase("ETag")) {
+      notModified = ETag::matches(
+          request.headerView(HeaderId::IF_NONE_MATCH), header.second);
+    }
+  }
+
+  appendStatusLine(out, notModified ? 304 : entry.statusCode);
+  for (const auto &header : entry.headers) {
+    appendHeader(out, header.first, header.second);
+  }
+  if (notModified) {
+    appendConnection(out, keepAlive);
+    out += "\r\n";
+    return;
+  }
+  if (entry.mimeType.length() > 0) {
+    appendHeader(out, "Content-Type", entry.mimeType);
+  }
+  appendConnection(out, keepAlive);
+  appendBody(out, entry.body.c_str(), entry.body.length());
+}
+
+#endif // NATIVE_PLATFORM && __linux__
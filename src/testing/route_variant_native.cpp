@@ -3,49 +3,93 @@
 
 #include <cstring>
 #include <interface/utils/route_variant.h>
+#include <new>
+#include <utility>
 #include <interface/web_module_interface.h>
 
 RouteVariant::RouteVariant(const WebRoute &route) : type(WEB_ROUTE) {
-  webRoute = new WebRoute(route);
+  new (&webRoute) WebRoute(route);
 }
 
 RouteVariant::RouteVariant(const ApiRoute &route) : type(API_ROUTE) {
-  apiRoute = new ApiRoute(route);
+  new (&apiRoute) ApiRoute(route);
+}
+
+RouteVariant::RouteVariant(WebRoute &&route) noexcept : type(WEB_ROUTE) {
+  new (&webRoute) WebRoute(std::move(route));
+}
+
+RouteVariant::RouteVariant(ApiRoute &&route) noexcept : type(API_ROUTE) {
+  new (&apiRoute) ApiRoute(std::move(route));
 }
 
 RouteVariant::RouteVariant(const RouteVariant &other) : type(other.type) {
   if (type == WEB_ROUTE) {
-    webRoute = new WebRoute(*other.webRoute);
+    new (&webRoute) WebRoute(other.webRoute);
+  } else {
+    new (&apiRoute) ApiRoute(other.apiRoute);
+  }
+}
+
+RouteVariant::RouteVariant(RouteVariant &&other) noexcept : type(other.type) {
+  if (type == WEB_ROUTE) {
+    new (&webRoute) WebRoute(std::move(other.webRoute));
   } else {
-    apiRoute = new ApiRoute(*other.apiRoute);
+    new (&apiRoute) ApiRoute(std::move(other.apiRoute));
   }
 }
 
 RouteVariant &RouteVariant::operator=(const RouteVariant &other) {
   if (this != &other) {
-    // Clean up existing
-    if (type == WEB_ROUTE) {
-      delete webRoute;
+    if (type == other.type) {
+      // Same alternative - reuse the existing storage
+      if (type == WEB_ROUTE) {
+        webRoute = other.webRoute;
+      } else {
+        apiRoute = other.apiRoute;
+      }
     } else {
-      delete apiRoute;
+      // Clean up existing and copy from other
+      destroy();
+      type = other.type;
+      if (type == WEB_ROUTE) {
+        new (&webRoute) WebRoute(other.webRoute);
+      } else {
+        new (&apiRoute) ApiRoute(other.apiRoute);
+      }
     }
+  }
+  return *this;
+}
 
-    // Copy from other
-    type = other.type;
-    if (type == WEB_ROUTE) {
-      webRoute = new WebRoute(*other.webRoute);
+RouteVariant &RouteVariant::operator=(RouteVariant &&other) noexcept {
+  if (this != &other) {
+    if (type == other.type) {
+      if (type == WEB_ROUTE) {
+        webRoute = std::move(other.webRoute);
+      } else {
+        apiRoute = std::move(other.apiRoute);
+      }
     } else {
-      apiRoute = new ApiRoute(*other.apiRoute);
+      destroy();
+      type = other.type;
+      if (type == WEB_ROUTE) {
+        new (&webRoute) WebRoute(std::move(other.webRoute));
+      } else {
+        new (&apiRoute) ApiRoute(std::move(other.apiRoute));
+      }
     }
   }
   return *this;
 }
 
-RouteVariant::~RouteVariant() {
+RouteVariant::~RouteVariant() { destroy(); }
+
+void RouteVariant::destroy() {
   if (type == WEB_ROUTE) {
-    delete webRoute;
+    webRoute.~WebRoute();
   } else {
-    delete apiRoute;
+    apiRoute.~ApiRoute();
   }
 }
 
@@ -58,7 +102,7 @@ const WebRoute &RouteVariant::getWebRoute() const {
                           AuthRequirements{});
     return dummy;
   }
-  return *webRoute;
+  return webRoute;
 }
 
 const ApiRoute &RouteVariant::getApiRoute() const {
@@ -69,7 +113,7 @@ const ApiRoute &RouteVariant::getApiRoute() const {
                           AuthRequirements{}, OpenAPIDocumentation());
     return dummy;
   }
-  return *apiRoute;
+  return apiRoute;
 }
 
 // Template specializations for helper functions
@@ -0,0 +1,299 @@
+#ifdef NATIVE_PLATFORM
+// Native testing implementation of WebRequest
+
+#include <ArduinoJson.h>
+#include <interface/utils/json_format.h>
+#include <interface/web_request.h>
+
+namespace {
+
+const RequestArena::Slice EMPTY_SLICE = {0, 0};
+
+// HEAD and tokens with no WebModule::Method read as GET; NativeWebPlatform
+// answers HEAD without the body and the rest with 501
+WebModule::Method methodFromToken(StringView token) {
+  if (token == "POST")
+    return WebModule::WM_POST;
+  if (token == "PUT")
+    return WebModule::WM_PUT;
+  if (token == "DELETE")
+    return WebModule::WM_DELETE;
+  if (token == "PATCH")
+    return WebModule::WM_PATCH;
+  return WebModule::WM_GET;
+}
+
+StringView trim(StringView text) {
+  size_t start = 0;
+  size_t end = text.length();
+  while (start < end && (text[start] == ' ' || text[start] == '\t')) {
+    start++;
+  }
+  while (end > start && (text[end - 1] == ' ' || text[end - 1] == '\t')) {
+    end--;
+  }
+  return text.substr(start, end - start);
+}
+
+// Position just past the next "\n" (or the end); `lineEnd` excludes "\r\n"
+size_t nextLine(StringView text, size_t pos, size_t &lineEnd) {
+  size_t newline = text.find('\n', pos);
+  if (newline == StringView::npos) {
+    lineEnd = text.length();
+    return text.length();
+  }
+  lineEnd = (newline > pos && text[newline - 1] == '\r') ? newline - 1
+                                                         : newline;
+  return newline + 1;
+}
+
+} // namespace
+
+WebRequest::WebRequest(WebServerClass *server)
+    : pathSlice(EMPTY_SLICE), querySlice(EMPTY_SLICE), bodySlice(EMPTY_SLICE),
+      clientIpSlice(EMPTY_SLICE), method(WebModule::WM_GET),
+      parsedSources(0) {
+  memset(headerSlots, NO_HEADER, sizeof(headerSlots));
+  // The native WebServerClass carries no request data
+  pathSlice = arena.append("/", 1);
+}
+
+WebRequest::WebRequest(const char *rawRequest, size_t length,
+                       const String &clientIp)
+    : pathSlice(EMPTY_SLICE), querySlice(EMPTY_SLICE), bodySlice(EMPTY_SLICE),
+      clientIpSlice(EMPTY_SLICE), method(WebModule::WM_GET),
+      parsedSources(0) {
+  memset(headerSlots, NO_HEADER, sizeof(headerSlots));
+  // Decoded params are never longer than their source. Reserving room for
+  // them up front means lazy parsing never moves the buffer, so views
+  // handed out earlier stay valid.
+  StringView raw(rawRequest, length);
+  StringView requestLine = raw.substr(0, raw.find('\n'));
+  size_t queryStart = requestLine.find('?');
+  size_t queryHeadroom =
+      queryStart == StringView::npos ? 0 : requestLine.length() - queryStart;
+  arena.reserve(length + clientIp.length() + queryHeadroom, 16);
+
+  parseRawRequest(rawRequest, length);
+  clientIpSlice = arena.append(StringView(clientIp));
+  if (bodyHasContentType("application/x-www-form-urlencoded")) {
+    arena.reserve(arena.bytesUsed() + queryHeadroom + bodySlice.length);
+  }
+}
+
+void WebRequest::parseRawRequest(const char *rawRequest, size_t length) {
+  RequestArena::Slice raw = arena.append(rawRequest, length);
+  StringView text = arena.view(raw);
+
+  // Request line: METHOD SP target SP version
+  size_t lineEnd;
+  size_t pos = nextLine(text, 0, lineEnd);
+  StringView requestLine = text.substr(0, lineEnd);
+  size_t methodEnd = requestLine.find(' ');
+  if (methodEnd == StringView::npos) {
+    pathSlice = arena.append("/", 1);
+    return;
+  }
+  method = methodFromToken(requestLine.substr(0, methodEnd));
+  size_t targetEnd = requestLine.find(' ', methodEnd + 1);
+  if (targetEnd == StringView::npos) {
+    targetEnd = requestLine.length();
+  }
+  StringView target =
+      requestLine.substr(methodEnd + 1, targetEnd - methodEnd - 1);
+  size_t queryStart = target.find('?');
+  pathSlice = arena.sliceOf(target.substr(0, queryStart));
+  if (queryStart != StringView::npos) {
+    querySlice = arena.sliceOf(target.substr(queryStart + 1));
+  }
+
+  // Header lines until the blank line
+  while (pos < text.length()) {
+    size_t start = pos;
+    pos = nextLine(text, pos, lineEnd);
+    StringView line = text.substr(start, lineEnd - start);
+    if (line.empty()) {
+      break;
+    }
+    size_t colon = line.find(':');
+    if (colon == StringView::npos) {
+      continue;
+    }
+    addHeader(trim(line.substr(0, colon)), trim(line.substr(colon + 1)));
+  }
+
+  StringView body = text.substr(pos);
+  StringView contentLength = headerView(HeaderId::CONTENT_LENGTH);
+  if (!contentLength.empty()) {
+    size_t declared = 0;
+    for (char c : contentLength) {
+      if (c < '0' || c > '9') {
+        break;
+      }
+      declared = declared * 10 + (c - '0');
+    }
+    body = body.substr(0, declared);
+  }
+  bodySlice = arena.sliceOf(body);
+}
+
+void WebRequest::addHeader(StringView name, StringView value) {
+  HeaderId id = HttpHeaders::idFromName(name);
+  if (id != HeaderId::UNKNOWN &&
+      headerSlots[static_cast<size_t>(id)] == NO_HEADER &&
+      arena.getFields().size() < NO_HEADER) {
+    headerSlots[static_cast<size_t>(id)] =
+        static_cast<uint8_t>(arena.getFields().size());
+  }
+  arena.addField(RequestArena::HEADER, arena.sliceOf(name),
+                 arena.sliceOf(value));
+}
+
+bool WebRequest::bodyHasContentType(const char *mimeType) const {
+  return bodySlice.length > 0 &&
+         headerView(HeaderId::CONTENT_TYPE).startsWith(StringView(mimeType));
+}
+
+void WebRequest::ensureParamsParsed() const {
+  // Query params are added first so they win over form fields of the same
+  // name
+  if (!(parsedSources & PARSED_QUERY)) {
+    parsedSources |= PARSED_QUERY;
+    parseQueryParams(querySlice);
+  }
+  if (!(parsedSources & PARSED_FORM)) {
+    parsedSources |= PARSED_FORM;
+    if (bodyHasContentType("application/x-www-form-urlencoded")) {
+      parseFormData(bodySlice);
+    }
+  }
+}
+
+void WebRequest::ensureJsonParsed() const {
+  if (!(parsedSources & PARSED_JSON)) {
+    parsedSources |= PARSED_JSON;
+    JsonFormat format = JsonFormat::JSON;
+    if (bodySlice.length > 0 &&
+        JsonFormats::fromContentType(headerView(HeaderId::CONTENT_TYPE),
+                                     format)) {
+      parseJsonData(bodyView());
+    }
+  }
+}
+
+void WebRequest::parseQueryParams(RequestArena::Slice query) const {
+  arena.addUrlEncodedFields(query);
+}
+
+void WebRequest::parseFormData(RequestArena::Slice formData) const {
+  arena.addUrlEncodedFields(formData);
+}
+
+// JSON or MessagePack, by Content-Type; handlers see the same document
+void WebRequest::parseJsonData(StringView jsonData) const {
+  JsonFormat format = JsonFormat::JSON;
+  JsonFormats::fromContentType(headerView(HeaderId::CONTENT_TYPE), format);
+  std::unique_ptr<DynamicJsonDocument> doc(new DynamicJsonDocument(
+      JsonFormats::documentCapacity(jsonData.length(), format)));
+  if (!JsonFormats::deserialize(*doc, jsonData, format)) {
+    jsonDoc = std::move(doc);
+  }
+}
+
+StringView WebRequest::paramView(StringView name) const {
+  ensureParamsParsed();
+  const RequestArena::Field *field =
+      arena.findField(RequestArena::PARAM, name);
+  return field ? arena.view(field->value) : StringView();
+}
+
+StringView WebRequest::headerView(StringView name) const {
+  HeaderId id = HttpHeaders::idFromName(name);
+  if (id != HeaderId::UNKNOWN) {
+    return headerView(id);
+  }
+  const RequestArena::Field *field =
+      arena.findField(RequestArena::HEADER, name, true);
+  return field ? arena.view(field->value) : StringView();
+}
+
+StringView WebRequest::headerView(HeaderId id) const {
+  if (id == HeaderId::UNKNOWN) {
+    return StringView();
+  }
+  uint8_t slot = headerSlots[static_cast<size_t>(id)];
+  return slot == NO_HEADER ? StringView()
+                           : arena.view(arena.getFields()[slot].value);
+}
+
+String WebRequest::getParam(const String &name) const {
+  return paramView(name).toString();
+}
+
+std::map<String, String> WebRequest::getAllParams() const {
+  ensureParamsParsed();
+  std::map<String, String> params;
+  for (const RequestArena::Field &field : arena.getFields()) {
+    if (field.kind == RequestArena::PARAM) {
+      String key = arena.view(field.name).toString();
+      if (params.find(key) == params.end()) {
+        params[key] = arena.view(field.value).toString();
+      }
+    }
+  }
+  return params;
+}
+
+String WebRequest::getHeader(const String &name) const {
+  return headerView(name).toString();
+}
+
+String WebRequest::getJsonParam(const String &name) const {
+  JsonVariantConst value = getJsonBody()[name.c_str()];
+  if (value.isNull()) {
+    return "";
+  }
+  if (value.is<const char *>()) {
+    return value.as<const char *>();
+  }
+  String text;
+  serializeJson(value, text);
+  return text;
+}
+
+JsonVariantConst WebRequest::getJsonBody() const {
+  ensureJsonParsed();
+  if (!jsonDoc) {
+    return JsonVariantConst();
+  }
+  const JsonDocument &doc = *jsonDoc;
+  return doc.as<JsonVariantConst>();
+}
+
+String WebRequest::getRouteParameter(const String &paramName) const {
+  // Walk pattern and path segment by segment
+  StringView pattern(matchedRoutePattern);
+  StringView path = pathView();
+  size_t patternPos = 0;
+  size_t pathPos = 0;
+  while (patternPos < pattern.length() && pathPos < path.length()) {
+    size_t patternEnd = pattern.find('/', patternPos);
+    size_t pathEnd = path.find('/', pathPos);
+    if (patternEnd == StringView::npos)
+      patternEnd = pattern.length();
+    if (pathEnd == StringView::npos)
+      pathEnd = path.length();
+
+    StringView segment = pattern.substr(patternPos, patternEnd - patternPos);
+    if (segment.length() > 2 && segment[0] == '{' &&
+        segment[segment.length() - 1] == '}' &&
+        segment.substr(1, segment.length() - 2) == StringView(paramName)) {
+      return path.substr(pathPos, pathEnd - pathPos).toString();
+    }
+    patternPos = patternEnd + 1;
+    pathPos = pathEnd + 1;
+  }
+  return "";
+}
+
+#endif // NATIVE_PLATFORM
@@ -6,6 +6,7 @@
 WebResponse::WebResponse() : statusCode(200), headersSent(false), responseSent(false), 
                              progmemData(nullptr), isProgmemContent(false), 
                              jsonDoc(nullptr), isJsonContent(false), 
+                             isJsonStreamContent(false),
                              isStorageStreamContent(false) {
 }
 
@@ -18,14 +19,17 @@ void WebResponse::setContent(const String &content, const String &mimeType) {
     this->mimeType = mimeType;
     isProgmemContent = false;
     isJsonContent = false;
+    isJsonStreamContent = false;
     isStorageStreamContent = false;
 }
 
 void WebResponse::setProgmemContent(const char *progmemData, const String &mimeType) {
     this->progmemData = progmemData;
+    progmemLength = NUL_TERMINATED;
     this->mimeType = mimeType;
     isProgmemContent = true;
     isJsonContent = false;
+    isJsonStreamContent = false;
     isStorageStreamContent = false;
 }
 
@@ -38,9 +42,37 @@ void WebResponse::redirect(const String &url, int code) {
     setHeader("Location", url);
 }
 
+void WebResponse::setJsonStreamContent(const JsonStreamCallback &writer,
+                                       const String &mimeType) {
+    jsonStreamCallback = writer;
+    this->mimeType = mimeType;
+    isJsonStreamContent = true;
+    isProgmemContent = false;
+    isJsonContent = false;
+    isStorageStreamContent = false;
+}
+
 String WebResponse::getContent() const {
+    if (isJsonStreamContent) {
+        // Collect the chunks the stream would send
+        String body;
+        writeJsonStream([&body](const char *data, size_t length) {
+            for (size_t i = 0; i < length; i++) {
+                body += data[i];
+            }
+            return true;
+        });
+        return body;
+    }
     if (isProgmemContent && progmemData) {
-        return String(progmemData);  // In native testing, just convert to String
+        // In native testing, just convert to String (may be binary)
+        String body;
+        size_t length = getProgmemLength();
+        body.reserve(length);
+        for (size_t i = 0; i < length; i++) {
+            body += progmemData[i];
+        }
+        return body;
     }
     return content;
 }
@@ -50,16 +82,31 @@ String WebResponse::getHeader(const String &name) const {
     return (it != headers.end()) ? it->second : String("");
 }
 
-// Stub implementations for methods that don't apply to native testing
 void WebResponse::setJsonContent(const JsonDocument &doc) {
-    // For native testing, we could serialize to string if needed
+    // Serialize now: the document usually dies with the handler
+    content = "";
+    serializeJson(doc, content);
+    mimeType = "application/json";
+    isProgmemContent = false;
+    isJsonContent = false;
+    isJsonStreamContent = false;
+    isStorageStreamContent = false;
 }
 
 void WebResponse::setStorageStreamContent(const String &collection, const String &key,
                                          const String &mimeType, const String &driverName) {
-    // Stub for native testing
+    storageCollection = collection;
+    storageKey = key;
+    storageDriverName = driverName;
+    this->mimeType = mimeType;
+    isStorageStreamContent = true;
+    isProgmemContent = false;
+    isJsonContent = false;
+    isJsonStreamContent = false;
 }
 
+// Stub implementations for methods that don't apply to native testing
+
 void WebResponse::sendTo(WebServerClass *server) {
     // Stub for native testing - WebServerClass doesn't exist in native
     responseSent = true;
@@ -7,10 +7,12 @@ void test_auth_types();
 void test_openapi_documentation_basic_operations();
 void test_auth_context_basic_operations();
 void test_auth_requirements_collections();
+void test_auth_mask();
 
 #ifdef OPENAPI_ENABLED
 void test_openapi_factory_create_documentation();
 void test_openapi_factory_success_response();
+void test_openapi_documentation_compact_storage();
 #endif
 
 // Registration function to be called from main
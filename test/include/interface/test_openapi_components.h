@@ -0,0 +1,13 @@
+#ifndef TEST_OPENAPI_COMPONENTS_H
+#define TEST_OPENAPI_COMPONENTS_H
+
+// Forward declarations for OpenAPI component registry tests
+void test_openapi_components_interning();
+void test_openapi_components_string_conversion();
+void test_openapi_components_factory_opt_in();
+void test_openapi_components_in_spec();
+
+// Registration function to be called from main
+void register_openapi_components_tests();
+
+#endif // TEST_OPENAPI_COMPONENTS_H
@@ -0,0 +1,12 @@
+#ifndef TEST_OPENAPI_SPEC_WRITER_H
+#define TEST_OPENAPI_SPEC_WRITER_H
+
+// Forward declarations for OpenAPI spec writer tests
+void test_openapi_spec_writer_document();
+void test_openapi_spec_writer_operation_defaults();
+void test_openapi_spec_writer_streams_without_heap();
+
+// Registration function to be called from main
+void register_openapi_spec_writer_tests();
+
+#endif // TEST_OPENAPI_SPEC_WRITER_H
@@ -0,0 +1,11 @@
+#ifndef TEST_STORAGE_DRIVER_H
+#define TEST_STORAGE_DRIVER_H
+
+// Forward declarations for storage driver registry tests
+void test_storage_driver_registry();
+void test_storage_driver_defaults();
+
+// Registration function to be called from main
+void register_storage_driver_tests();
+
+#endif // TEST_STORAGE_DRIVER_H
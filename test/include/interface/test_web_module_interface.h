@@ -11,6 +11,7 @@ void test_auth_requirements_in_routes();
 void test_route_variant_conversions();
 void test_api_path_warning();
 void test_iweb_module_default_implementations();
+void test_web_module_for_each_route();
 
 // Registration function to be called from main
 void register_web_module_interface_tests();
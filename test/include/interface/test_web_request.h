@@ -14,6 +14,8 @@ void test_web_request_auth_context();
 void test_web_request_route_matching();
 void test_web_request_module_base_path();
 void test_web_request_client_ip();
+void test_web_request_views();
+void test_web_request_header_ids();
 
 // Registration function to be called from main
 void register_web_request_tests();
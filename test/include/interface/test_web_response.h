@@ -9,9 +9,13 @@ void test_web_response_set_progmem_content();
 void test_web_response_set_headers();
 void test_web_response_redirect();
 void test_web_response_set_json_content();
+void test_web_response_json_stream_content();
 void test_web_response_send_to();
 void test_web_response_storage_stream();
 void test_web_response_progmem_data_content();
+void test_web_response_progmem_asset();
+void test_web_response_etag();
+void test_web_response_resolve_range();
 void test_web_response_send_to_detailed();
 
 // Registration function to be called from main
@@ -0,0 +1,11 @@
+#ifndef TEST_CONTENT_ENCODING_H
+#define TEST_CONTENT_ENCODING_H
+
+// Forward declarations for Accept-Encoding negotiation tests
+void test_content_encoding_quality();
+void test_content_encoding_negotiate();
+
+// Registration function to be called from main
+void register_content_encoding_tests();
+
+#endif // TEST_CONTENT_ENCODING_H
@@ -0,0 +1,11 @@
+#ifndef TEST_ETAG_H
+#define TEST_ETAG_H
+
+// Forward declarations for entity tag tests
+void test_etag_format_and_compute();
+void test_etag_matches();
+
+// Registration function to be called from main
+void register_etag_tests();
+
+#endif // TEST_ETAG_H
@@ -0,0 +1,13 @@
+#ifndef TEST_GZIP_STREAM_H
+#define TEST_GZIP_STREAM_H
+
+// Forward declarations for streaming gzip encoder tests
+void test_gzip_stream_round_trip();
+void test_gzip_stream_trailer();
+void test_gzip_stream_sink_failure();
+void test_gzip_stream_policy();
+
+// Registration function to be called from main
+void register_gzip_stream_tests();
+
+#endif // TEST_GZIP_STREAM_H
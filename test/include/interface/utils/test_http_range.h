@@ -0,0 +1,12 @@
+#ifndef TEST_HTTP_RANGE_H
+#define TEST_HTTP_RANGE_H
+
+// Forward declarations for byte range request tests
+void test_http_range_parse();
+void test_http_range_rejects();
+void test_http_range_if_range();
+
+// Registration function to be called from main
+void register_http_range_tests();
+
+#endif // TEST_HTTP_RANGE_H
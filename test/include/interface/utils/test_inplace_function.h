@@ -0,0 +1,15 @@
+#ifndef TEST_INPLACE_FUNCTION_H
+#define TEST_INPLACE_FUNCTION_H
+
+// Forward declarations for inplace function tests
+void test_inplace_function_lambda_captures();
+void test_inplace_function_copy_and_move();
+void test_inplace_function_context_pointer();
+void test_inplace_function_empty();
+void test_inplace_function_non_trivial_callable();
+void test_inplace_function_route_handler();
+
+// Registration function to be called from main
+void register_inplace_function_tests();
+
+#endif // TEST_INPLACE_FUNCTION_H
@@ -0,0 +1,14 @@
+#ifndef TEST_JSON_DOCUMENT_POOL_H
+#define TEST_JSON_DOCUMENT_POOL_H
+
+// Forward declarations for JSON document pool tests
+void test_json_document_pool_reuse();
+void test_json_document_pool_learns_route_capacity();
+void test_json_document_pool_overflow_retry();
+void test_json_document_pool_platform_responses();
+void test_json_document_pool_response_builder();
+
+// Registration function to be called from main
+void register_json_document_pool_tests();
+
+#endif // TEST_JSON_DOCUMENT_POOL_H
@@ -0,0 +1,13 @@
+#ifndef TEST_JSON_FORMAT_H
+#define TEST_JSON_FORMAT_H
+
+// Forward declarations for JSON / MessagePack negotiation tests
+void test_json_format_negotiate();
+void test_json_format_content_type();
+void test_json_format_msgpack_response();
+void test_json_format_msgpack_request_body();
+
+// Registration function to be called from main
+void register_json_format_tests();
+
+#endif // TEST_JSON_FORMAT_H
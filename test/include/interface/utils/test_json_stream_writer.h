@@ -0,0 +1,15 @@
+#ifndef TEST_JSON_STREAM_WRITER_H
+#define TEST_JSON_STREAM_WRITER_H
+
+// Forward declarations for JSON stream writer tests
+void test_json_stream_writer_structure();
+void test_json_stream_writer_values();
+void test_json_stream_writer_escaping();
+void test_json_stream_writer_chunking();
+void test_json_stream_writer_sink_failure();
+void test_json_stream_writer_json_variant();
+
+// Registration function to be called from main
+void register_json_stream_writer_tests();
+
+#endif // TEST_JSON_STREAM_WRITER_H
@@ -0,0 +1,13 @@
+#ifndef TEST_REQUEST_ARENA_H
+#define TEST_REQUEST_ARENA_H
+
+// Forward declarations for request arena and string view tests
+void test_string_view_basics();
+void test_request_arena_slices();
+void test_request_arena_decode();
+void test_request_arena_url_encoded_fields();
+
+// Registration function to be called from main
+void register_request_arena_tests();
+
+#endif // TEST_REQUEST_ARENA_H
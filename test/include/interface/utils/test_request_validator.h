@@ -0,0 +1,14 @@
+#ifndef TEST_REQUEST_VALIDATOR_H
+#define TEST_REQUEST_VALIDATOR_H
+
+// Forward declarations for request validator tests
+void test_request_validator_types_and_required();
+void test_request_validator_bounds_and_enum();
+void test_request_validator_nested();
+void test_request_validator_rejects_bad_schemas();
+void test_request_validator_route_registration();
+
+// Registration function to be called from main
+void register_request_validator_tests();
+
+#endif // TEST_REQUEST_VALIDATOR_H
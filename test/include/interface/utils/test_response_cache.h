@@ -0,0 +1,14 @@
+#ifndef TEST_RESPONSE_CACHE_H
+#define TEST_RESPONSE_CACHE_H
+
+// Forward declarations for response cache tests
+void test_response_cache_key();
+void test_response_cache_ttl();
+void test_response_cache_lru_and_bytes();
+void test_response_cache_invalidate();
+void test_response_cache_route_policy();
+
+// Registration function to be called from main
+void register_response_cache_tests();
+
+#endif // TEST_RESPONSE_CACHE_H
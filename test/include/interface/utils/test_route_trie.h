@@ -0,0 +1,17 @@
+#ifndef TEST_ROUTE_TRIE_H
+#define TEST_ROUTE_TRIE_H
+
+// Forward declarations for route trie tests
+void test_route_trie_static_routes();
+void test_route_trie_param_capture();
+void test_route_trie_wildcard();
+void test_route_trie_precedence();
+void test_route_trie_methods();
+void test_route_trie_edge_split();
+void test_route_trie_replace_and_remove();
+void test_route_trie_malformed_patterns();
+
+// Registration function to be called from main
+void register_route_trie_tests();
+
+#endif // TEST_ROUTE_TRIE_H
@@ -7,6 +7,7 @@ void test_route_variant_api_route_constructor();
 void test_route_variant_copy_constructor();
 void test_route_variant_assignment_operator();
 void test_route_variant_self_assignment();
+void test_route_variant_move_semantics();
 void test_route_variant_getters();
 void test_route_variant_wrong_type_getters();
 void test_route_variant_template_helpers();
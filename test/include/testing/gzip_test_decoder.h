@@ -0,0 +1,13 @@
+#ifndef GZIP_TEST_DECODER_H
+#define GZIP_TEST_DECODER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+// Inflate a gzip member made of fixed-Huffman deflate blocks (what
+// GzipStream emits), checking the CRC-32 and size trailer. Returns false
+// on anything malformed. Test-only; not a general gzip decoder.
+bool gzipTestDecode(const std::string &gzip, std::string &out);
+
+#endif // GZIP_TEST_DECODER_H
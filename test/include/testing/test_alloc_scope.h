@@ -0,0 +1,14 @@
+#ifndef TEST_ALLOC_SCOPE_H
+#define TEST_ALLOC_SCOPE_H
+
+// Forward declarations for allocation instrumentation tests
+void test_alloc_scope_counts_new_and_malloc();
+void test_alloc_scope_peak_live_bytes();
+void test_alloc_scope_nested_and_stopped();
+void test_alloc_assertions_handler_budget();
+void test_alloc_assertions_register_module_budget();
+
+// Registration function to be called from main
+void register_alloc_scope_tests();
+
+#endif // TEST_ALLOC_SCOPE_H
@@ -31,6 +31,15 @@ void test_mock_web_response();
 // Test Authentication handling in MockWebRequest
 void test_mock_web_request_auth();
 
+// Test route resolution through the mock router
+void test_mock_web_platform_route_matching();
+
+// Test registration of modules that stream routes via forEachRoute()
+void test_mock_web_platform_streamed_module();
+void test_mock_web_platform_cache_invalidation();
+void test_mock_web_platform_cache_invalidation_paths();
+void test_mock_web_platform_cache_invalidation_module();
+
 // Register all mock platform tests
 void register_mock_web_platform_tests();
 
@@ -0,0 +1,14 @@
+#ifndef TEST_NATIVE_STORAGE_DRIVER_H
+#define TEST_NATIVE_STORAGE_DRIVER_H
+
+// Forward declarations for the host filesystem storage driver tests
+void test_native_storage_driver_read();
+void test_native_storage_driver_serve();
+void test_native_storage_driver_short_read();
+void test_native_storage_driver_etag();
+void test_native_storage_driver_socket();
+
+// Registration function to be called from main
+void register_native_storage_driver_tests();
+
+#endif // TEST_NATIVE_STORAGE_DRIVER_H
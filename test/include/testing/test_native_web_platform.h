@@ -0,0 +1,22 @@
+#ifndef TEST_NATIVE_WEB_PLATFORM_H
+#define TEST_NATIVE_WEB_PLATFORM_H
+
+// Forward declarations for native loopback server tests
+void test_native_web_platform_dispatch();
+void test_native_web_platform_methods();
+void test_native_web_platform_auth();
+void test_native_web_platform_json_stream();
+void test_native_web_platform_json_stream_etag();
+void test_native_web_platform_progmem_etag();
+void test_native_web_platform_openapi();
+void test_native_web_platform_compression();
+void test_native_web_platform_socket();
+void test_native_web_platform_response_cache();
+void test_native_web_platform_response_cache_formats();
+void test_native_web_platform_request_validation();
+void test_native_web_platform_https_routes();
+
+// Registration function to be called from main
+void register_native_web_platform_tests();
+
+#endif // TEST_NATIVE_WEB_PLATFORM_H
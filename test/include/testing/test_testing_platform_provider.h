@@ -22,6 +22,7 @@ void test_mock_web_platform_json_builder_conditions();
 void test_mock_web_platform_provider_edge_cases();
 void test_mock_web_platform_string_conversion();
 void test_mock_web_platform_json_serialization_coverage();
+void test_mock_web_platform_openapi_spec();
 
 // Test registration function
 void register_testing_platform_provider_tests();
@@ -0,0 +1,17 @@
+#ifndef TEST_WEB_REQUEST_NATIVE_H
+#define TEST_WEB_REQUEST_NATIVE_H
+
+// Forward declarations for native WebRequest tests
+void test_web_request_native_request_line();
+void test_web_request_native_headers();
+void test_web_request_native_header_ids();
+void test_web_request_native_form_body();
+void test_web_request_native_json_body();
+void test_web_request_native_lazy_parsing();
+void test_web_request_native_json_document();
+void test_web_request_native_route_parameter();
+
+// Registration function to be called from main
+void register_web_request_native_tests();
+
+#endif // TEST_WEB_REQUEST_NATIVE_H
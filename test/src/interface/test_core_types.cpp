@@ -11,6 +11,7 @@
 // Test OpenAPIFactory if available
 #ifdef OPENAPI_ENABLED
 #include <interface/openapi_factory.h>
+#include <testing/alloc_assertions.h>
 #endif
 
 // Test basic Web Module types
@@ -90,6 +91,46 @@ void test_openapi_factory_success_response() {
   TEST_ASSERT_TRUE(response.indexOf("object") >= 0);
   TEST_ASSERT_TRUE(response.indexOf("Test response description") >= 0);
 }
+
+void test_openapi_documentation_compact_storage() {
+  static const char SCHEMA[] = "{\"type\":\"object\"}";
+
+  // Literals are borrowed: no heap, the doc points at the literal itself
+  OpenAPIDocumentation doc;
+  TEST_ASSERT_NO_ALLOCS(
+      doc = OpenAPIDocumentation("Status", "Device status", "getStatus")
+                .withResponseSchema(SCHEMA));
+  TEST_ASSERT_EQUAL_PTR(SCHEMA, doc.text(OpenAPIField::RESPONSE_SCHEMA));
+  TEST_ASSERT_TRUE(doc.has(OpenAPIField::SUMMARY));
+  TEST_ASSERT_FALSE(doc.has(OpenAPIField::REQUEST_SCHEMA));
+  TEST_ASSERT_EQUAL_STRING("", doc.text(OpenAPIField::REQUEST_SCHEMA));
+
+  // Runtime Strings are copied once and owned
+  String example = "{\"id\":1}";
+  doc.withRequestExample(example);
+  example = "changed";
+  TEST_ASSERT_EQUAL_STRING("{\"id\":1}", doc.getRequestExample().c_str());
+
+  // Copies duplicate owned text only; moves hand everything over
+  OpenAPIDocumentation copy(doc);
+  TEST_ASSERT_EQUAL_PTR(SCHEMA, copy.text(OpenAPIField::RESPONSE_SCHEMA));
+  TEST_ASSERT_TRUE(copy.text(OpenAPIField::REQUEST_EXAMPLE) !=
+                   doc.text(OpenAPIField::REQUEST_EXAMPLE));
+  OpenAPIDocumentation moved(std::move(copy));
+  TEST_ASSERT_EQUAL_STRING("{\"id\":1}",
+                           moved.getRequestExample().c_str());
+  TEST_ASSERT_FALSE(copy.hasDocumentation());
+
+  // Setting an empty text clears the field
+  moved.withRequestExample("");
+  TEST_ASSERT_FALSE(moved.has(OpenAPIField::REQUEST_EXAMPLE));
+  TEST_ASSERT_FALSE(OpenAPIDocumentation("").hasDocumentation());
+
+  // One pointer per field plus the two bitmasks
+  TEST_ASSERT_TRUE(sizeof(OpenAPIDocumentation) <=
+                   (static_cast<size_t>(OpenAPIField::COUNT) + 1) *
+                       sizeof(const char *));
+}
 #endif
 
 void test_auth_context_basic_operations() {
@@ -134,6 +175,49 @@ void test_auth_requirements_collections() {
   TEST_ASSERT_TRUE(hasToken);
 }
 
+void test_auth_mask() {
+  // Combinators are usable in constant expressions
+  constexpr AuthMask apiAuth = AuthType::SESSION | AuthType::TOKEN;
+  static_assert(apiAuth.has(AuthType::TOKEN), "TOKEN should be set");
+  static_assert(!apiAuth.has(AuthType::LOCAL_ONLY), "LOCAL_ONLY unset");
+  static_assert(sizeof(AuthMask) == 1, "AuthMask should be one byte");
+
+  // Same contents regardless of how the mask was built
+  AuthRequirements listed{AuthType::TOKEN, AuthType::SESSION};
+  TEST_ASSERT_TRUE(listed == apiAuth);
+  TEST_ASSERT_TRUE(AuthMask(std::vector<AuthType>{
+                       AuthType::SESSION, AuthType::TOKEN}) == apiAuth);
+
+  // Members are listed in ascending AuthType order
+  TEST_ASSERT_EQUAL(2, listed.size());
+  TEST_ASSERT_TRUE(listed[0] == AuthType::SESSION);
+  TEST_ASSERT_TRUE(listed[1] == AuthType::TOKEN);
+  size_t visited = 0;
+  for (AuthType type : listed) {
+    TEST_ASSERT_TRUE(listed.has(type));
+    visited++;
+  }
+  TEST_ASSERT_EQUAL(2, visited);
+
+  // NONE is a member of its own, distinct from an empty set
+  AuthRequirements publicAuth{AuthType::NONE};
+  TEST_ASSERT_EQUAL(1, publicAuth.size());
+  TEST_ASSERT_TRUE(publicAuth[0] == AuthType::NONE);
+  TEST_ASSERT_FALSE(publicAuth.requiresAuth());
+  TEST_ASSERT_TRUE(AuthRequirements{}.empty());
+  TEST_ASSERT_TRUE(publicAuth != AuthRequirements{});
+
+  // Vector-style mutation; duplicates collapse
+  AuthRequirements built;
+  built.push_back(AuthType::LOCAL_ONLY);
+  built.push_back(AuthType::LOCAL_ONLY);
+  built |= AuthType::PAGE_TOKEN;
+  TEST_ASSERT_EQUAL(2, built.size());
+  TEST_ASSERT_TRUE(built.requiresAuth());
+  built.clear();
+  TEST_ASSERT_TRUE(built.empty());
+}
+
 // Registration function to run all core type tests
 void register_core_types_tests() {
   RUN_TEST(test_web_module_methods);
@@ -143,8 +227,10 @@ void register_core_types_tests() {
 #ifdef OPENAPI_ENABLED
   RUN_TEST(test_openapi_factory_create_documentation);
   RUN_TEST(test_openapi_factory_success_response);
+  RUN_TEST(test_openapi_documentation_compact_storage);
 #endif
 
   RUN_TEST(test_auth_context_basic_operations);
   RUN_TEST(test_auth_requirements_collections);
+  RUN_TEST(test_auth_mask);
 }
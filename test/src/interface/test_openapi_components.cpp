@@ -0,0 +1,143 @@
+#include "../../include/interface/test_openapi_components.h"
+#include <ArduinoFake.h>
+#include <ArduinoJson.h>
+#include <interface/openapi_factory.h>
+#include <interface/openapi_spec_writer.h>
+#include <string>
+#include <testing/alloc_assertions.h>
+#include <unity.h>
+
+// The registry is process-wide, so these tests look components up through
+// their handles rather than assuming which names are taken. They intern
+// directly, since the factory only does so with
+// WEB_PLATFORM_OPENAPI_COMPONENTS.
+
+namespace {
+
+OpenAPISchemaRef error(const char *description) {
+  return OpenAPISchemaRef::interned(OpenAPIComponents::Kind::ERROR_RESPONSE,
+                                    description);
+}
+
+} // namespace
+
+void test_openapi_components_interning() {
+  OpenAPISchemaRef first = error("Bad input");
+  OpenAPISchemaRef again = error("Bad input");
+  OpenAPISchemaRef other = error("Not found");
+  size_t registered = OpenAPIComponents::shared().size();
+
+  // One component per distinct variant, handed out again on later calls
+  TEST_ASSERT_EQUAL_PTR(first.ref(), again.ref());
+  TEST_ASSERT_TRUE(strcmp(first.name(), other.name()) != 0);
+  TEST_ASSERT_EQUAL_STRING("ErrorResponse",
+                           String(first.name()).substring(0, 13).c_str());
+  error("Bad input");
+  TEST_ASSERT_EQUAL(registered, OpenAPIComponents::shared().size());
+  TEST_ASSERT_TRUE(first.isShared());
+
+  String expected =
+      String("{\"$ref\":\"#/components/schemas/") + first.name() + "\"}";
+  TEST_ASSERT_EQUAL_STRING(expected.c_str(), first.ref());
+  OpenAPISchemaRef id = OpenAPISchemaRef::interned(
+      OpenAPIComponents::Kind::ID_PARAMETER, "Device ID", "id");
+  TEST_ASSERT_TRUE(strstr(id.ref(), "#/components/parameters/") != nullptr);
+
+  // Routes borrow the $ref text: no copy of the schema per route
+  static OpenAPIDocumentation docs[100];
+  TEST_ASSERT_NO_ALLOCS(for (OpenAPIDocumentation &doc : docs) {
+    doc.withResponseSchema(first).withParameters(id);
+  });
+  TEST_ASSERT_EQUAL_PTR(first.ref(),
+                        docs[99].text(OpenAPIField::RESPONSE_SCHEMA));
+}
+
+void test_openapi_components_string_conversion() {
+  // Source compatible: a String holds the full schema, as compact JSON
+  String schema = OpenAPIFactory::createListResponse("\"quoted\" devices");
+  DynamicJsonDocument doc(1024);
+  TEST_ASSERT_FALSE(deserializeJson(doc, schema.c_str()));
+  TEST_ASSERT_EQUAL_STRING("object", doc["type"]);
+  TEST_ASSERT_EQUAL_STRING("List of \"quoted\" devices",
+                           doc["properties"]["items"]["description"]);
+  TEST_ASSERT_EQUAL_STRING("total", doc["required"][1]);
+
+  String param = OpenAPIFactory::createIdParameter("deviceId", "Device");
+  doc.clear();
+  TEST_ASSERT_FALSE(deserializeJson(doc, param.c_str()));
+  TEST_ASSERT_EQUAL_STRING("deviceId", doc["name"]);
+  TEST_ASSERT_TRUE(doc["required"]);
+
+  TEST_ASSERT_EQUAL_STRING("", String(OpenAPISchemaRef()).c_str());
+}
+
+// Until every spec generator writes components, the factory hands builders
+// the full schema unless WEB_PLATFORM_OPENAPI_COMPONENTS opts in
+void test_openapi_components_factory_opt_in() {
+  size_t registered = OpenAPIComponents::shared().size();
+  OpenAPISchemaRef saved = OpenAPIFactory::createSuccessResponse("Saved it");
+  OpenAPIDocumentation doc("Save");
+  doc.withResponseSchema(saved);
+  const char *schema = doc.text(OpenAPIField::RESPONSE_SCHEMA);
+#if WEB_PLATFORM_OPENAPI_COMPONENTS
+  TEST_ASSERT_TRUE(saved.isShared());
+  TEST_ASSERT_EQUAL_PTR(saved.ref(), schema);
+#else
+  TEST_ASSERT_FALSE(saved.isShared());
+  TEST_ASSERT_EQUAL_STRING("", saved.ref());
+  TEST_ASSERT_EQUAL_STRING(String(saved).c_str(), schema);
+  TEST_ASSERT_TRUE(strstr(schema, "Saved it") != nullptr);
+  TEST_ASSERT_EQUAL(registered, OpenAPIComponents::shared().size());
+#endif
+}
+
+void test_openapi_components_in_spec() {
+  OpenAPISchemaRef success = OpenAPISchemaRef::interned(
+      OpenAPIComponents::Kind::SUCCESS_RESPONSE,
+      "Operation completed successfully");
+  OpenAPISchemaRef id = OpenAPISchemaRef::interned(
+      OpenAPIComponents::Kind::ID_PARAMETER, "Item ID", "id");
+  OpenAPIDocumentation get("Get item");
+  get.withResponseSchema(success).withParameters(id);
+  OpenAPIDocumentation remove("Delete item");
+  remove.withResponseSchema(success);
+  std::vector<OpenAPISpecWriter::Operation> operations = {
+      {"/api/items/{id}", WebModule::WM_GET, {}, &get},
+      {"/api/items/{id}", WebModule::WM_DELETE, {}, &remove}};
+
+  std::string spec;
+  JsonStreamWriter writer([&spec](const char *data, size_t length) {
+    spec.append(data, length);
+    return true;
+  });
+  TEST_ASSERT_TRUE(
+      OpenAPISpecWriter::write(writer, OpenAPISpecWriter::Info(), operations));
+
+  DynamicJsonDocument doc(16384);
+  TEST_ASSERT_FALSE(
+      deserializeJson(doc, spec, DeserializationOption::NestingLimit(16)));
+  JsonObject item = doc["paths"]["/api/items/{id}"];
+  String ref = String("#/components/schemas/") + success.name();
+  TEST_ASSERT_EQUAL_STRING(
+      ref.c_str(), item["delete"]["responses"]["200"]["content"]
+                       ["application/json"]["schema"]["$ref"]);
+  TEST_ASSERT_TRUE(item["get"]["parameters"][0].containsKey("$ref"));
+
+  // Each definition is written once, however many routes use it
+  JsonObject components = doc["components"];
+  TEST_ASSERT_EQUAL_STRING("object",
+                           components["schemas"][success.name()]["type"]);
+  TEST_ASSERT_EQUAL_STRING("Item ID",
+                           components["parameters"][id.name()]["description"]);
+  const char *message = "\"Operation completed successfully\"";
+  size_t definition = spec.find(message);
+  TEST_ASSERT_TRUE(definition != std::string::npos);
+  TEST_ASSERT_TRUE(spec.find(message, definition + 1) == std::string::npos);
+}
+
+void register_openapi_components_tests() {
+  RUN_TEST(test_openapi_components_interning);
+  RUN_TEST(test_openapi_components_string_conversion);
+  RUN_TEST(test_openapi_components_factory_opt_in);
+  RUN_TEST(test_openapi_components_in_spec);
+}
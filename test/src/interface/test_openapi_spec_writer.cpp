@@ -0,0 +1,151 @@
+#include "../../include/interface/test_openapi_spec_writer.h"
+#include <ArduinoFake.h>
+#include <ArduinoJson.h>
+#include <interface/openapi_spec_writer.h>
+#include <string>
+#include <testing/alloc_assertions.h>
+#include <unity.h>
+
+namespace {
+
+const char DEVICE_SCHEMA[] = R"({
+    "type": "object",
+    "properties": {
+        "name": {"type": "string", "example": "living room"}
+    }
+})";
+
+std::string writeSpec(std::vector<OpenAPISpecWriter::Operation> &operations) {
+  std::string out;
+  JsonStreamWriter writer([&out](const char *data, size_t length) {
+    out.append(data, length);
+    return true;
+  });
+  OpenAPISpecWriter::Info info;
+  info.title = "Test Device";
+  info.serverUrl = "http://device.local";
+  TEST_ASSERT_TRUE(OpenAPISpecWriter::write(writer, info, operations));
+  return out;
+}
+
+// Specs nest deeper than ArduinoJson's default limit of 10
+DeserializationError parse(JsonDocument &doc, const std::string &spec) {
+  return deserializeJson(doc, spec, DeserializationOption::NestingLimit(16));
+}
+
+} // namespace
+
+void test_openapi_spec_writer_document() {
+  OpenAPIDocumentation list("List devices", "All devices", "listDevices",
+                            {"devices", "inventory"});
+  list.withResponseSchema(DEVICE_SCHEMA).withResponseExample("[]");
+  OpenAPIDocumentation create("Create device");
+  create.withRequestBody(DEVICE_SCHEMA)
+      .withRequestExample(R"({"name": "kitchen"})")
+      .withResponses(R"({"201": {"description": "Created"}})");
+
+  std::vector<OpenAPISpecWriter::Operation> operations = {
+      {"/api/status", WebModule::WM_GET, {AuthType::NONE}, nullptr},
+      {"/api/devices", WebModule::WM_POST, {AuthType::TOKEN}, &create},
+      {"/api/devices", WebModule::WM_GET,
+       {AuthType::TOKEN, AuthType::SESSION}, &list},
+  };
+  std::string spec = writeSpec(operations);
+
+  // Schema text is spliced compacted, not re-serialized
+  TEST_ASSERT_TRUE(spec.find("\"name\":{\"type\":\"string\",\"example\":"
+                             "\"living room\"}") != std::string::npos);
+
+  DynamicJsonDocument doc(8192);
+  TEST_ASSERT_FALSE(parse(doc, spec));
+  TEST_ASSERT_EQUAL_STRING("3.0.3", doc["openapi"]);
+  TEST_ASSERT_EQUAL_STRING("Test Device", doc["info"]["title"]);
+  TEST_ASSERT_EQUAL_STRING("http://device.local", doc["servers"][0]["url"]);
+
+  // Both methods under one path object
+  JsonObject devices = doc["paths"]["/api/devices"];
+  TEST_ASSERT_EQUAL(2, devices.size());
+  JsonObject get = devices["get"];
+  TEST_ASSERT_EQUAL_STRING("listDevices", get["operationId"]);
+  TEST_ASSERT_EQUAL_STRING("inventory", get["tags"][1]);
+  TEST_ASSERT_EQUAL_STRING(
+      "object",
+      get["responses"]["200"]["content"]["application/json"]["schema"]["type"]);
+  TEST_ASSERT_EQUAL(2, get["security"].size());
+  TEST_ASSERT_TRUE(get["security"][0].containsKey("bearerAuth"));
+
+  // A bare schema becomes the JSON request body; stored responses win
+  JsonObject post = devices["post"];
+  JsonObject body = post["requestBody"]["content"]["application/json"];
+  TEST_ASSERT_EQUAL_STRING("object", body["schema"]["type"]);
+  TEST_ASSERT_EQUAL_STRING("kitchen", body["example"]["name"]);
+  TEST_ASSERT_EQUAL_STRING("Created", post["responses"]["201"]["description"]);
+
+  // Undocumented routes still get a valid operation, without security
+  JsonObject status = doc["paths"]["/api/status"]["get"];
+  TEST_ASSERT_TRUE(status["responses"].containsKey("200"));
+  TEST_ASSERT_FALSE(status.containsKey("security"));
+  TEST_ASSERT_TRUE(doc["components"]["securitySchemes"].containsKey(
+      "cookieAuth"));
+}
+
+void test_openapi_spec_writer_operation_defaults() {
+  // Path parameters are declared when the doc does not list any
+  std::vector<OpenAPISpecWriter::Operation> operations = {
+      {"/api/devices/{id}/channels/{channel}", WebModule::WM_DELETE,
+       {AuthType::SESSION}, nullptr}};
+  DynamicJsonDocument doc(4096);
+  TEST_ASSERT_FALSE(parse(doc, writeSpec(operations)));
+  JsonArray params =
+      doc["paths"]["/api/devices/{id}/channels/{channel}"]["delete"]
+         ["parameters"];
+  TEST_ASSERT_EQUAL(2, params.size());
+  TEST_ASSERT_EQUAL_STRING("channel", params[1]["name"]);
+  TEST_ASSERT_EQUAL_STRING("path", params[1]["in"]);
+
+  // A single stored parameter object is wrapped in an array; a full
+  // request body (with "content") is used as is
+  OpenAPIDocumentation docs("Rename");
+  docs.withParameters(R"({"name": "id", "in": "path", "required": true})")
+      .withRequestBody(R"({"content": {"text/plain": {}}})");
+  operations = {{"/api/devices/{id}", WebModule::WM_PUT, {}, &docs}};
+  doc.clear();
+  TEST_ASSERT_FALSE(parse(doc, writeSpec(operations)));
+  JsonObject put = doc["paths"]["/api/devices/{id}"]["put"];
+  TEST_ASSERT_EQUAL(1, put["parameters"].size());
+  TEST_ASSERT_EQUAL_STRING("id", put["parameters"][0]["name"]);
+  TEST_ASSERT_TRUE(put["requestBody"]["content"].containsKey("text/plain"));
+  TEST_ASSERT_FALSE(put["requestBody"].containsKey("required"));
+}
+
+void test_openapi_spec_writer_streams_without_heap() {
+  OpenAPIDocumentation docs("Device", "One device", "getDevice");
+  docs.withResponseSchema(DEVICE_SCHEMA);
+  std::vector<OpenAPISpecWriter::Operation> operations;
+  static char paths[100][24];
+  for (int i = 0; i < 100; i++) {
+    snprintf(paths[i], sizeof(paths[i]), "/api/devices%d", i);
+    operations.push_back(OpenAPISpecWriter::Operation{
+        paths[i], WebModule::WM_GET, {AuthType::TOKEN}, &docs});
+  }
+
+  size_t bytes = 0;
+  size_t largestChunk = 0;
+  JsonStreamWriter writer([&](const char *data, size_t length) {
+    bytes += length;
+    largestChunk = length > largestChunk ? length : largestChunk;
+    return true;
+  });
+  OpenAPISpecWriter::Info info;
+
+  // The spec never exists in memory: chunks of the writer's buffer only
+  TEST_ASSERT_NO_ALLOCS(OpenAPISpecWriter::write(writer, info, operations));
+  TEST_ASSERT_TRUE(bytes > 100 * strlen("{\"type\":\"object\"}"));
+  TEST_ASSERT_TRUE(largestChunk <= JSON_STREAM_BUFFER_SIZE);
+}
+
+void register_openapi_spec_writer_tests() {
+  RUN_TEST(test_openapi_spec_writer_document);
+  RUN_TEST(test_openapi_spec_writer_operation_defaults);
+  RUN_TEST(test_openapi_spec_writer_streams_without_heap);
+}
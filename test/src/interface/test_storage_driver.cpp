@@ -0,0 +1,79 @@
+#include "../../include/interface/test_storage_driver.h"
+#include <ArduinoFake.h>
+#include <interface/storage_driver.h>
+#include <unity.h>
+
+namespace {
+
+// Minimal driver: every object is `size` zero bytes
+class NullDriver : public IStorageDriver {
+public:
+  explicit NullDriver(size_t size) : objectSize(size) {}
+  Handle open(const String &collection, const String &key) override {
+    return 0;
+  }
+  size_t size(Handle handle) const override { return objectSize; }
+  bool seek(Handle handle, size_t offset) override {
+    return offset <= objectSize;
+  }
+  size_t read(Handle handle, uint8_t *buffer, size_t length) override {
+    return 0;
+  }
+  void close(Handle handle) override {}
+
+private:
+  size_t objectSize;
+};
+
+} // namespace
+
+void test_storage_driver_registry() {
+  NullDriver flash(1);
+  NullDriver sd(2);
+  NullDriver replacement(3);
+  size_t before = StorageDriverRegistry::count();
+
+  StorageDriverRegistry::registerDriver("test-flash", &flash);
+  StorageDriverRegistry::registerDriver("test-sd", &sd);
+  TEST_ASSERT_EQUAL(before + 2, StorageDriverRegistry::count());
+  TEST_ASSERT_EQUAL_PTR(&sd, StorageDriverRegistry::getDriver("test-sd"));
+  TEST_ASSERT_NULL(StorageDriverRegistry::getDriver("test-missing"));
+
+  // Same name replaces; null drivers are ignored
+  StorageDriverRegistry::registerDriver("test-sd", &replacement);
+  StorageDriverRegistry::registerDriver("test-null", nullptr);
+  TEST_ASSERT_EQUAL(before + 2, StorageDriverRegistry::count());
+  TEST_ASSERT_EQUAL_PTR(&replacement,
+                        StorageDriverRegistry::getDriver("test-sd"));
+
+  StorageDriverRegistry::unregisterDriver("test-flash");
+  StorageDriverRegistry::unregisterDriver("test-sd");
+  TEST_ASSERT_NULL(StorageDriverRegistry::getDriver("test-sd"));
+  TEST_ASSERT_EQUAL(before, StorageDriverRegistry::count());
+}
+
+void test_storage_driver_defaults() {
+  NullDriver first(1);
+  NullDriver second(2);
+  TEST_ASSERT_EQUAL(0, StorageDriverRegistry::count());
+  TEST_ASSERT_NULL(StorageDriverRegistry::getDriver(""));
+
+  // The first registration becomes the default
+  StorageDriverRegistry::registerDriver("first", &first);
+  StorageDriverRegistry::registerDriver("second", &second);
+  TEST_ASSERT_EQUAL_PTR(&first, StorageDriverRegistry::getDriver(""));
+  StorageDriverRegistry::setDefaultDriver("second");
+  TEST_ASSERT_EQUAL_PTR(&second, StorageDriverRegistry::getDriver(""));
+
+  // Removing the default falls back to the oldest remaining driver
+  StorageDriverRegistry::unregisterDriver("second");
+  TEST_ASSERT_EQUAL_PTR(&first, StorageDriverRegistry::getDriver(""));
+  TEST_ASSERT_NULL(first.contiguousView(0));
+  StorageDriverRegistry::unregisterDriver("first");
+  TEST_ASSERT_NULL(StorageDriverRegistry::getDriver(""));
+}
+
+void register_storage_driver_tests() {
+  RUN_TEST(test_storage_driver_registry);
+  RUN_TEST(test_storage_driver_defaults);
+}
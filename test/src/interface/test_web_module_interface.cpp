@@ -468,6 +468,24 @@ void test_iweb_module_default_implementations() {
   TEST_ASSERT_EQUAL(httpRoutes.size(), webRoutes.size());
 }
 
+// Test the default forEachRoute() wrapper over the vector methods
+void test_web_module_for_each_route() {
+  TestWebModuleImpl module;
+  std::vector<String> paths;
+  IWebModule::RouteVisitor collect = [&paths](const RouteVariant &route) {
+    paths.push_back(route.getWebRoute().path);
+  };
+
+  module.forEachRoute(collect, WebModule::TRANSPORT_HTTP);
+  TEST_ASSERT_EQUAL(1, paths.size());
+  TEST_ASSERT_EQUAL_STRING("/module/http", paths[0].c_str());
+
+  paths.clear();
+  module.forEachRoute(collect, WebModule::TRANSPORT_HTTPS);
+  TEST_ASSERT_EQUAL(1, paths.size());
+  TEST_ASSERT_EQUAL_STRING("/module/https", paths[0].c_str());
+}
+
 // Registration function
 void register_web_module_interface_tests() {
   RUN_TEST(test_web_route_full_constructors);
@@ -480,4 +498,5 @@ void register_web_module_interface_tests() {
   RUN_TEST(test_basic_route_creation);
   RUN_TEST(test_api_path_warning);
   RUN_TEST(test_iweb_module_default_implementations);
+  RUN_TEST(test_web_module_for_each_route);
 }
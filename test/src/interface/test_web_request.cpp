@@ -218,6 +218,31 @@ void test_web_request_constants() {
   TEST_ASSERT_TRUE(found_content_type);
 }
 
+void test_web_request_header_ids() {
+  // Every common header maps back to its own id, in any case
+  for (size_t i = 0; i < COMMON_HTTP_HEADERS_COUNT; i++) {
+    HeaderId id = static_cast<HeaderId>(i);
+    TEST_ASSERT_EQUAL_STRING(COMMON_HTTP_HEADERS[i], HttpHeaders::name(id));
+    TEST_ASSERT_TRUE(HttpHeaders::idFromName(COMMON_HTTP_HEADERS[i]) == id);
+  }
+  TEST_ASSERT_TRUE(HttpHeaders::idFromName("AUTHORIZATION") ==
+                   HeaderId::AUTHORIZATION);
+  TEST_ASSERT_TRUE(HttpHeaders::idFromName("x-csrf-token") ==
+                   HeaderId::X_CSRF_TOKEN);
+
+  // Names sharing a hash slot with a common header are still rejected
+  TEST_ASSERT_TRUE(HttpHeaders::idFromName("Accent") == HeaderId::UNKNOWN);
+  TEST_ASSERT_TRUE(HttpHeaders::idFromName("Hxst") == HeaderId::UNKNOWN);
+  TEST_ASSERT_TRUE(HttpHeaders::idFromName("") == HeaderId::UNKNOWN);
+  TEST_ASSERT_EQUAL_STRING("", HttpHeaders::name(HeaderId::UNKNOWN));
+
+  MockWebRequest request;
+  request.setMockHeader("Cookie", "session=abc");
+  TEST_ASSERT_TRUE(request.headerView(HeaderId::COOKIE) == "session=abc");
+  TEST_ASSERT_EQUAL_STRING("",
+                           request.getHeader(HeaderId::AUTHORIZATION).c_str());
+}
+
 void test_auth_context_construction() {
   // Test AuthContext can be constructed and has expected defaults
   AuthContext context;
@@ -282,6 +307,20 @@ void test_auth_context_helper_methods() {
   TEST_ASSERT_EQUAL(0, context.authenticatedAt);
 }
 
+void test_web_request_views() {
+  MockWebRequest request("/devices/7");
+  request.setParam("mode", "auto");
+  request.setMockHeader("Content-Type", "application/json");
+  request.setBody("{}");
+
+  TEST_ASSERT_TRUE(request.pathView() == "/devices/7");
+  TEST_ASSERT_TRUE(request.bodyView() == "{}");
+  TEST_ASSERT_TRUE(request.paramView("mode") == "auto");
+  TEST_ASSERT_TRUE(request.paramView("missing").empty());
+  TEST_ASSERT_TRUE(request.headerView("content-type") == "application/json");
+  TEST_ASSERT_TRUE(request.headerView("Accept").empty());
+}
+
 void register_web_request_tests() {
   RUN_TEST(test_web_request_path_access);
   RUN_TEST(test_web_request_method_access);
@@ -294,7 +333,9 @@ void register_web_request_tests() {
   RUN_TEST(test_web_request_module_base_path);
   RUN_TEST(test_web_request_client_ip);
   RUN_TEST(test_web_request_constants);
+  RUN_TEST(test_web_request_header_ids);
   RUN_TEST(test_auth_context_construction);
   RUN_TEST(test_auth_context_assignment);
   RUN_TEST(test_auth_context_helper_methods);
+  RUN_TEST(test_web_request_views);
 }
@@ -103,6 +103,123 @@ void test_web_response_progmem_data_content() {
   TEST_ASSERT_EQUAL_STRING(progmemContent, content.c_str());
 }
 
+// Pre-compressed assets follow the bound request's Accept-Encoding
+void test_web_response_progmem_asset() {
+  static const uint8_t IDENTITY[] = {'h', 'i', '!', 0};
+  static const uint8_t GZIP[] = {0x1f, 0x8b, 0x00, 0x01}; // Binary, has NUL
+  static const uint8_t BROTLI[] = {0x0b, 0x01};
+  ProgmemAsset asset = {"/hi.txt", "text/plain", IDENTITY, 3,      GZIP,
+                        4,         BROTLI,       2,        nullptr};
+
+  // No bound request: identity
+  WebResponse plain;
+  plain.setProgmemContent(asset);
+  TEST_ASSERT_EQUAL(3, plain.getProgmemLength());
+  TEST_ASSERT_EQUAL_STRING("", plain.getHeader("Content-Encoding").c_str());
+  TEST_ASSERT_EQUAL_STRING("Accept-Encoding",
+                           plain.getHeader("Vary").c_str());
+
+  const char raw[] = "GET /hi.txt HTTP/1.1\r\n"
+                     "Accept-Encoding: gzip, deflate\r\n\r\n";
+  WebRequest request(raw, sizeof(raw) - 1);
+  WebResponse gzip;
+  gzip.bindRequest(request);
+  gzip.setProgmemContent(asset);
+  TEST_ASSERT_EQUAL_STRING("gzip", gzip.getHeader("Content-Encoding").c_str());
+  TEST_ASSERT_EQUAL_PTR(GZIP, gzip.getProgmemData());
+  TEST_ASSERT_EQUAL(4, gzip.getProgmemLength());
+  TEST_ASSERT_EQUAL(4, gzip.getContent().length());
+  TEST_ASSERT_EQUAL_STRING("text/plain", gzip.getMimeType().c_str());
+
+  // Plain PROGMEM text afterwards is NUL-terminated again
+  gzip.setProgmemContent("abc", "text/plain");
+  TEST_ASSERT_EQUAL(3, gzip.getProgmemLength());
+
+  const char brRaw[] = "GET /hi.txt HTTP/1.1\r\n"
+                       "Accept-Encoding: gzip;q=0.8, br\r\n\r\n";
+  WebRequest brRequest(brRaw, sizeof(brRaw) - 1);
+  WebResponse brotli;
+  brotli.bindRequest(brRequest);
+  brotli.setProgmemContent(asset);
+  TEST_ASSERT_EQUAL_STRING("br", brotli.getHeader("Content-Encoding").c_str());
+  TEST_ASSERT_EQUAL(2, brotli.getProgmemLength());
+}
+
+// ETag validators answer If-None-Match with 304 and no content
+void test_web_response_etag() {
+  WebResponse unbound;
+  TEST_ASSERT_FALSE(unbound.setETag("\"v1\""));
+  TEST_ASSERT_EQUAL_STRING("\"v1\"", unbound.getHeader("ETag").c_str());
+
+  const char raw[] = "GET /hi.txt HTTP/1.1\r\n"
+                     "Accept-Encoding: gzip\r\n"
+                     "If-None-Match: \"v0\", \"v1-gzip\"\r\n\r\n";
+  WebRequest request(raw, sizeof(raw) - 1);
+  WebResponse stale;
+  stale.bindRequest(request);
+  TEST_ASSERT_FALSE(stale.setETag("\"v2\""));
+
+  // Each encoding is tagged separately; the gzip copy is the cached one
+  static const uint8_t IDENTITY[] = {'h', 'i', '!', 0};
+  static const uint8_t GZIP[] = {0x1f, 0x8b, 0x00, 0x01};
+  ProgmemAsset asset = {"/hi.txt", "text/plain", IDENTITY, 3, GZIP,
+                        4,         nullptr,      0,        "\"v1\""};
+  WebResponse notModified;
+  notModified.bindRequest(request);
+  notModified.setProgmemContent(asset);
+  TEST_ASSERT_FALSE(notModified.hasProgmemContent());
+  TEST_ASSERT_EQUAL_STRING("\"v1-gzip\"",
+                           notModified.getHeader("ETag").c_str());
+  TEST_ASSERT_EQUAL_STRING("Accept-Encoding",
+                           notModified.getHeader("Vary").c_str());
+
+  WebResponse identity;
+  identity.setProgmemContent(asset);
+  TEST_ASSERT_TRUE(identity.hasProgmemContent());
+  TEST_ASSERT_EQUAL_STRING("\"v1\"", identity.getHeader("ETag").c_str());
+}
+
+// Storage ranges follow the bound request's Range and If-Range
+void test_web_response_resolve_range() {
+  ByteRange range;
+  WebResponse unbound;
+  TEST_ASSERT_EQUAL(HttpRange::Outcome::FULL, unbound.resolveRange(50, range));
+  TEST_ASSERT_EQUAL(50, range.length);
+  TEST_ASSERT_EQUAL_STRING("bytes", unbound.getHeader("Accept-Ranges").c_str());
+
+  const char raw[] = "GET /log HTTP/1.1\r\n"
+                     "Range: bytes=10-\r\n"
+                     "If-Range: \"v1\"\r\n\r\n";
+  WebRequest request(raw, sizeof(raw) - 1);
+  WebResponse partial;
+  partial.bindRequest(request);
+  partial.setStorageStreamContent("logs", "boot", "text/plain");
+  partial.setHeader("ETag", "\"v1\"");
+  TEST_ASSERT_EQUAL(HttpRange::Outcome::PARTIAL,
+                    partial.resolveRange(50, range));
+  TEST_ASSERT_EQUAL(10, range.offset);
+  TEST_ASSERT_EQUAL(40, range.length);
+  TEST_ASSERT_EQUAL_STRING("bytes 10-49/50",
+                           partial.getHeader("Content-Range").c_str());
+
+  // The object changed since the client's copy: send all of it
+  WebResponse changed;
+  changed.bindRequest(request);
+  changed.setHeader("ETag", "\"v2\"");
+  TEST_ASSERT_EQUAL(HttpRange::Outcome::FULL, changed.resolveRange(50, range));
+  TEST_ASSERT_EQUAL(0, range.offset);
+  TEST_ASSERT_EQUAL_STRING("", changed.getHeader("Content-Range").c_str());
+
+  WebResponse beyond;
+  beyond.bindRequest(request);
+  beyond.setHeader("ETag", "\"v1\"");
+  TEST_ASSERT_EQUAL(HttpRange::Outcome::UNSATISFIABLE,
+                    beyond.resolveRange(5, range));
+  TEST_ASSERT_EQUAL(0, range.length);
+  TEST_ASSERT_EQUAL_STRING("bytes */5",
+                           beyond.getHeader("Content-Range").c_str());
+}
+
 // Test setHeader method
 void test_web_response_set_headers() {
   WebResponse response;
@@ -170,6 +287,38 @@ void test_web_response_set_json_content() {
   TEST_ASSERT_EQUAL_STRING("application/json", response.getMimeType().c_str());
 }
 
+// Test setJsonStreamContent method
+void test_web_response_json_stream_content() {
+  WebResponse response;
+  int deviceCount = 3;
+  response.setJsonStreamContent([deviceCount](JsonStreamWriter &json) {
+    json.beginObject().key("devices").beginArray();
+    for (int i = 0; i < deviceCount; i++) {
+      json.beginObject().member("id", i).endObject();
+    }
+    json.endArray().endObject();
+  });
+
+  TEST_ASSERT_TRUE(response.hasJsonStreamContent());
+  TEST_ASSERT_EQUAL_STRING("application/json", response.getMimeType().c_str());
+  TEST_ASSERT_EQUAL_STRING("{\"devices\":[{\"id\":0},{\"id\":1},{\"id\":2}]}",
+                           response.getContent().c_str());
+
+  // The callback runs each time the body is written
+  size_t total = 0;
+  size_t bytes = response.writeJsonStream([&total](const char *, size_t n) {
+    total += n;
+    return true;
+  });
+  TEST_ASSERT_EQUAL(total, bytes);
+  TEST_ASSERT_EQUAL(response.getContent().length(), bytes);
+
+  // Other content replaces the stream
+  response.setContent("plain", "text/plain");
+  TEST_ASSERT_FALSE(response.hasJsonStreamContent());
+  TEST_ASSERT_EQUAL_STRING("plain", response.getContent().c_str());
+}
+
 // Test sendTo method
 void test_web_response_send_to() {
   WebResponse response;
@@ -232,10 +381,14 @@ void register_web_response_tests() {
 
   // Re-enable one enhanced test to see if it causes the crash
   RUN_TEST(test_web_response_progmem_data_content);
+  RUN_TEST(test_web_response_progmem_asset);
+  RUN_TEST(test_web_response_etag);
+  RUN_TEST(test_web_response_resolve_range);
 
   RUN_TEST(test_web_response_set_headers);
   RUN_TEST(test_web_response_redirect);
   RUN_TEST(test_web_response_set_json_content);
+  RUN_TEST(test_web_response_json_stream_content);
   RUN_TEST(test_web_response_send_to);
 
   // Re-enable with our safer implementation
@@ -0,0 +1,53 @@
+#include "../../../include/interface/utils/test_content_encoding.h"
+#include <ArduinoFake.h>
+#include <interface/utils/content_encoding.h>
+#include <unity.h>
+
+using ContentEncodings::negotiate;
+using ContentEncodings::quality;
+
+void test_content_encoding_quality() {
+  TEST_ASSERT_EQUAL(1000, quality("gzip, deflate", "gzip"));
+  TEST_ASSERT_EQUAL(1000, quality("GZIP", "gzip"));
+  TEST_ASSERT_EQUAL(0, quality("deflate", "gzip"));
+  TEST_ASSERT_EQUAL(500, quality("br;q=0.5, gzip", "br"));
+  TEST_ASSERT_EQUAL(125, quality("gzip ; q=0.125", "gzip"));
+  TEST_ASSERT_EQUAL(0, quality("gzip;q=0", "gzip"));
+  TEST_ASSERT_EQUAL(1000, quality("gzip;q=1.0", "gzip"));
+
+  // Wildcard covers unlisted codings; identity is acceptable by default
+  TEST_ASSERT_EQUAL(300, quality("*;q=0.3, gzip", "br"));
+  TEST_ASSERT_EQUAL(1000, quality("gzip", "identity"));
+  TEST_ASSERT_EQUAL(0, quality("gzip, *;q=0", "identity"));
+  TEST_ASSERT_EQUAL(1000, quality("", "identity"));
+}
+
+void test_content_encoding_negotiate() {
+  TEST_ASSERT_EQUAL(ContentEncoding::IDENTITY, negotiate("", true, true));
+  TEST_ASSERT_EQUAL(ContentEncoding::GZIP,
+                    negotiate("gzip, deflate", true, true));
+  TEST_ASSERT_EQUAL(ContentEncoding::BROTLI,
+                    negotiate("gzip, deflate, br", true, true));
+  TEST_ASSERT_EQUAL(ContentEncoding::GZIP,
+                    negotiate("gzip, deflate, br", true, false));
+  TEST_ASSERT_EQUAL(ContentEncoding::IDENTITY,
+                    negotiate("gzip, deflate, br", false, false));
+
+  // Quality beats size; refused codings are never chosen
+  TEST_ASSERT_EQUAL(ContentEncoding::GZIP,
+                    negotiate("br;q=0.5, gzip", true, true));
+  TEST_ASSERT_EQUAL(ContentEncoding::IDENTITY,
+                    negotiate("gzip;q=0", true, false));
+  TEST_ASSERT_EQUAL(ContentEncoding::GZIP,
+                    negotiate("identity;q=0, *", true, false));
+
+  TEST_ASSERT_EQUAL_STRING("gzip", ContentEncodings::name(negotiate(
+                                       "gzip", true, false)));
+  TEST_ASSERT_EQUAL_STRING("br",
+                           ContentEncodings::name(ContentEncoding::BROTLI));
+}
+
+void register_content_encoding_tests() {
+  RUN_TEST(test_content_encoding_quality);
+  RUN_TEST(test_content_encoding_negotiate);
+}
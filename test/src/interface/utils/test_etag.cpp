@@ -0,0 +1,43 @@
+#include "../../../include/interface/utils/test_etag.h"
+#include <ArduinoFake.h>
+#include <interface/utils/etag.h>
+#include <unity.h>
+
+void test_etag_format_and_compute() {
+  TEST_ASSERT_EQUAL_STRING("\"00000000000000ff\"",
+                           ETag::format(0xff).c_str());
+  TEST_ASSERT_EQUAL_STRING("W/\"0123456789abcdef\"",
+                           ETag::format(0x0123456789abcdefULL, true).c_str());
+
+  // FNV-1a 64: empty input is the offset basis; chunking does not matter
+  TEST_ASSERT_EQUAL_STRING("\"cbf29ce484222325\"",
+                           ETag::compute(nullptr, 0).c_str());
+  const uint8_t body[] = {'a', 'b', 'c', 'd'};
+  ETag::Hasher hasher;
+  hasher.update("ab", 2);
+  hasher.update("cd", 2);
+  TEST_ASSERT_EQUAL_STRING(ETag::compute(body, sizeof(body)).c_str(),
+                           ETag::format(hasher.digest()).c_str());
+  TEST_ASSERT_FALSE(ETag::compute(body, 3) == ETag::compute(body, 4));
+}
+
+void test_etag_matches() {
+  TEST_ASSERT_TRUE(ETag::matches("\"abc\"", "\"abc\""));
+  TEST_ASSERT_FALSE(ETag::matches("\"abd\"", "\"abc\""));
+  TEST_ASSERT_FALSE(ETag::matches("", "\"abc\""));
+  TEST_ASSERT_FALSE(ETag::matches("\"abc\"", ""));
+
+  // If-None-Match uses weak comparison
+  TEST_ASSERT_TRUE(ETag::matches("W/\"abc\"", "\"abc\""));
+  TEST_ASSERT_TRUE(ETag::matches("\"abc\"", "W/\"abc\""));
+
+  // Lists and the wildcard
+  TEST_ASSERT_TRUE(ETag::matches("\"x\", W/\"abc\" ,\"y\"", "\"abc\""));
+  TEST_ASSERT_FALSE(ETag::matches("\"x\", \"y\"", "\"abc\""));
+  TEST_ASSERT_TRUE(ETag::matches("*", "\"abc\""));
+}
+
+void register_etag_tests() {
+  RUN_TEST(test_etag_format_and_compute);
+  RUN_TEST(test_etag_matches);
+}
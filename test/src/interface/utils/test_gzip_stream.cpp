@@ -0,0 +1,129 @@
+#include "../../../include/interface/utils/test_gzip_stream.h"
+#include "../../../include/testing/gzip_test_decoder.h"
+#include <ArduinoFake.h>
+#include <interface/route_types.h>
+#include <interface/utils/gzip_stream.h>
+#include <string>
+#include <unity.h>
+
+namespace {
+
+std::string compress(const std::string &input, uint8_t windowBits,
+                     size_t chunk) {
+  std::string out;
+  GzipStream gzip(
+      [&out](const char *data, size_t length) {
+        out.append(data, length);
+        return true;
+      },
+      windowBits);
+  for (size_t pos = 0; pos < input.size(); pos += chunk) {
+    size_t count = input.size() - pos < chunk ? input.size() - pos : chunk;
+    gzip.write(input.data() + pos, count);
+  }
+  TEST_ASSERT_TRUE(gzip.finish());
+  TEST_ASSERT_EQUAL(input.size(), gzip.bytesIn());
+  TEST_ASSERT_EQUAL(out.size(), gzip.bytesOut());
+  return out;
+}
+
+std::string deviceList(size_t count) {
+  std::string json = "[";
+  for (size_t i = 0; i < count; i++) {
+    json += i ? "," : "";
+    json += "{\"id\":" + std::to_string(i) + ",\"name\":\"Device " +
+            std::to_string(i) + "\",\"on\":" + (i % 2 ? "true" : "false") +
+            "}";
+  }
+  return json + "]";
+}
+
+} // namespace
+
+void test_gzip_stream_round_trip() {
+  std::string noise;
+  uint32_t state = 1;
+  for (int i = 0; i < 5000; i++) {
+    state = state * 1103515245u + 12345u;
+    noise += static_cast<char>(state >> 24);
+  }
+  const std::string inputs[] = {"", "a", std::string(70000, 'z'),
+                                deviceList(800), noise};
+
+  for (uint8_t windowBits : {9, 10, 14}) {
+    for (const std::string &input : inputs) {
+      for (size_t chunk : {static_cast<size_t>(7), input.size() + 1}) {
+        std::string decoded;
+        TEST_ASSERT_TRUE(
+            gzipTestDecode(compress(input, windowBits, chunk), decoded));
+        TEST_ASSERT_TRUE(decoded == input);
+      }
+    }
+  }
+
+  // Highly repetitive JSON shrinks several times over
+  std::string json = deviceList(800);
+  TEST_ASSERT_LESS_THAN(json.size() / 4, compress(json, 10, 256).size());
+}
+
+void test_gzip_stream_trailer() {
+  std::string out = compress("123456789", 10, 100);
+  // CRC-32 check value, then the input size, little endian
+  TEST_ASSERT_EQUAL_HEX8(0x26, static_cast<uint8_t>(out[out.size() - 8]));
+  TEST_ASSERT_EQUAL_HEX8(0x39, static_cast<uint8_t>(out[out.size() - 7]));
+  TEST_ASSERT_EQUAL_HEX8(0xf4, static_cast<uint8_t>(out[out.size() - 6]));
+  TEST_ASSERT_EQUAL_HEX8(0xcb, static_cast<uint8_t>(out[out.size() - 5]));
+  TEST_ASSERT_EQUAL(9, static_cast<uint8_t>(out[out.size() - 4]));
+
+  TEST_ASSERT_EQUAL(5 * 1024, GzipStream::memoryFor(10));
+  TEST_ASSERT_EQUAL(GzipStream::memoryFor(9), GzipStream::memoryFor(1));
+  TEST_ASSERT_EQUAL(GzipStream::memoryFor(14), GzipStream::memoryFor(20));
+}
+
+void test_gzip_stream_sink_failure() {
+  int calls = 0;
+  GzipStream gzip([&calls](const char *data, size_t length) {
+    calls++;
+    return false;
+  });
+  std::string input(20000, 'x');
+  for (int i = 0; i < 10 && gzip.write(input.data(), input.size()); i++) {
+  }
+  TEST_ASSERT_FALSE(gzip.ok());
+  TEST_ASSERT_FALSE(gzip.finish());
+  TEST_ASSERT_EQUAL(1, calls);
+}
+
+void test_gzip_stream_policy() {
+  ResponseCompressionPolicy policy;
+  TEST_ASSERT_FALSE(policy.appliesTo("gzip", "application/json", 5000));
+
+  policy.windowBits = 10;
+  policy.minBytes = 1000;
+  TEST_ASSERT_TRUE(policy.appliesTo("gzip, br", "application/json", 5000));
+  TEST_ASSERT_FALSE(policy.appliesTo("br", "application/json", 5000));
+  TEST_ASSERT_FALSE(policy.appliesTo("gzip;q=0", "text/html", 5000));
+  TEST_ASSERT_FALSE(policy.appliesTo("gzip", "application/json", 999));
+  TEST_ASSERT_TRUE(policy.appliesTo(
+      "gzip", "application/json", ResponseCompressionPolicy::UNKNOWN_LENGTH));
+
+  policy.mimeTypes = "application/json, text/";
+  TEST_ASSERT_TRUE(policy.appliesTo("gzip", "text/html", 5000));
+  TEST_ASSERT_TRUE(policy.appliesTo("gzip", "Application/JSON", 5000));
+  TEST_ASSERT_FALSE(policy.appliesTo("gzip", "image/png", 5000));
+
+  // Route opt-in
+  WebRoute route =
+      WebRoute("/list", WebModule::WM_GET, [](WebRequest &, WebResponse &) {})
+          .compressed(12, 256);
+  TEST_ASSERT_EQUAL(12, route.compressionPolicy.windowBits);
+  TEST_ASSERT_EQUAL(256, route.compressionPolicy.minBytes);
+  TEST_ASSERT_NULL(route.compressionPolicy.mimeTypes);
+}
+
+void register_gzip_stream_tests() {
+  RUN_TEST(test_gzip_stream_round_trip);
+  RUN_TEST(test_gzip_stream_trailer);
+  RUN_TEST(test_gzip_stream_sink_failure);
+  RUN_TEST(test_gzip_stream_policy);
+}
@@ -0,0 +1,79 @@
+#include "../../../include/interface/utils/test_http_range.h"
+#include <ArduinoFake.h>
+#include <interface/utils/http_range.h>
+#include <unity.h>
+
+using HttpRange::Outcome;
+
+namespace {
+
+Outcome parse(const char *header, size_t size, ByteRange &range) {
+  return HttpRange::parse(header, size, range);
+}
+
+} // namespace
+
+void test_http_range_parse() {
+  ByteRange range;
+  TEST_ASSERT_EQUAL(Outcome::PARTIAL, parse("bytes=0-499", 1000, range));
+  TEST_ASSERT_EQUAL(0, range.offset);
+  TEST_ASSERT_EQUAL(500, range.length);
+  TEST_ASSERT_EQUAL_STRING("bytes 0-499/1000",
+                           HttpRange::contentRange(range, 1000).c_str());
+
+  // Open-ended and clamped to the object
+  TEST_ASSERT_EQUAL(Outcome::PARTIAL, parse("bytes=900-", 1000, range));
+  TEST_ASSERT_EQUAL(900, range.offset);
+  TEST_ASSERT_EQUAL(100, range.length);
+  TEST_ASSERT_EQUAL(Outcome::PARTIAL, parse("Bytes= 990-5000", 1000, range));
+  TEST_ASSERT_EQUAL(10, range.length);
+
+  // Suffix ranges
+  TEST_ASSERT_EQUAL(Outcome::PARTIAL, parse("bytes=-100", 1000, range));
+  TEST_ASSERT_EQUAL(900, range.offset);
+  TEST_ASSERT_EQUAL(100, range.length);
+  TEST_ASSERT_EQUAL(Outcome::PARTIAL, parse("bytes=-5000", 1000, range));
+  TEST_ASSERT_EQUAL(0, range.offset);
+  TEST_ASSERT_EQUAL(1000, range.length);
+}
+
+void test_http_range_rejects() {
+  ByteRange range;
+  // Several ranges are refused rather than sent as multipart
+  TEST_ASSERT_EQUAL(Outcome::UNSATISFIABLE,
+                    parse("bytes=0-99,200-299", 1000, range));
+  TEST_ASSERT_EQUAL(Outcome::UNSATISFIABLE, parse("bytes=1000-", 1000, range));
+  TEST_ASSERT_EQUAL(Outcome::UNSATISFIABLE, parse("bytes=-0", 1000, range));
+  TEST_ASSERT_EQUAL_STRING("bytes */1000",
+                           HttpRange::unsatisfiedRange(1000).c_str());
+
+  // Malformed or foreign units are ignored: whole object
+  TEST_ASSERT_EQUAL(Outcome::FULL, parse("items=0-5", 1000, range));
+  TEST_ASSERT_EQUAL(Outcome::FULL, parse("bytes=5-1", 1000, range));
+  TEST_ASSERT_EQUAL(Outcome::FULL, parse("bytes=a-", 1000, range));
+  TEST_ASSERT_EQUAL(Outcome::FULL,
+                    parse("bytes=99999999999999999999999-", 1000, range));
+  TEST_ASSERT_EQUAL(Outcome::FULL, parse("", 1000, range));
+  TEST_ASSERT_EQUAL(0, range.offset);
+  TEST_ASSERT_EQUAL(1000, range.length);
+}
+
+void test_http_range_if_range() {
+  const char *date = "Wed, 21 Oct 2026 07:28:00 GMT";
+  TEST_ASSERT_TRUE(HttpRange::ifRangeHolds("", "\"v1\"", ""));
+  TEST_ASSERT_TRUE(HttpRange::ifRangeHolds("\"v1\"", "\"v1\"", ""));
+  TEST_ASSERT_FALSE(HttpRange::ifRangeHolds("\"v0\"", "\"v1\"", ""));
+
+  // Weak tags never validate a range
+  TEST_ASSERT_FALSE(HttpRange::ifRangeHolds("W/\"v1\"", "W/\"v1\"", ""));
+  TEST_ASSERT_FALSE(HttpRange::ifRangeHolds("\"v1\"", "W/\"v1\"", ""));
+
+  TEST_ASSERT_TRUE(HttpRange::ifRangeHolds(date, "", date));
+  TEST_ASSERT_FALSE(HttpRange::ifRangeHolds(date, "\"v1\"", ""));
+}
+
+void register_http_range_tests() {
+  RUN_TEST(test_http_range_parse);
+  RUN_TEST(test_http_range_rejects);
+  RUN_TEST(test_http_range_if_range);
+}
@@ -0,0 +1,131 @@
+#include "../../../include/interface/utils/test_inplace_function.h"
+#include <ArduinoFake.h>
+#include <functional>
+#include <interface/route_types.h>
+#include <interface/utils/inplace_function.h>
+#include <memory>
+#include <unity.h>
+
+typedef InplaceFunction<int(int)> IntFunction;
+
+static int doubleValue(int value) { return value * 2; }
+
+static int addContext(void *context, int value) {
+  return *static_cast<int *>(context) + value;
+}
+
+void test_inplace_function_lambda_captures() {
+  int offset = 10;
+  int *counter = &offset;
+  IntFunction add = [offset, counter](int value) {
+    (*counter)++;
+    return value + offset;
+  };
+  TEST_ASSERT_TRUE(static_cast<bool>(add));
+  TEST_ASSERT_EQUAL(15, add(5));
+  TEST_ASSERT_EQUAL(11, offset);
+
+  IntFunction pointer = &doubleValue;
+  TEST_ASSERT_EQUAL(8, pointer(4));
+}
+
+void test_inplace_function_copy_and_move() {
+  int calls = 0;
+  IntFunction original = [&calls](int value) {
+    calls++;
+    return value + 1;
+  };
+
+  IntFunction copy = original;
+  TEST_ASSERT_EQUAL(2, copy(1));
+  TEST_ASSERT_EQUAL(3, original(2));
+  TEST_ASSERT_EQUAL(2, calls);
+
+  IntFunction moved = std::move(copy);
+  TEST_ASSERT_EQUAL(4, moved(3));
+
+  IntFunction assigned;
+  assigned = original;
+  TEST_ASSERT_EQUAL(5, assigned(4));
+  assigned = &doubleValue;
+  TEST_ASSERT_EQUAL(10, assigned(5));
+  TEST_ASSERT_EQUAL(4, calls);
+}
+
+void test_inplace_function_context_pointer() {
+  int base = 100;
+  IntFunction bound(&addContext, &base);
+  TEST_ASSERT_TRUE(static_cast<bool>(bound));
+  TEST_ASSERT_EQUAL(105, bound(5));
+
+  base = 200;
+  IntFunction copy = bound;
+  TEST_ASSERT_EQUAL(201, copy(1));
+}
+
+void test_inplace_function_empty() {
+  IntFunction empty;
+  TEST_ASSERT_FALSE(static_cast<bool>(empty));
+  TEST_ASSERT_EQUAL(0, empty(3)); // No-op, returns R()
+
+  int (*nullPointer)(int) = nullptr;
+  TEST_ASSERT_FALSE(static_cast<bool>(IntFunction(nullPointer)));
+  TEST_ASSERT_FALSE(static_cast<bool>(IntFunction(std::function<int(int)>())));
+  TEST_ASSERT_FALSE(static_cast<bool>(IntFunction(nullptr, nullptr)));
+
+  // Function references and captureless lambdas are never empty
+  TEST_ASSERT_TRUE(static_cast<bool>(IntFunction(doubleValue)));
+  TEST_ASSERT_TRUE(static_cast<bool>(IntFunction([](int value) {
+    return value;
+  })));
+
+  IntFunction reset = &doubleValue;
+  reset = nullptr;
+  TEST_ASSERT_FALSE(static_cast<bool>(reset));
+}
+
+void test_inplace_function_non_trivial_callable() {
+  // shared_ptr use_count tracks copies and destruction of the capture
+  std::shared_ptr<int> state(new int(7));
+  {
+    IntFunction first = [state](int value) { return *state + value; };
+    TEST_ASSERT_EQUAL(2, state.use_count());
+
+    IntFunction second = first;
+    TEST_ASSERT_EQUAL(3, state.use_count());
+    TEST_ASSERT_EQUAL(9, second(2));
+
+    second = &doubleValue;
+    TEST_ASSERT_EQUAL(2, state.use_count());
+  }
+  TEST_ASSERT_EQUAL(1, state.use_count());
+}
+
+void test_inplace_function_route_handler() {
+  // Existing handler forms keep converting to UnifiedRouteHandler
+  std::function<void(WebRequest &, WebResponse &)> legacy =
+      [](WebRequest &req, WebResponse &res) {};
+  WebRoute fromFunction("/legacy", WebModule::WM_GET, legacy);
+  TEST_ASSERT_TRUE(static_cast<bool>(fromFunction.unifiedHandler));
+
+  String captured = "state";
+  WebRoute fromLambda("/lambda", WebModule::WM_GET,
+                      [captured](WebRequest &req, WebResponse &res) {});
+  WebRoute copy = fromLambda;
+  TEST_ASSERT_TRUE(static_cast<bool>(copy.unifiedHandler));
+
+  static_assert(sizeof(WebModule::UnifiedRouteHandler) <=
+                    INPLACE_FUNCTION_DEFAULT_CAPACITY + 2 * sizeof(void *) +
+                        alignof(std::max_align_t),
+                "handler should stay a small fixed size");
+}
+
+// Registration function to run all inplace function tests
+void register_inplace_function_tests() {
+  RUN_TEST(test_inplace_function_lambda_captures);
+  RUN_TEST(test_inplace_function_copy_and_move);
+  RUN_TEST(test_inplace_function_context_pointer);
+  RUN_TEST(test_inplace_function_empty);
+  RUN_TEST(test_inplace_function_non_trivial_callable);
+  RUN_TEST(test_inplace_function_route_handler);
+}
@@ -0,0 +1,186 @@
+#include "../../../include/interface/utils/test_json_document_pool.h"
+#include <ArduinoFake.h>
+#include <interface/utils/json_document_pool.h>
+#include <testing/testing_platform_provider.h>
+#include <unity.h>
+
+namespace {
+
+void addItems(JsonArray &items, int count) {
+  for (int i = 0; i < count; i++) {
+    JsonObject item = items.createNestedObject();
+    item["id"] = i;
+    item["name"] = "sensor";
+  }
+}
+
+} // namespace
+
+void test_json_document_pool_reuse() {
+  JsonDocumentPool pool(2, 256, 4096);
+
+  {
+    JsonDocumentPool::Lease lease =
+        pool.build<JsonObject>("/status", [](JsonObject &root) {
+          root["uptime"] = 42;
+        });
+    TEST_ASSERT_FALSE(lease.overflowed());
+    TEST_ASSERT_EQUAL(0, pool.idleDocuments());
+  }
+  TEST_ASSERT_EQUAL(1, pool.idleDocuments());
+
+  // The returned document is cleared and handed out again
+  JsonDocumentPool::Lease again = pool.acquire(64);
+  TEST_ASSERT_EQUAL(0, again.document().memoryUsage());
+  TEST_ASSERT_EQUAL(2, pool.stats().acquisitions);
+  TEST_ASSERT_EQUAL(1, pool.stats().hits);
+  TEST_ASSERT_EQUAL(50, pool.stats().hitRatePercent());
+
+  // Nothing idle is large enough: a new document, not a hit
+  JsonDocumentPool::Lease large = pool.acquire(2048);
+  TEST_ASSERT_TRUE(large.document().capacity() >= 2048);
+  TEST_ASSERT_EQUAL(1, pool.stats().hits);
+
+  // Only maxDocuments are kept, preferring the larger ones
+  JsonDocumentPool::Lease third = pool.acquire(128);
+  again = JsonDocumentPool::Lease();
+  large = JsonDocumentPool::Lease();
+  third = JsonDocumentPool::Lease();
+  TEST_ASSERT_EQUAL(2, pool.idleDocuments());
+  TEST_ASSERT_TRUE(pool.idleBytes() >= 2048 + 256);
+}
+
+void test_json_document_pool_learns_route_capacity() {
+  JsonDocumentPool pool(2, 512, 8192);
+  TEST_ASSERT_EQUAL(512, pool.capacityFor("/api/items"));
+
+  size_t used;
+  {
+    JsonDocumentPool::Lease lease =
+        pool.build<JsonArray>("/api/items", [](JsonArray &items) {
+          addItems(items, 20);
+        });
+    used = lease.document().memoryUsage();
+  }
+  TEST_ASSERT_TRUE(used > 512);
+
+  // Sized from the high-water mark with headroom; other routes unaffected
+  size_t learned = pool.capacityFor("/api/items");
+  TEST_ASSERT_TRUE(learned >= used + used / 4);
+  TEST_ASSERT_EQUAL(512, pool.capacityFor("/api/status"));
+
+  // A smaller response does not lower the high-water mark
+  pool.learn("/api/items", 16);
+  TEST_ASSERT_EQUAL(learned, pool.capacityFor("/api/items"));
+
+  // ...and the next request fits the first document it is given
+  JsonDocumentPool::Lease next =
+      pool.build<JsonArray>("/api/items", [](JsonArray &items) {
+        addItems(items, 20);
+      });
+  TEST_ASSERT_FALSE(next.overflowed());
+  TEST_ASSERT_EQUAL(1, pool.stats().overflows);
+
+  pool.clear();
+  TEST_ASSERT_EQUAL(512, pool.capacityFor("/api/items"));
+  TEST_ASSERT_EQUAL(0, pool.idleDocuments());
+}
+
+void test_json_document_pool_overflow_retry() {
+  JsonDocumentPool pool(2, 64, 4096);
+  int calls = 0;
+
+  JsonDocumentPool::Lease lease =
+      pool.build<JsonArray>("/big", [&calls](JsonArray &items) {
+        calls++;
+        addItems(items, 30);
+      });
+  // Overflowed the initial document, rebuilt once in a larger one
+  TEST_ASSERT_EQUAL(2, calls);
+  TEST_ASSERT_FALSE(lease.overflowed());
+  TEST_ASSERT_EQUAL(30, lease.document().as<JsonArray>().size());
+  TEST_ASSERT_EQUAL(1, pool.stats().overflows);
+  TEST_ASSERT_EQUAL(0, pool.stats().retryFailures);
+
+  // Too large for maxCapacity: reported, not retried again
+  JsonDocumentPool small(2, 64, 128);
+  calls = 0;
+  JsonDocumentPool::Lease truncated =
+      small.build<JsonArray>("/big", [&calls](JsonArray &items) {
+        calls++;
+        addItems(items, 30);
+      });
+  TEST_ASSERT_EQUAL(2, calls);
+  TEST_ASSERT_TRUE(truncated.overflowed());
+  TEST_ASSERT_EQUAL(1, small.stats().retryFailures);
+}
+
+void test_json_document_pool_platform_responses() {
+  MockWebPlatform platform;
+
+  // Larger than the old fixed 512-byte document
+  WebResponse response;
+  platform.createJsonArrayResponse(
+      response, [](JsonArray &items) { addItems(items, 40); });
+  DynamicJsonDocument parsed(8192);
+  TEST_ASSERT_FALSE(deserializeJson(parsed, response.getContent().c_str()));
+  TEST_ASSERT_EQUAL(40, parsed.as<JsonArray>().size());
+  TEST_ASSERT_EQUAL(1, platform.getJsonDocumentPool().stats().overflows);
+
+  // Learned: the same response no longer overflows and reuses the document
+  WebResponse again;
+  platform.createJsonArrayResponse(
+      again, [](JsonArray &items) { addItems(items, 40); });
+  const JsonDocumentPool::Stats &stats = platform.getJsonDocumentPool().stats();
+  TEST_ASSERT_EQUAL(1, stats.overflows);
+  TEST_ASSERT_EQUAL(1, stats.hits);
+  TEST_ASSERT_EQUAL_STRING(response.getContent().c_str(),
+                           again.getContent().c_str());
+}
+
+void test_json_document_pool_response_builder() {
+  auto build = [](JsonObject &root) { root["uptime"] = 42; };
+  IWebPlatformProvider *original = IWebPlatformProvider::instance;
+
+  // Through the installed platform's pool
+  MockWebPlatformProvider provider;
+  IWebPlatformProvider::instance = &provider;
+  const JsonDocumentPool &platformPool =
+      provider.getMockPlatform().getJsonDocumentPool();
+  uint32_t fallbackBefore = JsonResponseBuilder::pool().stats().acquisitions;
+  WebResponse viaPlatform;
+  JsonResponseBuilder::createResponse<64>(viaPlatform, build);
+  TEST_ASSERT_EQUAL_STRING("{\"uptime\":42}",
+                           viaPlatform.getContent().c_str());
+  TEST_ASSERT_EQUAL(1, platformPool.stats().acquisitions);
+  TEST_ASSERT_EQUAL(fallbackBefore,
+                    JsonResponseBuilder::pool().stats().acquisitions);
+
+  // Without a provider: the builder's own, reachable pool
+  IWebPlatformProvider::instance = nullptr;
+  WebResponse standalone;
+  JsonResponseBuilder::createResponse<64>(standalone, build);
+  TEST_ASSERT_EQUAL_STRING("{\"uptime\":42}",
+                           standalone.getContent().c_str());
+  TEST_ASSERT_EQUAL(fallbackBefore + 1,
+                    JsonResponseBuilder::pool().stats().acquisitions);
+  JsonResponseBuilder::pool().clear();
+  TEST_ASSERT_EQUAL(0, JsonResponseBuilder::pool().idleDocuments());
+  IWebPlatformProvider::instance = original;
+
+  // A response that does not fit even after the retry is a 500
+  JsonDocumentPool small(2, 64, 128);
+  WebResponse truncated;
+  JsonResponseBuilder::sendPooled(
+      truncated, small.build<JsonArray>(
+                     "/big", [](JsonArray &items) { addItems(items, 30); }));
+  TEST_ASSERT_TRUE(truncated.getContent().indexOf("Response too large") >= 0);
+}
+
+void register_json_document_pool_tests() {
+  RUN_TEST(test_json_document_pool_reuse);
+  RUN_TEST(test_json_document_pool_learns_route_capacity);
+  RUN_TEST(test_json_document_pool_overflow_retry);
+  RUN_TEST(test_json_document_pool_platform_responses);
+  RUN_TEST(test_json_document_pool_response_builder);
+}
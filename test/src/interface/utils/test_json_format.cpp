@@ -0,0 +1,147 @@
+#include "../../../include/interface/utils/test_json_format.h"
+#include <ArduinoFake.h>
+#include <interface/utils/json_format.h>
+#include <interface/web_request.h>
+#include <interface/web_response.h>
+#include <string>
+#include <testing/testing_platform_provider.h>
+#include <unity.h>
+
+void test_json_format_negotiate() {
+  // No header, wildcards and ties keep JSON
+  TEST_ASSERT_TRUE(JsonFormats::negotiate("") == JsonFormat::JSON);
+  TEST_ASSERT_TRUE(JsonFormats::negotiate("*/*") == JsonFormat::JSON);
+  TEST_ASSERT_TRUE(JsonFormats::negotiate("application/*") ==
+                   JsonFormat::JSON);
+  TEST_ASSERT_TRUE(
+      JsonFormats::negotiate("application/json, application/msgpack") ==
+      JsonFormat::JSON);
+  TEST_ASSERT_TRUE(JsonFormats::negotiate("text/html,*/*;q=0.8") ==
+                   JsonFormat::JSON);
+
+  TEST_ASSERT_TRUE(JsonFormats::negotiate("application/msgpack") ==
+                   JsonFormat::MSGPACK);
+  TEST_ASSERT_TRUE(JsonFormats::negotiate("Application/X-MsgPack") ==
+                   JsonFormat::MSGPACK);
+  TEST_ASSERT_TRUE(JsonFormats::negotiate(
+                       "application/json;q=0.5, application/msgpack") ==
+                   JsonFormat::MSGPACK);
+  TEST_ASSERT_TRUE(JsonFormats::negotiate(
+                       "application/msgpack;q=0.4, application/*;q=0.9") ==
+                   JsonFormat::JSON);
+  // The exact entry wins over a wildcard, whatever their order
+  TEST_ASSERT_TRUE(JsonFormats::negotiate(
+                       "*/*;q=0.1, application/msgpack;q=0.2") ==
+                   JsonFormat::MSGPACK);
+
+  TEST_ASSERT_EQUAL(1000, JsonFormats::quality("application/*",
+                                               "application/msgpack"));
+  TEST_ASSERT_EQUAL(0, JsonFormats::quality("application/msgpack;q=0",
+                                            "application/msgpack"));
+  TEST_ASSERT_EQUAL(0, JsonFormats::quality("text/*", "application/json"));
+}
+
+void test_json_format_content_type() {
+  JsonFormat format = JsonFormat::MSGPACK;
+  TEST_ASSERT_TRUE(JsonFormats::fromContentType(
+      "application/json; charset=utf-8", format));
+  TEST_ASSERT_TRUE(format == JsonFormat::JSON);
+  TEST_ASSERT_TRUE(
+      JsonFormats::fromContentType(" application/msgpack ", format));
+  TEST_ASSERT_TRUE(format == JsonFormat::MSGPACK);
+  format = JsonFormat::JSON;
+  TEST_ASSERT_TRUE(
+      JsonFormats::fromContentType("application/x-msgpack", format));
+  TEST_ASSERT_TRUE(format == JsonFormat::MSGPACK);
+
+  TEST_ASSERT_FALSE(JsonFormats::fromContentType("text/plain", format));
+  TEST_ASSERT_FALSE(JsonFormats::fromContentType("", format));
+  TEST_ASSERT_TRUE(format == JsonFormat::MSGPACK); // Left untouched
+
+  TEST_ASSERT_EQUAL_STRING("application/msgpack",
+                           JsonFormats::mimeType(JsonFormat::MSGPACK));
+  TEST_ASSERT_EQUAL_STRING("application/json",
+                           JsonFormats::mimeType(JsonFormat::JSON));
+}
+
+void test_json_format_msgpack_response() {
+  MockWebPlatform platform;
+  auto build = [](JsonObject &obj) {
+    obj["name"] = "lamp";
+    obj["level"] = 42;
+  };
+
+  // Unbound responses skip negotiation: JSON without Vary
+  WebResponse plain;
+  platform.createJsonResponse(plain, build);
+  TEST_ASSERT_EQUAL_STRING("application/json", plain.getMimeType().c_str());
+  TEST_ASSERT_EQUAL_STRING("", plain.getHeader("Vary").c_str());
+
+  // A negotiated JSON answer still varies on Accept
+  const char browser[] = "GET /api/lamp HTTP/1.1\r\n"
+                         "Accept: application/json\r\n\r\n";
+  WebRequest browserRequest(browser, sizeof(browser) - 1);
+  WebResponse json;
+  json.bindRequest(browserRequest);
+  platform.createJsonResponse(json, build);
+  TEST_ASSERT_EQUAL_STRING("application/json", json.getMimeType().c_str());
+  TEST_ASSERT_EQUAL_STRING("Accept", json.getHeader("Vary").c_str());
+
+  const char raw[] = "GET /api/lamp HTTP/1.1\r\n"
+                     "Accept: application/msgpack, application/json;q=0.5\r\n"
+                     "\r\n";
+  WebRequest request(raw, sizeof(raw) - 1);
+  WebResponse packed;
+  packed.bindRequest(request);
+  platform.createJsonResponse(packed, build);
+  TEST_ASSERT_EQUAL_STRING("application/msgpack",
+                           packed.getMimeType().c_str());
+  TEST_ASSERT_EQUAL_STRING("Accept", packed.getHeader("Vary").c_str());
+
+  String content = packed.getContent();
+  DynamicJsonDocument decoded(256);
+  TEST_ASSERT_FALSE(
+      deserializeMsgPack(decoded, content.c_str(), content.length()));
+  TEST_ASSERT_EQUAL_STRING("lamp", decoded["name"].as<const char *>());
+  TEST_ASSERT_EQUAL(42, decoded["level"].as<int>());
+
+  WebResponse list;
+  list.bindRequest(request);
+  platform.createJsonArrayResponse(list, [](JsonArray &array) {
+    array.add(1);
+    array.add(2);
+  });
+  TEST_ASSERT_EQUAL_STRING("application/msgpack", list.getMimeType().c_str());
+}
+
+void test_json_format_msgpack_request_body() {
+  DynamicJsonDocument doc(256);
+  doc["name"] = "lamp";
+  doc["level"] = 7;
+  char body[64];
+  size_t length = serializeMsgPack(doc, body, sizeof(body));
+
+  std::string raw = "POST /api/lamp HTTP/1.1\r\n"
+                    "Content-Type: application/msgpack\r\n"
+                    "Content-Length: " +
+                    std::to_string(length) + "\r\n\r\n";
+  raw.append(body, length);
+  WebRequest request(raw.data(), raw.size());
+  TEST_ASSERT_EQUAL_STRING("lamp", request.getJsonParam("name").c_str());
+  TEST_ASSERT_EQUAL_STRING("7", request.getJsonParam("level").c_str());
+
+  // Bodies of other types are not parsed as documents
+  const char text[] = "POST /api/lamp HTTP/1.1\r\n"
+                      "Content-Type: text/plain\r\n"
+                      "Content-Length: 15\r\n\r\n"
+                      "{\"name\":\"lamp\"}";
+  WebRequest plain(text, sizeof(text) - 1);
+  TEST_ASSERT_EQUAL_STRING("", plain.getJsonParam("name").c_str());
+}
+
+void register_json_format_tests() {
+  RUN_TEST(test_json_format_negotiate);
+  RUN_TEST(test_json_format_content_type);
+  RUN_TEST(test_json_format_msgpack_response);
+  RUN_TEST(test_json_format_msgpack_request_body);
+}
@@ -0,0 +1,158 @@
+#include "../../../include/interface/utils/test_json_stream_writer.h"
+#include <ArduinoFake.h>
+#include <interface/utils/json_stream_writer.h>
+#include <string>
+#include <unity.h>
+#include <vector>
+
+namespace {
+
+// Collects the stream and the size of every chunk
+struct CapturedStream {
+  std::string text;
+  std::vector<size_t> chunks;
+
+  JsonStreamWriter::ChunkSink sink() {
+    return [this](const char *data, size_t length) {
+      text.append(data, length);
+      chunks.push_back(length);
+      return true;
+    };
+  }
+};
+
+} // namespace
+
+void test_json_stream_writer_structure() {
+  CapturedStream out;
+  JsonStreamWriter writer(out.sink());
+  writer.beginObject();
+  writer.member("name", "lamp").member("level", 80);
+  writer.key("tags").beginArray().value("a").value("b").endArray();
+  writer.key("empty").beginObject().endObject();
+  writer.key("nested").beginArray();
+  writer.beginArray().value(1).endArray().beginArray().endArray();
+  writer.endArray();
+  writer.endObject();
+  TEST_ASSERT_EQUAL(0, writer.depth());
+  TEST_ASSERT_TRUE(writer.flush());
+
+  TEST_ASSERT_EQUAL_STRING("{\"name\":\"lamp\",\"level\":80,"
+                           "\"tags\":[\"a\",\"b\"],\"empty\":{},"
+                           "\"nested\":[[1],[]]}",
+                           out.text.c_str());
+  TEST_ASSERT_EQUAL(out.text.size(), writer.bytesWritten());
+}
+
+void test_json_stream_writer_values() {
+  CapturedStream out;
+  JsonStreamWriter writer(out.sink());
+  writer.beginArray();
+  writer.value(true).value(false).nullValue();
+  writer.value(-42).value(0u).value(4294967295ul);
+  writer.value(-9223372036854775807ll - 1).value(18446744073709551615ull);
+  writer.value(1.5).value(0.0 / 0.0);
+  writer.value(String("str")).rawValue("{\"raw\":1}");
+  writer.endArray();
+  writer.flush();
+
+  TEST_ASSERT_EQUAL_STRING("[true,false,null,-42,0,4294967295,"
+                           "-9223372036854775808,18446744073709551615,"
+                           "1.5,null,\"str\",{\"raw\":1}]",
+                           out.text.c_str());
+}
+
+void test_json_stream_writer_escaping() {
+  CapturedStream out;
+  JsonStreamWriter writer(out.sink());
+  writer.beginObject();
+  writer.member("quote\"key", "line\nbreak\t\"q\" back\\slash\x01");
+  writer.member("utf8", "caf\xc3\xa9");
+  writer.endObject();
+  writer.flush();
+
+  TEST_ASSERT_EQUAL_STRING("{\"quote\\\"key\":"
+                           "\"line\\nbreak\\t\\\"q\\\" back\\\\slash\\u0001\","
+                           "\"utf8\":\"caf\xc3\xa9\"}",
+                           out.text.c_str());
+}
+
+void test_json_stream_writer_chunking() {
+  // A response far larger than the buffer leaves in buffer-sized chunks
+  CapturedStream out;
+  JsonStreamWriter writer(out.sink());
+  writer.beginArray();
+  std::string expected = "[";
+  for (int i = 0; i < 500; i++) {
+    writer.beginObject().member("id", i).member("on", i % 2 == 0).endObject();
+    if (i > 0) {
+      expected += ",";
+    }
+    expected += "{\"id\":" + std::to_string(i) +
+                ",\"on\":" + (i % 2 == 0 ? "true" : "false") + "}";
+  }
+  writer.endArray();
+  expected += "]";
+  writer.flush();
+
+  TEST_ASSERT_EQUAL(expected.size(), out.text.size());
+  TEST_ASSERT_TRUE(expected == out.text);
+  TEST_ASSERT_TRUE(out.chunks.size() > 1);
+  for (size_t i = 0; i + 1 < out.chunks.size(); i++) {
+    TEST_ASSERT_EQUAL(JSON_STREAM_BUFFER_SIZE, out.chunks[i]);
+  }
+
+  // Nothing is sent until the buffer fills or the writer is flushed
+  CapturedStream small;
+  JsonStreamWriter pending(small.sink());
+  pending.beginArray().value(1).endArray();
+  TEST_ASSERT_EQUAL(0, small.chunks.size());
+  pending.flush();
+  TEST_ASSERT_EQUAL(1, small.chunks.size());
+}
+
+void test_json_stream_writer_sink_failure() {
+  size_t calls = 0;
+  JsonStreamWriter writer([&calls](const char *, size_t) {
+    calls++;
+    return false; // Client disconnected
+  });
+  writer.beginArray();
+  for (int i = 0; i < 200; i++) {
+    writer.value("payload");
+  }
+  writer.endArray();
+  TEST_ASSERT_FALSE(writer.flush());
+  TEST_ASSERT_FALSE(writer.ok());
+  TEST_ASSERT_EQUAL(1, calls);
+  TEST_ASSERT_EQUAL(0, writer.bytesWritten());
+}
+
+void test_json_stream_writer_json_variant() {
+  DynamicJsonDocument doc(256);
+  doc["mode"] = "auto";
+  doc["level"] = 3;
+
+  CapturedStream out;
+  JsonStreamWriter writer(out.sink());
+  writer.beginObject();
+  writer.member("config", doc.as<JsonVariantConst>());
+  writer.member("ok", true);
+  writer.endObject();
+  writer.flush();
+
+  DynamicJsonDocument parsed(512);
+  TEST_ASSERT_FALSE(deserializeJson(parsed, out.text.c_str()));
+  TEST_ASSERT_EQUAL_STRING("auto", parsed["config"]["mode"].as<const char *>());
+  TEST_ASSERT_EQUAL(3, parsed["config"]["level"].as<int>());
+  TEST_ASSERT_TRUE(parsed["ok"].as<bool>());
+}
+
+void register_json_stream_writer_tests() {
+  RUN_TEST(test_json_stream_writer_structure);
+  RUN_TEST(test_json_stream_writer_values);
+  RUN_TEST(test_json_stream_writer_escaping);
+  RUN_TEST(test_json_stream_writer_chunking);
+  RUN_TEST(test_json_stream_writer_sink_failure);
+  RUN_TEST(test_json_stream_writer_json_variant);
+}
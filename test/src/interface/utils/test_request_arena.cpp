@@ -0,0 +1,78 @@
+#include "../../../include/interface/utils/test_request_arena.h"
+#include <ArduinoFake.h>
+#include <interface/utils/request_arena.h>
+#include <unity.h>
+
+void test_string_view_basics() {
+  StringView view("Content-Type: text/plain");
+  TEST_ASSERT_EQUAL(24, view.length());
+  TEST_ASSERT_EQUAL(12, view.find(':'));
+  TEST_ASSERT_EQUAL(StringView::npos, view.find('?'));
+  TEST_ASSERT_TRUE(view.startsWith("Content"));
+  TEST_ASSERT_TRUE(view.substr(0, 12) == "Content-Type");
+  TEST_ASSERT_TRUE(view.substr(0, 12).equalsIgnoreCase("content-type"));
+  TEST_ASSERT_FALSE(view.substr(0, 12).equals("content-type"));
+  TEST_ASSERT_TRUE(view.substr(100).empty());
+  TEST_ASSERT_EQUAL_STRING("text/plain", view.substr(14).toString().c_str());
+
+  StringView empty;
+  TEST_ASSERT_TRUE(empty.empty());
+  TEST_ASSERT_TRUE(empty == "");
+  TEST_ASSERT_EQUAL_STRING("", empty.toString().c_str());
+}
+
+void test_request_arena_slices() {
+  RequestArena arena;
+  RequestArena::Slice first = arena.append("GET /status", 11);
+  RequestArena::Slice second = arena.append(StringView("127.0.0.1"));
+  TEST_ASSERT_EQUAL(20, arena.bytesUsed());
+
+  // Slices survive buffer growth; views are recomputed from them
+  for (int i = 0; i < 64; i++) {
+    arena.append("padding", 7);
+  }
+  TEST_ASSERT_TRUE(arena.view(first) == "GET /status");
+  TEST_ASSERT_TRUE(arena.view(second) == "127.0.0.1");
+
+  RequestArena::Slice path = arena.sliceOf(arena.view(first).substr(4));
+  TEST_ASSERT_TRUE(arena.view(path) == "/status");
+}
+
+void test_request_arena_decode() {
+  RequestArena arena;
+  RequestArena::Slice plain = arena.append("plain", 5);
+  RequestArena::Slice plainDecoded = arena.decode(plain);
+  TEST_ASSERT_EQUAL(plain.offset, plainDecoded.offset); // No copy needed
+
+  RequestArena::Slice encoded = arena.append("a+b%2Fc%zz%4", 12);
+  TEST_ASSERT_TRUE(arena.view(arena.decode(encoded)) == "a b/c%zz%4");
+}
+
+void test_request_arena_url_encoded_fields() {
+  RequestArena arena;
+  RequestArena::Slice query = arena.append(StringView("a=1&&b=x%20y&flag&c="));
+  arena.addUrlEncodedFields(query);
+  arena.addField(RequestArena::HEADER, arena.append(StringView("Host")),
+                 arena.append(StringView("device.local")));
+
+  TEST_ASSERT_EQUAL(5, arena.getFields().size());
+  const RequestArena::Field *field = arena.findField(RequestArena::PARAM, "b");
+  TEST_ASSERT_NOT_NULL(field);
+  TEST_ASSERT_TRUE(arena.view(field->value) == "x y");
+
+  field = arena.findField(RequestArena::PARAM, "flag");
+  TEST_ASSERT_NOT_NULL(field);
+  TEST_ASSERT_TRUE(arena.view(field->value).empty());
+
+  TEST_ASSERT_NULL(arena.findField(RequestArena::PARAM, "Host"));
+  TEST_ASSERT_NULL(arena.findField(RequestArena::HEADER, "host"));
+  TEST_ASSERT_NOT_NULL(arena.findField(RequestArena::HEADER, "host", true));
+}
+
+// Registration function to run all request arena tests
+void register_request_arena_tests() {
+  RUN_TEST(test_string_view_basics);
+  RUN_TEST(test_request_arena_slices);
+  RUN_TEST(test_request_arena_decode);
+  RUN_TEST(test_request_arena_url_encoded_fields);
+}
@@ -0,0 +1,194 @@
+#include "../../../include/interface/utils/test_request_validator.h"
+#include <ArduinoFake.h>
+#include <interface/utils/request_validator.h>
+#include <testing/alloc_assertions.h>
+#include <testing/testing_platform_provider.h>
+#include <unity.h>
+
+namespace {
+
+const char DEVICE_SCHEMA[] = R"({
+    "type": "object",
+    "properties": {
+        "name": {"type": "string", "maxLength": 8},
+        "level": {"type": "integer", "minimum": 0, "maximum": 100},
+        "mode": {"type": "string", "enum": ["auto", "manual"]},
+        "ratio": {"type": "number", "nullable": true}
+    },
+    "required": ["name", "id"]
+})";
+
+// Validate `json` and return the failure as "<path> <reason>", or "ok"
+String check(const RequestValidator &validator, const char *json) {
+  DynamicJsonDocument doc(1024);
+  deserializeJson(doc, json);
+  RequestValidator::Error error;
+  if (validator.validate(doc.as<JsonVariantConst>(), error)) {
+    return "ok";
+  }
+  return String(error.path) + " " + error.reason;
+}
+
+} // namespace
+
+void test_request_validator_types_and_required() {
+  RequestValidator validator;
+  TEST_ASSERT_TRUE(validator.compile(DEVICE_SCHEMA));
+  // Root, four properties and "id", which is only listed as required
+  TEST_ASSERT_EQUAL(6, validator.ruleCount());
+
+  TEST_ASSERT_EQUAL_STRING(
+      "ok", check(validator, R"({"name": "lamp", "id": 1})").c_str());
+  TEST_ASSERT_EQUAL_STRING(
+      "id is required", check(validator, R"({"name": "lamp"})").c_str());
+  TEST_ASSERT_EQUAL_STRING(
+      "name has the wrong type",
+      check(validator, R"({"name": 5, "id": 1})").c_str());
+  TEST_ASSERT_EQUAL_STRING(" has the wrong type",
+                           check(validator, "[1, 2]").c_str());
+  // Integers are numbers; nullable admits null
+  TEST_ASSERT_EQUAL_STRING(
+      "ok", check(validator, R"({"name": "a", "id": 1, "ratio": 2})").c_str());
+  TEST_ASSERT_EQUAL_STRING(
+      "ok",
+      check(validator, R"({"name": "a", "id": 1, "ratio": null})").c_str());
+  TEST_ASSERT_EQUAL_STRING(
+      "level has the wrong type",
+      check(validator, R"({"name": "a", "id": 1, "level": 2.5})").c_str());
+}
+
+void test_request_validator_bounds_and_enum() {
+  RequestValidator validator;
+  TEST_ASSERT_TRUE(validator.compile(DEVICE_SCHEMA));
+
+  TEST_ASSERT_EQUAL_STRING(
+      "level is above the maximum",
+      check(validator, R"({"name": "a", "id": 1, "level": 101})").c_str());
+  TEST_ASSERT_EQUAL_STRING(
+      "level is below the minimum",
+      check(validator, R"({"name": "a", "id": 1, "level": -1})").c_str());
+  TEST_ASSERT_EQUAL_STRING(
+      "name is too long",
+      check(validator, R"({"name": "chandelier", "id": 1})").c_str());
+  // maxLength counts characters, not UTF-8 bytes
+  TEST_ASSERT_EQUAL_STRING(
+      "ok",
+      check(validator, "{\"name\": \"l\xC3\xA4mpch\xC3\xA9n\", \"id\": 1}")
+          .c_str());
+  TEST_ASSERT_EQUAL_STRING(
+      "mode is not an allowed value",
+      check(validator, R"({"name": "a", "id": 1, "mode": "eco"})").c_str());
+
+  // Validation walks the parsed body without allocating
+  DynamicJsonDocument doc(1024);
+  deserializeJson(doc, R"({"name": "a", "id": 1, "mode": "auto"})");
+  JsonVariantConst body = doc.as<JsonVariantConst>();
+  bool valid = false;
+  TEST_ASSERT_NO_ALLOCS(valid = validator.validate(body));
+  TEST_ASSERT_TRUE(valid);
+}
+
+void test_request_validator_nested() {
+  RequestValidator validator;
+  TEST_ASSERT_TRUE(validator.compile(R"({
+      "type": "object",
+      "properties": {
+          "schedule": {
+              "type": "object",
+              "properties": {
+                  "days": {
+                      "type": "array",
+                      "maxItems": 7,
+                      "items": {"type": "integer", "maximum": 6}
+                  }
+              },
+              "required": ["days"]
+          }
+      }
+  })"));
+
+  TEST_ASSERT_EQUAL_STRING(
+      "ok", check(validator, R"({"schedule": {"days": [0, 6]}})").c_str());
+  TEST_ASSERT_EQUAL_STRING(
+      "schedule.days is required",
+      check(validator, R"({"schedule": {}})").c_str());
+  TEST_ASSERT_EQUAL_STRING(
+      "schedule.days[] is above the maximum",
+      check(validator, R"({"schedule": {"days": [1, 9]}})").c_str());
+  TEST_ASSERT_EQUAL_STRING(
+      "schedule.days has too many items",
+      check(validator, R"({"schedule": {"days": [0,1,2,3,4,5,6,0]}})")
+          .c_str());
+
+  // A full request body object validates its application/json schema
+  TEST_ASSERT_TRUE(validator.compile(
+      R"({"content": {"application/json": {"schema": {"type": "array"}}}})"));
+  TEST_ASSERT_EQUAL_STRING("ok", check(validator, "[]").c_str());
+  TEST_ASSERT_EQUAL_STRING(" has the wrong type",
+                           check(validator, "{}").c_str());
+}
+
+void test_request_validator_rejects_bad_schemas() {
+  RequestValidator validator;
+  TEST_ASSERT_FALSE(validator.compile(""));
+  TEST_ASSERT_FALSE(validator.compiled());
+  TEST_ASSERT_FALSE(validator.compile("{\"type\": "));
+  TEST_ASSERT_FALSE(validator.compile(R"({"type": "text"})"));
+  TEST_ASSERT_FALSE(validator.compile(R"({"required": [1]})"));
+  TEST_ASSERT_FALSE(validator.compile(R"({"enum": [true]})"));
+
+  // Too deep
+  String deep = "{}";
+  for (int i = 0; i <= RequestValidator::MAX_DEPTH; i++) {
+    deep = "{\"properties\": {\"a\": " + deep + "}}";
+  }
+  TEST_ASSERT_FALSE(validator.compile(deep.c_str()));
+
+  // A validator without a compiled schema accepts nothing
+  TEST_ASSERT_FALSE(validator.validate(JsonVariantConst()));
+}
+
+void test_request_validator_route_registration() {
+  class SettingsModule : public IWebModule {
+  public:
+    std::vector<RouteVariant> getHttpRoutes() override {
+      return {ApiRoute("/settings", WebModule::WM_PUT,
+                       [](WebRequest &req, WebResponse &res) {},
+                       API_DOC("Update settings")
+                           .withRequestBody(DEVICE_SCHEMA))
+                  .validated(),
+              ApiRoute("/broken", WebModule::WM_PUT,
+                       [](WebRequest &req, WebResponse &res) {})
+                  .validated(R"({"type": "text"})")};
+    }
+    std::vector<RouteVariant> getHttpsRoutes() override { return {}; }
+    String getModuleName() const override { return "settings"; }
+  };
+
+  MockWebPlatform platform;
+  String warning;
+  platform.onWarn([&warning](const String &message) { warning = message; });
+  SettingsModule module;
+  platform.registerModule("/device", &module);
+
+  // Compiled once at registration from the documented request schema
+  RouteTrie::Match match;
+  const RouteTable::Route *route = platform.findRoute(
+      "/api/device/settings", WebModule::WM_PUT, match);
+  TEST_ASSERT_NOT_NULL(route);
+  TEST_ASSERT_NOT_NULL(route->validator.get());
+  TEST_ASSERT_TRUE(route->validator->compiled());
+
+  // A schema that does not compile fails the registration
+  TEST_ASSERT_NULL(
+      platform.findRoute("/api/device/broken", WebModule::WM_PUT, match));
+  TEST_ASSERT_TRUE(warning.indexOf("/api/device/broken") >= 0);
+}
+
+void register_request_validator_tests() {
+  RUN_TEST(test_request_validator_types_and_required);
+  RUN_TEST(test_request_validator_bounds_and_enum);
+  RUN_TEST(test_request_validator_nested);
+  RUN_TEST(test_request_validator_rejects_bad_schemas);
+  RUN_TEST(test_request_validator_route_registration);
+}
@@ -0,0 +1,128 @@
+#include "../../../include/interface/utils/test_response_cache.h"
+#include <ArduinoFake.h>
+#include <cstring>
+#include <interface/route_types.h>
+#include <interface/utils/response_cache.h>
+#include <interface/web_request.h>
+#include <unity.h>
+
+namespace {
+
+ResponseCache::Entry makeEntry(const char *body) {
+  ResponseCache::Entry entry;
+  entry.mimeType = "application/json";
+  entry.body = body;
+  return entry;
+}
+
+String keyFor(const char *raw, const char *varyParams) {
+  WebRequest request(raw, strlen(raw));
+  ResponseCachePolicy policy;
+  policy.ttlMs = 1000;
+  policy.varyParams = varyParams;
+  return ResponseCache::key(request.getMethod(), request.pathView(), request,
+                            policy);
+}
+
+} // namespace
+
+void test_response_cache_key() {
+  const char *first = "GET /api/devices?limit=10&page=2&t=1 HTTP/1.1\r\n\r\n";
+  const char *second = "GET /api/devices?t=2&page=2&limit=10 HTTP/1.1\r\n\r\n";
+  const char *other = "GET /api/devices?limit=5&page=2 HTTP/1.1\r\n\r\n";
+
+  // Only the vary params count, in the policy's order
+  TEST_ASSERT_EQUAL_STRING(keyFor(first, "limit, page").c_str(),
+                           keyFor(second, "limit, page").c_str());
+  TEST_ASSERT_FALSE(keyFor(first, "limit,page") == keyFor(other, "limit,page"));
+  TEST_ASSERT_EQUAL_STRING("/api/devices 00",
+                           keyFor(first, nullptr).c_str());
+  TEST_ASSERT_EQUAL_STRING("/api/devices 00?limit=10",
+                           keyFor(first, "limit").c_str());
+
+  // JSON and MessagePack answers of one route get separate entries
+  const char *packed = "GET /api/devices?limit=10 HTTP/1.1\r\n"
+                       "Accept: application/msgpack\r\n\r\n";
+  TEST_ASSERT_EQUAL_STRING("/api/devices 01?limit=10",
+                           keyFor(packed, "limit").c_str());
+}
+
+void test_response_cache_ttl() {
+  ResponseCache cache;
+  TEST_ASSERT_TRUE(cache.store("/status 0", makeEntry("{}"), 1000, 5000));
+
+  const ResponseCache::Entry *entry = cache.find("/status 0", 5999);
+  TEST_ASSERT_NOT_NULL(entry);
+  TEST_ASSERT_EQUAL_STRING("{}", entry->body.c_str());
+  TEST_ASSERT_NULL(cache.find("/status 0", 6000));
+  TEST_ASSERT_EQUAL(0, cache.size());
+  TEST_ASSERT_EQUAL(1, cache.stats().hits);
+  TEST_ASSERT_EQUAL(1, cache.stats().misses);
+  TEST_ASSERT_EQUAL(1, cache.stats().expirations);
+
+  // millis() wrap-around
+  cache.store("/status 0", makeEntry("{}"), 1000, 0xFFFFFF00u);
+  TEST_ASSERT_NOT_NULL(cache.find("/status 0", 0x100));
+  TEST_ASSERT_NULL(cache.find("/status 0", 0x400));
+}
+
+void test_response_cache_lru_and_bytes() {
+  ResponseCache cache(2, 64);
+  cache.store("/a 0", makeEntry("a"), 1000, 0);
+  cache.store("/b 0", makeEntry("b"), 1000, 0);
+  TEST_ASSERT_NOT_NULL(cache.find("/a 0", 1)); // /b is now least recent
+  cache.store("/c 0", makeEntry("c"), 1000, 2);
+  TEST_ASSERT_EQUAL(2, cache.size());
+  TEST_ASSERT_NOT_NULL(cache.find("/a 0", 3));
+  TEST_ASSERT_NULL(cache.find("/b 0", 3));
+  TEST_ASSERT_EQUAL(1, cache.stats().evictions);
+
+  // The byte bound evicts too, and oversized entries are refused
+  String large;
+  for (int i = 0; i < 40; i++) {
+    large += 'x';
+  }
+  TEST_ASSERT_TRUE(cache.store("/d 0", makeEntry(large.c_str()), 1000, 4));
+  TEST_ASSERT_EQUAL(1, cache.size());
+  TEST_ASSERT_TRUE(cache.bytes() <= 64);
+  large += large;
+  TEST_ASSERT_FALSE(cache.store("/e 0", makeEntry(large.c_str()), 1000, 5));
+  TEST_ASSERT_NOT_NULL(cache.find("/d 0", 6));
+}
+
+void test_response_cache_invalidate() {
+  ResponseCache cache;
+  cache.store("/api/status 0", makeEntry("1"), 1000, 0);
+  cache.store("/api/status/wifi 0", makeEntry("2"), 1000, 0);
+  cache.store("/api/statusx 0", makeEntry("3"), 1000, 0);
+  cache.store("/api/config 0?section=net", makeEntry("4"), 1000, 0);
+
+  TEST_ASSERT_EQUAL(2, cache.invalidate("/api/status"));
+  TEST_ASSERT_NULL(cache.find("/api/status 0", 1));
+  TEST_ASSERT_NOT_NULL(cache.find("/api/statusx 0", 1));
+  TEST_ASSERT_EQUAL(1, cache.invalidate("/api/config"));
+  TEST_ASSERT_EQUAL(1, cache.invalidate(""));
+  TEST_ASSERT_EQUAL(0, cache.size());
+  TEST_ASSERT_EQUAL(0, cache.bytes());
+  TEST_ASSERT_EQUAL(4, cache.stats().invalidations);
+}
+
+void test_response_cache_route_policy() {
+  WebRoute plain("/", WebModule::WM_GET, [](WebRequest &, WebResponse &) {});
+  TEST_ASSERT_FALSE(plain.cachePolicy.enabled());
+
+  ApiRoute status = ApiRoute("/status", WebModule::WM_GET,
+                             [](WebRequest &, WebResponse &) {})
+                        .cached(2000, "fields");
+  TEST_ASSERT_TRUE(status.webRoute.cachePolicy.enabled());
+  TEST_ASSERT_EQUAL(2000, status.webRoute.cachePolicy.ttlMs);
+  TEST_ASSERT_EQUAL_STRING("fields", status.webRoute.cachePolicy.varyParams);
+}
+
+void register_response_cache_tests() {
+  RUN_TEST(test_response_cache_key);
+  RUN_TEST(test_response_cache_ttl);
+  RUN_TEST(test_response_cache_lru_and_bytes);
+  RUN_TEST(test_response_cache_invalidate);
+  RUN_TEST(test_response_cache_route_policy);
+}
@@ -0,0 +1,172 @@
+#include "../../../include/interface/utils/test_route_trie.h"
+#include <ArduinoFake.h>
+#include <interface/utils/route_trie.h>
+#include <unity.h>
+
+void test_route_trie_static_routes() {
+  RouteTrie trie;
+  TEST_ASSERT_TRUE(trie.insert("/status", WebModule::WM_GET, 1));
+  TEST_ASSERT_TRUE(trie.insert("/config", WebModule::WM_GET, 2));
+  TEST_ASSERT_TRUE(trie.insert("/", WebModule::WM_GET, 3));
+  TEST_ASSERT_EQUAL(3, trie.size());
+
+  RouteTrie::Match match;
+  TEST_ASSERT_TRUE(trie.match("/status", WebModule::WM_GET, match));
+  TEST_ASSERT_EQUAL(1, match.routeId);
+  TEST_ASSERT_EQUAL_STRING("/status", match.pattern);
+  TEST_ASSERT_EQUAL(0, match.paramCount);
+
+  TEST_ASSERT_TRUE(trie.match("/", WebModule::WM_GET, match));
+  TEST_ASSERT_EQUAL(3, match.routeId);
+
+  // Prefixes and extensions of a static route must not match
+  TEST_ASSERT_FALSE(trie.match("/stat", WebModule::WM_GET, match));
+  TEST_ASSERT_FALSE(trie.match("/status/extra", WebModule::WM_GET, match));
+  TEST_ASSERT_FALSE(match.found());
+}
+
+void test_route_trie_param_capture() {
+  RouteTrie trie;
+  trie.insert("/items/{id}", WebModule::WM_GET, 1);
+  trie.insert("/items/{id}/fields/{field}", WebModule::WM_GET, 2);
+
+  RouteTrie::Match match;
+  TEST_ASSERT_TRUE(trie.match("/items/42", WebModule::WM_GET, match));
+  TEST_ASSERT_EQUAL(1, match.routeId);
+  TEST_ASSERT_EQUAL(1, match.paramCount);
+  TEST_ASSERT_EQUAL_STRING("id", match.params[0].name);
+  TEST_ASSERT_EQUAL(2, match.params[0].length);
+  TEST_ASSERT_EQUAL_STRING("42", match.getParam("id").c_str());
+
+  TEST_ASSERT_TRUE(
+      trie.match("/items/abc/fields/name", WebModule::WM_GET, match));
+  TEST_ASSERT_EQUAL(2, match.routeId);
+  TEST_ASSERT_EQUAL(2, match.paramCount);
+  TEST_ASSERT_EQUAL_STRING("abc", match.getParam("id").c_str());
+  TEST_ASSERT_EQUAL_STRING("name", match.getParam("field").c_str());
+  TEST_ASSERT_EQUAL_STRING("", match.getParam("missing").c_str());
+
+  // A parameter never captures an empty segment
+  TEST_ASSERT_FALSE(trie.match("/items/", WebModule::WM_GET, match));
+}
+
+void test_route_trie_wildcard() {
+  RouteTrie trie;
+  trie.insert("/assets/*", WebModule::WM_GET, 1);
+
+  RouteTrie::Match match;
+  TEST_ASSERT_TRUE(trie.match("/assets/js/app.js", WebModule::WM_GET, match));
+  TEST_ASSERT_EQUAL(1, match.routeId);
+  TEST_ASSERT_EQUAL_STRING("js/app.js", match.getParam("*").c_str());
+
+  TEST_ASSERT_TRUE(trie.match("/assets/", WebModule::WM_GET, match));
+  TEST_ASSERT_EQUAL_STRING("", match.getParam("*").c_str());
+
+  TEST_ASSERT_FALSE(trie.match("/assets", WebModule::WM_GET, match));
+}
+
+void test_route_trie_precedence() {
+  RouteTrie trie;
+  trie.insert("/users/*", WebModule::WM_GET, 1);
+  trie.insert("/users/{id}", WebModule::WM_GET, 2);
+  trie.insert("/users/me", WebModule::WM_GET, 3);
+  trie.insert("/users/{id}/profile", WebModule::WM_GET, 4);
+
+  RouteTrie::Match match;
+  TEST_ASSERT_TRUE(trie.match("/users/me", WebModule::WM_GET, match));
+  TEST_ASSERT_EQUAL(3, match.routeId);
+
+  TEST_ASSERT_TRUE(trie.match("/users/7", WebModule::WM_GET, match));
+  TEST_ASSERT_EQUAL(2, match.routeId);
+
+  // Static "me" branch fails deeper, so the param branch must be retried
+  TEST_ASSERT_TRUE(trie.match("/users/me/profile", WebModule::WM_GET, match));
+  TEST_ASSERT_EQUAL(4, match.routeId);
+  TEST_ASSERT_EQUAL_STRING("me", match.getParam("id").c_str());
+
+  TEST_ASSERT_TRUE(trie.match("/users/7/settings", WebModule::WM_GET, match));
+  TEST_ASSERT_EQUAL(1, match.routeId);
+  TEST_ASSERT_EQUAL(1, match.paramCount);
+  TEST_ASSERT_EQUAL_STRING("7/settings", match.getParam("*").c_str());
+}
+
+void test_route_trie_methods() {
+  RouteTrie trie;
+  trie.insert("/items/{id}", WebModule::WM_GET, 1);
+  trie.insert("/items/{itemId}", WebModule::WM_DELETE, 2);
+
+  RouteTrie::Match match;
+  TEST_ASSERT_TRUE(trie.match("/items/5", WebModule::WM_DELETE, match));
+  TEST_ASSERT_EQUAL(2, match.routeId);
+  // Parameter names come from the pattern of the route that matched
+  TEST_ASSERT_EQUAL_STRING("5", match.getParam("itemId").c_str());
+
+  TEST_ASSERT_FALSE(trie.match("/items/5", WebModule::WM_POST, match));
+}
+
+void test_route_trie_edge_split() {
+  RouteTrie trie;
+  trie.insert("/settings/network", WebModule::WM_GET, 1);
+  trie.insert("/settings/nightmode", WebModule::WM_GET, 2);
+  trie.insert("/settings", WebModule::WM_GET, 3);
+  trie.insert("/set", WebModule::WM_GET, 4);
+
+  RouteTrie::Match match;
+  TEST_ASSERT_TRUE(trie.match("/settings/network", WebModule::WM_GET, match));
+  TEST_ASSERT_EQUAL(1, match.routeId);
+  TEST_ASSERT_TRUE(
+      trie.match("/settings/nightmode", WebModule::WM_GET, match));
+  TEST_ASSERT_EQUAL(2, match.routeId);
+  TEST_ASSERT_TRUE(trie.match("/settings", WebModule::WM_GET, match));
+  TEST_ASSERT_EQUAL(3, match.routeId);
+  TEST_ASSERT_TRUE(trie.match("/set", WebModule::WM_GET, match));
+  TEST_ASSERT_EQUAL(4, match.routeId);
+  TEST_ASSERT_FALSE(trie.match("/settings/n", WebModule::WM_GET, match));
+}
+
+void test_route_trie_replace_and_remove() {
+  RouteTrie trie;
+  trie.insert("/items/{id}", WebModule::WM_GET, 1);
+  trie.insert("/items/{id}", WebModule::WM_GET, 9);
+  TEST_ASSERT_EQUAL(1, trie.size());
+
+  RouteTrie::Match match;
+  TEST_ASSERT_TRUE(trie.match("/items/1", WebModule::WM_GET, match));
+  TEST_ASSERT_EQUAL(9, match.routeId);
+
+  TEST_ASSERT_TRUE(trie.remove("/items/{id}", WebModule::WM_GET));
+  TEST_ASSERT_EQUAL(0, trie.size());
+  TEST_ASSERT_FALSE(trie.match("/items/1", WebModule::WM_GET, match));
+  TEST_ASSERT_FALSE(trie.remove("/items/{id}", WebModule::WM_GET));
+  TEST_ASSERT_FALSE(trie.remove("/unknown", WebModule::WM_GET));
+
+  trie.insert("/a", WebModule::WM_GET, 1);
+  trie.clear();
+  TEST_ASSERT_EQUAL(0, trie.size());
+  TEST_ASSERT_FALSE(trie.match("/a", WebModule::WM_GET, match));
+}
+
+void test_route_trie_malformed_patterns() {
+  RouteTrie trie;
+  TEST_ASSERT_FALSE(trie.insert("", WebModule::WM_GET, 1));
+  TEST_ASSERT_FALSE(trie.insert("/items/{id", WebModule::WM_GET, 1));
+  TEST_ASSERT_FALSE(trie.insert("/items/{}", WebModule::WM_GET, 1));
+  TEST_ASSERT_FALSE(trie.insert("/items/x{id}", WebModule::WM_GET, 1));
+  TEST_ASSERT_FALSE(trie.insert("/items/{id}x", WebModule::WM_GET, 1));
+  TEST_ASSERT_FALSE(trie.insert("/files/*/meta", WebModule::WM_GET, 1));
+  TEST_ASSERT_FALSE(trie.insert("/items}", WebModule::WM_GET, 1));
+  TEST_ASSERT_FALSE(trie.insert("/ok", WebModule::WM_GET, -1));
+  TEST_ASSERT_EQUAL(0, trie.size());
+}
+
+// Registration function to run all route trie tests
+void register_route_trie_tests() {
+  RUN_TEST(test_route_trie_static_routes);
+  RUN_TEST(test_route_trie_param_capture);
+  RUN_TEST(test_route_trie_wildcard);
+  RUN_TEST(test_route_trie_precedence);
+  RUN_TEST(test_route_trie_methods);
+  RUN_TEST(test_route_trie_edge_split);
+  RUN_TEST(test_route_trie_replace_and_remove);
+  RUN_TEST(test_route_trie_malformed_patterns);
+}
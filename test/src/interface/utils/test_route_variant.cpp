@@ -2,7 +2,9 @@
 #include <ArduinoFake.h>
 #include <interface/utils/route_variant.h>
 #include <interface/web_module_interface.h>
+#include <type_traits>
 #include <unity.h>
+#include <vector>
 
 using namespace fakeit;
 
@@ -90,6 +92,47 @@ void test_route_variant_self_assignment() {
   TEST_ASSERT_TRUE(variant.isWebRoute());
 }
 
+void test_route_variant_move_semantics() {
+  static_assert(std::is_nothrow_move_constructible<RouteVariant>::value,
+                "RouteVariant must relocate without copying");
+  static_assert(std::is_nothrow_move_assignable<RouteVariant>::value,
+                "RouteVariant move assignment must be noexcept");
+
+  // Move construction keeps the route data
+  RouteVariant source(WebRoute("/moved", WebModule::WM_GET, testWebHandler,
+                               AuthRequirements{}));
+  RouteVariant moved(std::move(source));
+  TEST_ASSERT_TRUE(moved.isWebRoute());
+  TEST_ASSERT_EQUAL_STRING("/moved", moved.getWebRoute().path.c_str());
+
+  // Move assignment across alternatives
+  OpenAPIDocumentation docs("Moved API");
+  RouteVariant api(ApiRoute("/api/moved", WebModule::WM_POST, testApiHandler,
+                            AuthRequirements{}, docs));
+  moved = std::move(api);
+  TEST_ASSERT_TRUE(moved.isApiRoute());
+  TEST_ASSERT_EQUAL_STRING("/moved",
+                           moved.getApiRoute().webRoute.path.c_str());
+  TEST_ASSERT_EQUAL_STRING("Moved API",
+                           moved.getApiRoute().docs.getSummary().c_str());
+
+  // Move assignment within the same alternative
+  RouteVariant other(ApiRoute("/api/other", WebModule::WM_GET, testApiHandler,
+                              AuthRequirements{}, docs));
+  moved = std::move(other);
+  TEST_ASSERT_EQUAL_STRING("/other",
+                           moved.getApiRoute().webRoute.path.c_str());
+
+  // Vector growth relocates routes without losing them
+  std::vector<RouteVariant> routes;
+  for (int i = 0; i < 20; i++) {
+    routes.push_back(WebRoute("/r" + String(i), WebModule::WM_GET,
+                              testWebHandler, AuthRequirements{}));
+  }
+  TEST_ASSERT_EQUAL_STRING("/r0", routes[0].getWebRoute().path.c_str());
+  TEST_ASSERT_EQUAL_STRING("/r19", routes[19].getWebRoute().path.c_str());
+}
+
 void test_route_variant_getters() {
   // Test getWebRoute
   WebRoute webRoute("/test", WebModule::WM_GET, testWebHandler,
@@ -276,5 +319,6 @@ void register_route_variant_tests() {
   // Re-enable one test at a time to isolate the crash
   RUN_TEST(test_route_variant_assignment_operator);
   RUN_TEST(test_route_variant_self_assignment);
+  RUN_TEST(test_route_variant_move_semantics);
   RUN_TEST(test_route_variant_wrong_type_getters);
 }
\ No newline at end of file
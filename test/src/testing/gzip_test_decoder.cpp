@@ -0,0 +1,151 @@
+#include "../../include/testing/gzip_test_decoder.h"
+
+namespace {
+
+const uint16_t LENGTH_BASE[29] = {3,  4,  5,  6,   7,   8,   9,   10,  11, 13,
+                                  15, 17, 19, 23,  27,  31,  35,  43,  51, 59,
+                                  67, 83, 99, 115, 131, 163, 195, 227, 258};
+const uint16_t DISTANCE_BASE[30] = {
+    1,    2,    3,    4,    5,    7,     9,     13,    17,    25,
+    33,   49,   65,   97,   129,  193,   257,   385,   513,   769,
+    1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+
+uint8_t lengthExtra(int code) {
+  return (code < 8 || code == 28) ? 0 : static_cast<uint8_t>((code - 4) / 4);
+}
+
+uint8_t distanceExtra(int code) {
+  return code < 4 ? 0 : static_cast<uint8_t>((code - 2) / 2);
+}
+
+class BitReader {
+public:
+  BitReader(const std::string &data, size_t start)
+      : data(data), byte(start), bit(0) {}
+
+  bool exhausted() const { return byte >= data.size(); }
+
+  // LSB-first value of `count` bits
+  uint32_t bits(uint8_t count) {
+    uint32_t value = 0;
+    for (uint8_t i = 0; i < count; i++) {
+      value |= static_cast<uint32_t>(next()) << i;
+    }
+    return value;
+  }
+
+  // Huffman code bit: codes are packed most significant bit first
+  uint32_t next() {
+    if (exhausted()) {
+      return 0;
+    }
+    uint32_t value = (static_cast<uint8_t>(data[byte]) >> bit) & 1;
+    if (++bit == 8) {
+      bit = 0;
+      byte++;
+    }
+    return value;
+  }
+
+  size_t alignedByte() const { return bit ? byte + 1 : byte; }
+
+private:
+  const std::string &data;
+  size_t byte;
+  uint8_t bit;
+};
+
+int fixedSymbol(BitReader &reader) {
+  uint32_t code = 0;
+  for (int i = 0; i < 7; i++) {
+    code = (code << 1) | reader.next();
+  }
+  if (code <= 0x17) {
+    return 256 + static_cast<int>(code);
+  }
+  code = (code << 1) | reader.next();
+  if (code >= 0x30 && code <= 0xBF) {
+    return static_cast<int>(code - 0x30);
+  }
+  if (code >= 0xC0 && code <= 0xC7) {
+    return 280 + static_cast<int>(code - 0xC0);
+  }
+  code = (code << 1) | reader.next();
+  return 144 + static_cast<int>(code - 0x190);
+}
+
+uint32_t crc32(const std::string &data) {
+  uint32_t crc = 0xFFFFFFFFu;
+  for (unsigned char c : data) {
+    crc ^= c;
+    for (int bit = 0; bit < 8; bit++) {
+      crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320u : crc >> 1;
+    }
+  }
+  return crc ^ 0xFFFFFFFFu;
+}
+
+uint32_t readLittleEndian(const std::string &data, size_t offset) {
+  uint32_t value = 0;
+  for (int i = 3; i >= 0; i--) {
+    value = (value << 8) | static_cast<uint8_t>(data[offset + i]);
+  }
+  return value;
+}
+
+} // namespace
+
+bool gzipTestDecode(const std::string &gzip, std::string &out) {
+  out.clear();
+  if (gzip.size() < 18 || static_cast<uint8_t>(gzip[0]) != 0x1f ||
+      static_cast<uint8_t>(gzip[1]) != 0x8b || gzip[2] != 8 || gzip[3] != 0) {
+    return false;
+  }
+  BitReader reader(gzip, 10);
+  bool last = false;
+  while (!last) {
+    last = reader.bits(1) == 1;
+    if (reader.bits(2) != 1) {
+      return false; // Only fixed Huffman blocks
+    }
+    while (true) {
+      if (reader.exhausted()) {
+        return false;
+      }
+      int symbol = fixedSymbol(reader);
+      if (symbol < 256) {
+        out += static_cast<char>(symbol);
+        continue;
+      }
+      if (symbol == 256) {
+        break;
+      }
+      int code = symbol - 257;
+      if (code > 28) {
+        return false;
+      }
+      size_t length = LENGTH_BASE[code] + reader.bits(lengthExtra(code));
+      uint32_t distanceCode = 0;
+      for (int i = 0; i < 5; i++) {
+        distanceCode = (distanceCode << 1) | reader.next();
+      }
+      if (distanceCode > 29) {
+        return false;
+      }
+      size_t distance = DISTANCE_BASE[distanceCode] +
+                        reader.bits(distanceExtra(distanceCode));
+      if (distance > out.size()) {
+        return false;
+      }
+      for (size_t i = 0; i < length; i++) {
+        out += out[out.size() - distance];
+      }
+    }
+  }
+
+  size_t trailer = reader.alignedByte();
+  return trailer + 8 == gzip.size() &&
+         readLittleEndian(gzip, trailer) == crc32(out) &&
+         readLittleEndian(gzip, trailer + 4) ==
+             static_cast<uint32_t>(out.size());
+}
@@ -0,0 +1,130 @@
+#include "../../include/testing/test_alloc_scope.h"
+#include <ArduinoFake.h>
+#include <cstdlib>
+#include <interface/web_module_interface.h>
+#include <interface/web_response.h>
+#include <testing/alloc_assertions.h>
+#include <testing/testing_platform_provider.h>
+#include <unity.h>
+
+namespace {
+
+void requireTracking() {
+  if (!allocTrackingAvailable()) {
+    TEST_IGNORE_MESSAGE("built without WEB_PLATFORM_ALLOC_TRACKING");
+  }
+}
+
+// Opaque to the optimizer so new/malloc pairs are not elided
+void *volatile sink;
+
+class StatusModule : public IWebModule {
+public:
+  std::vector<RouteVariant> getHttpRoutes() override {
+    return {WebRoute("/", WebModule::WM_GET, statusHandler),
+            ApiRoute("/status", WebModule::WM_GET, statusHandler,
+                     {AuthType::TOKEN})};
+  }
+  std::vector<RouteVariant> getHttpsRoutes() override {
+    return getHttpRoutes();
+  }
+  String getModuleName() const override { return "StatusModule"; }
+
+  static void statusHandler(WebRequest &req, WebResponse &res) {
+    res.setContent("{\"ok\":true}", "application/json");
+  }
+};
+
+} // namespace
+
+void test_alloc_scope_counts_new_and_malloc() {
+  requireTracking();
+  AllocScope scope;
+  int *numbers = new int[8];
+  sink = numbers;
+  delete[] numbers;
+  void *block = malloc(100);
+  sink = block;
+  free(block);
+  scope.stop();
+
+  AllocStats stats = scope.stats();
+  TEST_ASSERT_EQUAL_UINT64(2, stats.count);
+  TEST_ASSERT_EQUAL_UINT64(8 * sizeof(int) + 100, stats.bytes);
+}
+
+void test_alloc_scope_peak_live_bytes() {
+  requireTracking();
+  uint64_t liveBefore = allocLiveBytes();
+  AllocScope scope;
+  void *large = malloc(1000);
+  sink = large;
+  free(large);
+  void *small = malloc(100);
+  sink = small;
+  free(small);
+  scope.stop();
+
+  // Usable sizes round up a little, never down
+  AllocStats stats = scope.stats();
+  TEST_ASSERT_GREATER_OR_EQUAL_UINT64(1000, stats.peakLiveBytes);
+  TEST_ASSERT_LESS_THAN_UINT64(1100, stats.peakLiveBytes);
+  TEST_ASSERT_EQUAL_UINT64(liveBefore, allocLiveBytes());
+}
+
+void test_alloc_scope_nested_and_stopped() {
+  requireTracking();
+  AllocScope outer;
+  void *first = malloc(2000);
+  sink = first;
+  free(first);
+  {
+    AllocScope inner;
+    void *second = malloc(50);
+    sink = second;
+    free(second);
+    TEST_ASSERT_EQUAL_UINT64(1, inner.stats().count);
+    TEST_ASSERT_LESS_THAN_UINT64(2000, inner.stats().peakLiveBytes);
+  }
+  outer.stop();
+  void *after = malloc(10);
+  sink = after;
+  free(after);
+
+  // The inner scope does not hide the outer peak; stop() freezes counts
+  TEST_ASSERT_EQUAL_UINT64(2, outer.stats().count);
+  TEST_ASSERT_GREATER_OR_EQUAL_UINT64(2000, outer.stats().peakLiveBytes);
+}
+
+void test_alloc_assertions_handler_budget() {
+  requireTracking();
+  const char raw[] = "GET /status HTTP/1.1\r\nHost: device.local\r\n\r\n";
+  WebRequest request(raw, sizeof(raw) - 1);
+  WebResponse response;
+  // Body and MIME type Strings: one allocation each, plus a temporary each
+  // where String assignment copies
+  TEST_ASSERT_MAX_ALLOCS(4, StatusModule::statusHandler(request, response));
+  TEST_ASSERT_MAX_PEAK_BYTES(256,
+                             StatusModule::statusHandler(request, response));
+
+  AuthRequirements auth = {AuthType::SESSION, AuthType::TOKEN};
+  TEST_ASSERT_NO_ALLOCS(sink = auth.has(AuthType::TOKEN) ? &auth : nullptr);
+}
+
+void test_alloc_assertions_register_module_budget() {
+  requireTracking();
+  MockWebPlatform platform;
+  StatusModule module;
+  // Two routes (registered for HTTP and HTTPS): route table entries, path
+  // Strings and trie nodes
+  TEST_ASSERT_MAX_ALLOCS(48, platform.registerModule("/status", &module));
+  TEST_ASSERT_GREATER_THAN(0, platform.getRouteCount());
+}
+
+void register_alloc_scope_tests() {
+  RUN_TEST(test_alloc_scope_counts_new_and_malloc);
+  RUN_TEST(test_alloc_scope_peak_live_bytes);
+  RUN_TEST(test_alloc_scope_nested_and_stopped);
+  RUN_TEST(test_alloc_assertions_handler_budget);
+  RUN_TEST(test_alloc_assertions_register_module_budget);
+}
@@ -496,7 +496,194 @@ void test_mock_web_request_auth() {
   TEST_ASSERT_EQUAL_STRING("123", req4.getRouteParameter("id").c_str());
 }
 
+// Test route resolution through the mock router
+void test_mock_web_platform_route_matching() {
+  MockWebPlatform platform;
+
+  class RoutedModule : public IWebModule {
+  public:
+    std::vector<RouteVariant> getHttpRoutes() override {
+      return {WebRoute("/", WebModule::WM_GET,
+                       [](WebRequest &req, WebResponse &res) {}),
+              WebRoute("/devices/{id}", WebModule::WM_GET,
+                       [](WebRequest &req, WebResponse &res) {},
+                       {AuthType::SESSION}),
+              ApiRoute("/devices/{id}", WebModule::WM_PUT,
+                       [](WebRequest &req, WebResponse &res) {},
+                       {AuthType::TOKEN})};
+    }
+    std::vector<RouteVariant> getHttpsRoutes() override {
+      return getHttpRoutes();
+    }
+    String getModuleName() const override { return "RoutedModule"; }
+  };
+
+  RoutedModule module;
+  platform.registerModule("/home/", &module);
+  platform.registerWebRoute(
+      "/static/*", [](WebRequest &req, WebResponse &res) {}, {AuthType::NONE},
+      WebModule::WM_GET);
+  platform.registerApiRoute(
+      "/status", [](WebRequest &req, WebResponse &res) {}, {AuthType::NONE},
+      WebModule::WM_GET, OpenAPIDocumentation());
+
+  RouteTrie::Match match;
+  const MockWebPlatform::RegisteredRoute *route =
+      platform.findRoute("/home", WebModule::WM_GET, match);
+  TEST_ASSERT_NOT_NULL(route);
+  TEST_ASSERT_FALSE(route->isApiRoute);
+
+  route = platform.findRoute("/home/devices/7", WebModule::WM_GET, match);
+  TEST_ASSERT_NOT_NULL(route);
+  TEST_ASSERT_EQUAL_STRING("/home/devices/{id}", route->path.c_str());
+  TEST_ASSERT_EQUAL_STRING("7", match.getParam("id").c_str());
+
+  // ApiRoute paths are mounted under /api
+  route = platform.findRoute("/api/home/devices/7", WebModule::WM_PUT, match);
+  TEST_ASSERT_NOT_NULL(route);
+  TEST_ASSERT_TRUE(route->isApiRoute);
+  TEST_ASSERT_NULL(
+      platform.findRoute("/home/devices/7", WebModule::WM_PUT, match));
+
+  TEST_ASSERT_NOT_NULL(
+      platform.findRoute("/static/css/site.css", WebModule::WM_GET, match));
+  TEST_ASSERT_NOT_NULL(
+      platform.findRoute("/api/status", WebModule::WM_GET, match));
+
+  platform.disableRoute("/status", WebModule::WM_GET);
+  TEST_ASSERT_NULL(platform.findRoute("/api/status", WebModule::WM_GET, match));
+}
+
+// Modules that only stream routes through forEachRoute() are registered
+void test_mock_web_platform_streamed_module() {
+  MockWebPlatform platform;
+
+  class StreamingModule : public IWebModule {
+  public:
+    std::vector<RouteVariant> getHttpRoutes() override { return {}; }
+    std::vector<RouteVariant> getHttpsRoutes() override { return {}; }
+    String getModuleName() const override { return "StreamingModule"; }
+
+    void forEachRoute(const RouteVisitor &visitor,
+                      WebModule::Transport transport) override {
+      visitor(WebRoute("/page", WebModule::WM_GET,
+                       [](WebRequest &req, WebResponse &res) {}));
+      if (transport == WebModule::TRANSPORT_HTTPS) {
+        visitor(ApiRoute("/secure", WebModule::WM_POST,
+                         [](WebRequest &req, WebResponse &res) {},
+                         {AuthType::TOKEN}));
+      }
+    }
+  };
+
+  StreamingModule module;
+  platform.registerModule("/stream", &module);
+  TEST_ASSERT_EQUAL(3, platform.getRouteCount());
+
+  RouteTrie::Match match;
+  TEST_ASSERT_NOT_NULL(
+      platform.findRoute("/stream/page", WebModule::WM_GET, match));
+  const MockWebPlatform::RegisteredRoute *route =
+      platform.findRoute("/api/stream/secure", WebModule::WM_POST, match);
+  TEST_ASSERT_NOT_NULL(route);
+  TEST_ASSERT_TRUE(route->isApiRoute);
+}
+
 // Register all mock platform tests
+// Modules can assert that they invalidate cached responses on change
+void test_mock_web_platform_cache_invalidation() {
+  MockWebPlatform platform;
+  IWebPlatform &base = platform;
+  base.invalidateResponseCache("/api/status");
+  base.invalidateResponseCache();
+
+  const std::vector<String> &prefixes = platform.getCacheInvalidations();
+  TEST_ASSERT_EQUAL(2, prefixes.size());
+  TEST_ASSERT_EQUAL_STRING("/api/status", prefixes[0].c_str());
+  TEST_ASSERT_EQUAL_STRING("", prefixes[1].c_str());
+}
+
+// Cache keys hold mounted paths; module-relative prefixes are reported
+void test_mock_web_platform_cache_invalidation_paths() {
+  class ItemsModule : public IWebModule {
+  public:
+    std::vector<RouteVariant> getHttpRoutes() override {
+      return {ApiRoute("/items/{id}", WebModule::WM_GET,
+                       [](WebRequest &req, WebResponse &res) {})
+                  .cached(1000)};
+    }
+    std::vector<RouteVariant> getHttpsRoutes() override {
+      return getHttpRoutes();
+    }
+    String getModuleName() const override { return "store"; }
+  };
+
+  MockWebPlatform platform;
+  ItemsModule module;
+  platform.registerModule("/store", &module);
+  int warnings = 0;
+  platform.onWarn([&warnings](const String &) { warnings++; });
+
+  platform.invalidateResponseCache("/api/store/items");
+  platform.invalidateResponseCache("/api/store/items/42");
+  platform.invalidateResponseCache("/api/store/");
+  platform.invalidateResponseCache("");
+  TEST_ASSERT_EQUAL(0, warnings);
+
+  platform.invalidateResponseCache("/items");
+  platform.invalidateResponseCache("/api/store/item");
+  TEST_ASSERT_EQUAL(2, warnings);
+  TEST_ASSERT_EQUAL(6, platform.getCacheInvalidations().size());
+}
+
+// Modules invalidate by their own route paths, whatever they are mounted at
+void test_mock_web_platform_cache_invalidation_module() {
+  class StoreModule : public IWebModule {
+  public:
+    explicit StoreModule(IWebPlatform &platform) : platform(platform) {}
+    std::vector<RouteVariant> getHttpRoutes() override {
+      return {ApiRoute("/items/{id}", WebModule::WM_GET,
+                       [](WebRequest &req, WebResponse &res) {})
+                  .cached(1000),
+              WebRoute("/items", WebModule::WM_GET,
+                       [](WebRequest &req, WebResponse &res) {})
+                  .cached(1000)};
+    }
+    std::vector<RouteVariant> getHttpsRoutes() override {
+      return getHttpRoutes();
+    }
+    String getModuleName() const override { return "store"; }
+    void itemChanged(const String &id) {
+      platform.invalidateResponseCache(this, "/items/" + id);
+    }
+    void stockReloaded() { platform.invalidateResponseCache(this); }
+
+  private:
+    IWebPlatform &platform;
+  };
+
+  MockWebPlatform platform;
+  StoreModule module(platform);
+  platform.registerModule("/store/", &module);
+  int warnings = 0;
+  platform.onWarn([&warnings](const String &) { warnings++; });
+
+  module.itemChanged("42");
+  module.stockReloaded();
+  TEST_ASSERT_EQUAL(0, warnings);
+  const std::vector<String> &prefixes = platform.getCacheInvalidations();
+  TEST_ASSERT_EQUAL(3, prefixes.size());
+  TEST_ASSERT_EQUAL_STRING("/api/store/items/42", prefixes[0].c_str());
+  TEST_ASSERT_EQUAL_STRING("/store", prefixes[1].c_str());
+  TEST_ASSERT_EQUAL_STRING("/api/store", prefixes[2].c_str());
+
+  // Unregistered modules have nothing cached
+  StoreModule stray(platform);
+  stray.stockReloaded();
+  TEST_ASSERT_EQUAL(1, warnings);
+  TEST_ASSERT_EQUAL(3, prefixes.size());
+}
+
 void register_mock_web_platform_tests() {
   RUN_TEST(test_mock_web_platform_basics);
   RUN_TEST(test_mock_web_platform_routes);
@@ -509,4 +696,9 @@ void register_mock_web_platform_tests() {
   RUN_TEST(test_mock_web_response);
   RUN_TEST(test_mock_web_request_auth);
   RUN_TEST(test_mock_web_platform_params);
+  RUN_TEST(test_mock_web_platform_route_matching);
+  RUN_TEST(test_mock_web_platform_streamed_module);
+  RUN_TEST(test_mock_web_platform_cache_invalidation);
+  RUN_TEST(test_mock_web_platform_cache_invalidation_paths);
+  RUN_TEST(test_mock_web_platform_cache_invalidation_module);
 }
\ No newline at end of file
@@ -0,0 +1,300 @@
+#include "../../include/testing/test_native_storage_driver.h"
+#include <ArduinoFake.h>
+#include <unity.h>
+
+#if defined(NATIVE_PLATFORM) && defined(__linux__)
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <stdlib.h>
+#include <string>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <testing/native_storage_driver.h>
+#include <testing/native_web_platform.h>
+#include <unistd.h>
+
+namespace {
+
+// Temporary <root>/logs/<name> files, removed with the directory
+class StorageDir {
+public:
+  StorageDir() {
+    char pattern[] = "/tmp/web_platform_storage_XXXXXX";
+    root = mkdtemp(pattern);
+    mkdir((root + "/logs").c_str(), 0700);
+  }
+  ~StorageDir() {
+    for (const std::string &file : files) {
+      unlink(file.c_str());
+    }
+    rmdir((root + "/logs").c_str());
+    rmdir(root.c_str());
+  }
+  void write(const char *name, const std::string &content) {
+    std::string path = root + "/logs/" + name;
+    FILE *file = fopen(path.c_str(), "wb");
+    fwrite(content.data(), 1, content.size(), file);
+    fclose(file);
+    files.push_back(path);
+  }
+
+  std::string root;
+
+private:
+  std::vector<std::string> files;
+};
+
+std::string digits(size_t length) {
+  std::string text;
+  for (size_t i = 0; i < length; i++) {
+    text += static_cast<char>('0' + i % 10);
+  }
+  return text;
+}
+
+std::string serve(NativeWebPlatform &platform, const char *raw) {
+  bool keepAlive = false;
+  return platform.handleRawRequest(raw, strlen(raw), keepAlive);
+}
+
+bool contains(const std::string &text, const char *part) {
+  return text.find(part) != std::string::npos;
+}
+
+// With handlerETag false the driver's tag is used
+void registerLogRoute(NativeWebPlatform &platform, bool handlerETag = true) {
+  platform.registerWebRoute(
+      "/logs/{name}",
+      [handlerETag](WebRequest &req, WebResponse &res) {
+        if (handlerETag) {
+          res.setHeader("ETag", "\"v1\"");
+        }
+        res.setStorageStreamContent("logs", req.getRouteParameter("name"),
+                                    "text/plain", "native-test");
+      },
+      {AuthType::NONE}, WebModule::WM_GET);
+}
+
+// Promises `promised` bytes but delivers only `available` of them, like a
+// file truncated after open
+class ShortReadDriver : public IStorageDriver {
+public:
+  ShortReadDriver(size_t promised, size_t available)
+      : promised(promised), available(available), position(0) {}
+  Handle open(const String &, const String &) override { return 1; }
+  size_t size(Handle) const override { return promised; }
+  bool seek(Handle, size_t offset) override {
+    position = offset;
+    return offset <= promised;
+  }
+  size_t read(Handle, uint8_t *buffer, size_t length) override {
+    size_t count = position < available ? available - position : 0;
+    count = count < length ? count : length;
+    memset(buffer, 'x', count);
+    position += count;
+    return count;
+  }
+  void close(Handle) override {}
+
+private:
+  size_t promised;
+  size_t available;
+  size_t position;
+};
+
+} // namespace
+
+void test_native_storage_driver_read() {
+  StorageDir dir;
+  dir.write("boot", digits(100));
+  for (bool useMmap : {true, false}) {
+    NativeFileStorageDriver driver(dir.root, useMmap);
+    IStorageDriver::Handle handle = driver.open("logs", "boot");
+    TEST_ASSERT_NOT_EQUAL(IStorageDriver::INVALID_HANDLE, handle);
+    TEST_ASSERT_EQUAL(100, driver.size(handle));
+    TEST_ASSERT_EQUAL(useMmap, driver.contiguousView(handle) != nullptr);
+
+    uint8_t buffer[8];
+    TEST_ASSERT_TRUE(driver.seek(handle, 95));
+    TEST_ASSERT_EQUAL(5, driver.read(handle, buffer, sizeof(buffer)));
+    TEST_ASSERT_EQUAL_MEMORY("56789", buffer, 5);
+    TEST_ASSERT_EQUAL(0, driver.read(handle, buffer, sizeof(buffer)));
+    TEST_ASSERT_FALSE(driver.seek(handle, 101));
+
+    driver.close(handle);
+    TEST_ASSERT_EQUAL(0, driver.openCount());
+    TEST_ASSERT_EQUAL(0, driver.size(handle));
+  }
+
+  // Missing objects and names escaping the root are refused
+  NativeFileStorageDriver driver(dir.root);
+  TEST_ASSERT_EQUAL(IStorageDriver::INVALID_HANDLE,
+                    driver.open("logs", "missing"));
+  TEST_ASSERT_EQUAL(IStorageDriver::INVALID_HANDLE, driver.open("..", "x"));
+  TEST_ASSERT_EQUAL(IStorageDriver::INVALID_HANDLE,
+                    driver.open("logs", "../logs/boot"));
+  TEST_ASSERT_EQUAL(IStorageDriver::INVALID_HANDLE, driver.open("", "boot"));
+}
+
+void test_native_storage_driver_serve() {
+  StorageDir dir;
+  dir.write("boot", digits(100));
+  NativeWebPlatform platform(0);
+  registerLogRoute(platform);
+
+  TEST_ASSERT_TRUE(contains(serve(platform, "GET /logs/boot HTTP/1.1\r\n\r\n"),
+                            "501 Not Implemented"));
+
+  NativeFileStorageDriver driver(dir.root, false);
+  StorageDriverRegistry::registerDriver("native-test", &driver);
+
+  std::string full = serve(platform, "GET /logs/boot HTTP/1.1\r\n\r\n");
+  TEST_ASSERT_TRUE(contains(full, "HTTP/1.1 200 OK\r\n"));
+  TEST_ASSERT_TRUE(contains(full, "Accept-Ranges: bytes\r\n"));
+  TEST_ASSERT_TRUE(contains(full, "Content-Length: 100\r\n"));
+  TEST_ASSERT_TRUE(contains(full, ("\r\n\r\n" + digits(100)).c_str()));
+
+  // Seeks to the range start in the driver
+  std::string partial = serve(platform, "GET /logs/boot HTTP/1.1\r\n"
+                                        "Range: bytes=-4\r\n"
+                                        "If-Range: \"v1\"\r\n\r\n");
+  TEST_ASSERT_TRUE(contains(partial, "HTTP/1.1 206 Partial Content\r\n"));
+  TEST_ASSERT_TRUE(contains(partial, "Content-Range: bytes 96-99/100\r\n"));
+  TEST_ASSERT_TRUE(contains(partial, "Content-Length: 4\r\n\r\n6789"));
+
+  std::string multi = serve(platform, "GET /logs/boot HTTP/1.1\r\n"
+                                      "Range: bytes=0-1,5-6\r\n\r\n");
+  TEST_ASSERT_TRUE(contains(multi, "416 Range Not Satisfiable"));
+  TEST_ASSERT_TRUE(contains(multi, "Content-Range: bytes */100\r\n"));
+  TEST_ASSERT_TRUE(contains(multi, "Content-Length: 0\r\n"));
+
+  TEST_ASSERT_TRUE(contains(
+      serve(platform, "GET /logs/missing HTTP/1.1\r\n\r\n"), "404 Not Found"));
+  TEST_ASSERT_EQUAL(0, driver.openCount());
+  StorageDriverRegistry::unregisterDriver("native-test");
+}
+
+void test_native_storage_driver_short_read() {
+  NativeWebPlatform platform(0);
+  registerLogRoute(platform);
+  ShortReadDriver driver(100, 30);
+  StorageDriverRegistry::registerDriver("native-test", &driver);
+
+  // Never padded: the transfer ends short and the connection closes
+  const char *raw = "GET /logs/boot HTTP/1.1\r\n\r\n";
+  bool keepAlive = true;
+  std::string response = platform.handleRawRequest(raw, strlen(raw),
+                                                   keepAlive);
+  TEST_ASSERT_TRUE(contains(response, "Content-Length: 100\r\n"));
+  TEST_ASSERT_EQUAL(30, response.size() - response.find("\r\n\r\n") - 4);
+  TEST_ASSERT_EQUAL(std::string::npos, response.find('\0'));
+  TEST_ASSERT_FALSE(keepAlive);
+  StorageDriverRegistry::unregisterDriver("native-test");
+}
+
+void test_native_storage_driver_etag() {
+  StorageDir dir;
+  dir.write("boot", digits(100));
+  NativeFileStorageDriver driver(dir.root);
+  IStorageDriver::Handle handle = driver.open("logs", "boot");
+  String etag = driver.etag(handle);
+  driver.close(handle);
+  TEST_ASSERT_TRUE(etag.startsWith("\""));
+  TEST_ASSERT_EQUAL_STRING("", driver.etag(handle).c_str());
+
+  NativeWebPlatform platform(0);
+  registerLogRoute(platform, false);
+  StorageDriverRegistry::registerDriver("native-test", &driver);
+
+  std::string full = serve(platform, "GET /logs/boot HTTP/1.1\r\n\r\n");
+  TEST_ASSERT_TRUE(contains(full, "HTTP/1.1 200 OK\r\n"));
+  TEST_ASSERT_TRUE(contains(full, ("ETag: " + etag + "\r\n").c_str()));
+
+  // Answered without reading the object
+  std::string request =
+      "GET /logs/boot HTTP/1.1\r\nIf-None-Match: " + std::string(etag.c_str()) +
+      "\r\n\r\n";
+  std::string cached = serve(platform, request.c_str());
+  TEST_ASSERT_TRUE(contains(cached, "HTTP/1.1 304 Not Modified\r\n"));
+  TEST_ASSERT_FALSE(contains(cached, "Content-Length"));
+  TEST_ASSERT_FALSE(contains(cached, digits(10).c_str()));
+  TEST_ASSERT_EQUAL(0, driver.openCount());
+
+  // The strong tag also satisfies If-Range
+  request = "GET /logs/boot HTTP/1.1\r\nRange: bytes=-2\r\nIf-Range: " +
+            std::string(etag.c_str()) + "\r\n\r\n";
+  TEST_ASSERT_TRUE(
+      contains(serve(platform, request.c_str()), "206 Partial Content"));
+
+  // A rewritten object gets a new tag and a full response
+  dir.write("boot", digits(120));
+  request = "GET /logs/boot HTTP/1.1\r\nIf-None-Match: " +
+            std::string(etag.c_str()) + "\r\n\r\n";
+  std::string changed = serve(platform, request.c_str());
+  TEST_ASSERT_TRUE(contains(changed, "HTTP/1.1 200 OK\r\n"));
+  TEST_ASSERT_TRUE(contains(changed, "Content-Length: 120\r\n"));
+  TEST_ASSERT_FALSE(contains(changed, etag.c_str()));
+  StorageDriverRegistry::unregisterDriver("native-test");
+}
+
+// Memory-mapped bodies go out with sendmsg() after the headers, and a
+// pipelined request behind one is answered once it has been written
+void test_native_storage_driver_socket() {
+  const size_t size = 3 * 1024 * 1024;
+  StorageDir dir;
+  dir.write("big", digits(size));
+  NativeFileStorageDriver driver(dir.root);
+  StorageDriverRegistry::registerDriver("native-test", &driver);
+  NativeWebPlatform platform(0);
+  registerLogRoute(platform);
+  platform.begin("loopback");
+
+  int client = socket(AF_INET, SOCK_STREAM, 0);
+  sockaddr_in address = {};
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  address.sin_port = htons(platform.getPort());
+  TEST_ASSERT_EQUAL(0, connect(client, reinterpret_cast<sockaddr *>(&address),
+                               sizeof(address)));
+  const char requests[] = "GET /logs/big HTTP/1.1\r\n\r\n"
+                          "GET /logs/big HTTP/1.1\r\nRange: bytes=10-19\r\n"
+                          "Connection: close\r\n\r\n";
+  send(client, requests, sizeof(requests) - 1, 0);
+
+  std::string received;
+  std::vector<char> buffer(64 * 1024);
+  for (int i = 0; i < 5000; i++) {
+    platform.poll(1);
+    ssize_t count = recv(client, buffer.data(), buffer.size(), MSG_DONTWAIT);
+    if (count == 0) {
+      break;
+    }
+    if (count > 0) {
+      received.append(buffer.data(), count);
+    }
+  }
+  close(client);
+
+  size_t body = received.find("\r\n\r\n") + 4;
+  TEST_ASSERT_TRUE(received.compare(body, size, digits(size)) == 0);
+  std::string second = received.substr(body + size);
+  TEST_ASSERT_TRUE(contains(second, "HTTP/1.1 206 Partial Content\r\n"));
+  TEST_ASSERT_TRUE(contains(second, "\r\n\r\n0123456789"));
+  TEST_ASSERT_EQUAL(0, driver.openCount());
+  StorageDriverRegistry::unregisterDriver("native-test");
+}
+
+void register_native_storage_driver_tests() {
+  RUN_TEST(test_native_storage_driver_read);
+  RUN_TEST(test_native_storage_driver_serve);
+  RUN_TEST(test_native_storage_driver_short_read);
+  RUN_TEST(test_native_storage_driver_etag);
+  RUN_TEST(test_native_storage_driver_socket);
+}
+
+#else
+
+void register_native_storage_driver_tests() {}
+
+#endif // NATIVE_PLATFORM && __linux__
@@ -0,0 +1,603 @@
+#include "../../include/testing/test_native_web_platform.h"
+#include "../../include/testing/gzip_test_decoder.h"
+#include <unity.h>
+
+#if defined(NATIVE_PLATFORM) && defined(__linux__)
+#include <ArduinoFake.h>
+#include <arpa/inet.h>
+#include <cstring>
+#include <netinet/in.h>
+#include <string>
+#include <sys/socket.h>
+#include <testing/native_web_platform.h>
+#include <unistd.h>
+
+namespace {
+
+std::string serve(NativeWebPlatform &platform, const char *raw,
+                  bool *keepAlive = nullptr) {
+  bool reuse = false;
+  std::string response = platform.handleRawRequest(raw, strlen(raw), reuse);
+  if (keepAlive) {
+    *keepAlive = reuse;
+  }
+  return response;
+}
+
+bool contains(const std::string &text, const char *part) {
+  return text.find(part) != std::string::npos;
+}
+
+class DeviceModule : public IWebModule {
+public:
+  std::vector<RouteVariant> getHttpRoutes() override {
+    return {WebRoute("/devices/{id}", WebModule::WM_GET,
+                     [](WebRequest &req, WebResponse &res) {
+                       res.setContent("device " +
+                                          req.getRouteParameter("id"),
+                                      "text/plain");
+                     }),
+            ApiRoute("/devices", WebModule::WM_POST,
+                     [](WebRequest &req, WebResponse &res) {
+                       res.setStatus(201);
+                       res.setContent(req.getJsonParam("name"),
+                                      "text/plain");
+                     },
+                     {AuthType::TOKEN})};
+  }
+  std::vector<RouteVariant> getHttpsRoutes() override {
+    return getHttpRoutes();
+  }
+  String getModuleName() const override { return "devices"; }
+};
+
+} // namespace
+
+void test_native_web_platform_dispatch() {
+  NativeWebPlatform platform(0);
+  DeviceModule module;
+  platform.registerModule("/home", &module);
+  platform.addGlobalRedirect("/old", "/home/devices/1");
+  TEST_ASSERT_EQUAL(2, platform.getRouteCount());
+
+  bool keepAlive = false;
+  std::string response =
+      serve(platform, "GET /home/devices/7 HTTP/1.1\r\nHost: x\r\n\r\n",
+            &keepAlive);
+  TEST_ASSERT_TRUE(contains(response, "HTTP/1.1 200 OK\r\n"));
+  TEST_ASSERT_TRUE(contains(response, "Content-Type: text/plain\r\n"));
+  TEST_ASSERT_TRUE(contains(response, "Content-Length: 8\r\n\r\ndevice 7"));
+  TEST_ASSERT_TRUE(keepAlive);
+
+  response = serve(platform, "GET /missing HTTP/1.0\r\n\r\n", &keepAlive);
+  TEST_ASSERT_TRUE(contains(response, "HTTP/1.1 404 Not Found\r\n"));
+  TEST_ASSERT_TRUE(contains(response, "Connection: close\r\n"));
+  TEST_ASSERT_FALSE(keepAlive);
+
+  platform.setErrorPage(404, "<h1>Gone</h1>");
+  response = serve(platform, "GET /missing HTTP/1.1\r\n\r\n");
+  TEST_ASSERT_TRUE(contains(response, "\r\n\r\n<h1>Gone</h1>"));
+
+  response = serve(platform, "GET /old HTTP/1.1\r\n\r\n");
+  TEST_ASSERT_TRUE(contains(response, "HTTP/1.1 302 Found\r\n"));
+  TEST_ASSERT_TRUE(contains(response, "Location: /home/devices/1\r\n"));
+  TEST_ASSERT_EQUAL(4, platform.getRequestCount());
+}
+
+void test_native_web_platform_methods() {
+  NativeWebPlatform platform(0);
+  DeviceModule module;
+  platform.registerModule("/home", &module);
+
+  // HEAD: the GET headers, Content-Length included, and no body
+  bool keepAlive = false;
+  std::string head =
+      serve(platform, "HEAD /home/devices/7 HTTP/1.1\r\n\r\n", &keepAlive);
+  TEST_ASSERT_TRUE(contains(head, "HTTP/1.1 200 OK\r\n"));
+  TEST_ASSERT_TRUE(contains(head, "Content-Length: 8\r\n"));
+  TEST_ASSERT_EQUAL(head.size(), head.find("\r\n\r\n") + 4);
+  TEST_ASSERT_TRUE(keepAlive);
+
+  // Byte for byte the GET response minus its 8-byte body
+  std::string get = serve(platform, "GET /home/devices/7 HTTP/1.1\r\n\r\n");
+  TEST_ASSERT_EQUAL_STRING(head.c_str(),
+                           get.substr(0, get.size() - 8).c_str());
+
+  // Methods no route can declare never reach a handler
+  std::string options =
+      serve(platform, "OPTIONS /home/devices/7 HTTP/1.1\r\n\r\n");
+  TEST_ASSERT_TRUE(contains(options, "HTTP/1.1 501 Not Implemented\r\n"));
+  TEST_ASSERT_FALSE(contains(options, "device 7"));
+  TEST_ASSERT_TRUE(
+      contains(serve(platform, "FOO /home/devices/7 HTTP/1.1\r\n\r\n"),
+               "HTTP/1.1 501 Not Implemented\r\n"));
+}
+
+void test_native_web_platform_auth() {
+  NativeWebPlatform platform(0);
+  DeviceModule module;
+  platform.registerModule("/home", &module);
+  platform.addApiToken("secret", "loadtest");
+
+  const char *body = "{\"name\":\"lamp\"}";
+  std::string request = "POST /api/home/devices HTTP/1.1\r\n"
+                        "Content-Type: application/json\r\n"
+                        "Content-Length: " +
+                        std::to_string(strlen(body)) + "\r\n";
+  std::string anonymous = request + "\r\n" + body;
+  std::string wrongToken =
+      request + "Authorization: Bearer nope\r\n\r\n" + body;
+  std::string withToken =
+      request + "Authorization: Bearer secret\r\n\r\n" + body;
+
+  TEST_ASSERT_TRUE(
+      contains(serve(platform, anonymous.c_str()), "401 Unauthorized"));
+  TEST_ASSERT_TRUE(
+      contains(serve(platform, wrongToken.c_str()), "401 Unauthorized"));
+  std::string response = serve(platform, withToken.c_str());
+  TEST_ASSERT_TRUE(contains(response, "HTTP/1.1 201 Created\r\n"));
+  TEST_ASSERT_TRUE(contains(response, "\r\n\r\nlamp"));
+
+  // Sessions and local-only routes
+  AuthContext seen;
+  platform.registerWebRoute(
+      "/account",
+      [&seen](WebRequest &req, WebResponse &res) {
+        seen = req.getAuthContext();
+      },
+      {AuthType::SESSION}, WebModule::WM_GET);
+  platform.registerWebRoute(
+      "/local", [](WebRequest &req, WebResponse &res) {},
+      {AuthType::LOCAL_ONLY}, WebModule::WM_GET);
+  platform.addSession("abc", "alice");
+  response = serve(platform, "GET /account HTTP/1.1\r\n"
+                             "Cookie: theme=dark; session=abc\r\n\r\n");
+  TEST_ASSERT_TRUE(contains(response, "200 OK"));
+  TEST_ASSERT_TRUE(seen.hasValidSession());
+  TEST_ASSERT_EQUAL_STRING("alice", seen.username.c_str());
+  TEST_ASSERT_TRUE(
+      contains(serve(platform, "GET /local HTTP/1.1\r\n\r\n"), "200 OK"));
+}
+
+void test_native_web_platform_json_stream() {
+  NativeWebPlatform platform(0);
+  platform.registerApiRoute(
+      "/items",
+      [](WebRequest &req, WebResponse &res) {
+        res.setJsonStreamContent([](JsonStreamWriter &json) {
+          json.beginArray().value(1).value(2).endArray();
+        });
+      },
+      {AuthType::NONE}, WebModule::WM_GET, OpenAPIDocumentation());
+
+  std::string response = serve(platform, "GET /api/items HTTP/1.1\r\n\r\n");
+  TEST_ASSERT_TRUE(contains(response, "Transfer-Encoding: chunked\r\n"));
+  TEST_ASSERT_TRUE(contains(response, "\r\n\r\n5\r\n[1,2]\r\n0\r\n\r\n"));
+  TEST_ASSERT_FALSE(contains(response, "Content-Length"));
+}
+
+// GET /openapi.json streams the spec of the live API routes
+void test_native_web_platform_openapi() {
+  NativeWebPlatform platform(0);
+  platform.begin("Spec Device");
+  platform.registerApiRoute(
+      "/items/{id}", [](WebRequest &req, WebResponse &res) {},
+      {AuthType::TOKEN}, WebModule::WM_GET,
+      OpenAPIDocumentation("Get item").withResponseSchema(
+          "{\"type\": \"object\"}"));
+  platform.registerApiRoute(
+      "/old", [](WebRequest &req, WebResponse &res) {}, {AuthType::NONE},
+      WebModule::WM_GET, OpenAPIDocumentation("Old"));
+  platform.disableRoute("/api/old", WebModule::WM_GET);
+
+  std::string response = serve(platform, "GET /openapi.json HTTP/1.1\r\n\r\n");
+  TEST_ASSERT_TRUE(contains(response, "HTTP/1.1 200 OK\r\n"));
+  TEST_ASSERT_TRUE(contains(response, "Transfer-Encoding: chunked\r\n"));
+  TEST_ASSERT_TRUE(contains(response, "\"title\":\"Spec Device\""));
+  TEST_ASSERT_TRUE(contains(response, "\"/api/items/{id}\":{\"get\":{"
+                                      "\"summary\":\"Get item\""));
+  TEST_ASSERT_TRUE(contains(response, "\"schema\":{\"type\":\"object\"}"));
+  TEST_ASSERT_FALSE(contains(response, "/api/old"));
+  TEST_ASSERT_TRUE(contains(
+      serve(platform, "POST /openapi.json HTTP/1.1\r\n\r\n"), "404"));
+}
+
+// Weak stream ETags: the body is hashed first and skipped on a match
+void test_native_web_platform_json_stream_etag() {
+  NativeWebPlatform platform(0);
+  int streams = 0;
+  platform.registerApiRoute(
+      "/items",
+      [&streams](WebRequest &req, WebResponse &res) {
+        res.setJsonStreamContent([&streams](JsonStreamWriter &json) {
+          streams++;
+          json.beginArray().value(1).value(2).endArray();
+        });
+        res.enableJsonStreamETag();
+      },
+      {AuthType::NONE}, WebModule::WM_GET, OpenAPIDocumentation());
+
+  std::string full = serve(platform, "GET /api/items HTTP/1.1\r\n\r\n");
+  size_t start = full.find("ETag: W/\"");
+  TEST_ASSERT_TRUE(start != std::string::npos);
+  std::string etag = full.substr(start + 6, 20);
+  TEST_ASSERT_TRUE(contains(full, "\r\n\r\n5\r\n[1,2]\r\n0\r\n\r\n"));
+  TEST_ASSERT_EQUAL(2, streams);
+
+  std::string conditional =
+      "GET /api/items HTTP/1.1\r\nIf-None-Match: " + etag + "\r\n\r\n";
+  std::string cached = serve(platform, conditional.c_str());
+  TEST_ASSERT_TRUE(contains(cached, "HTTP/1.1 304 Not Modified\r\n"));
+  TEST_ASSERT_TRUE(contains(cached, ("ETag: " + etag + "\r\n").c_str()));
+  TEST_ASSERT_FALSE(contains(cached, "Transfer-Encoding"));
+  TEST_ASSERT_FALSE(contains(cached, "[1,2]"));
+  TEST_ASSERT_EQUAL(3, streams);
+}
+
+// Plain PROGMEM bodies are tagged once by the platform
+void test_native_web_platform_progmem_etag() {
+  static const char PAGE[] PROGMEM = "<h1>Settings</h1>";
+  NativeWebPlatform platform(0);
+  platform.registerWebRoute(
+      "/settings",
+      [](WebRequest &req, WebResponse &res) {
+        res.setProgmemContent(PAGE, "text/html");
+      },
+      {AuthType::NONE}, WebModule::WM_GET);
+
+  std::string etag = ETag::compute(reinterpret_cast<const uint8_t *>(PAGE),
+                                   strlen(PAGE))
+                         .c_str();
+  std::string full = serve(platform, "GET /settings HTTP/1.1\r\n\r\n");
+  TEST_ASSERT_TRUE(contains(full, ("ETag: " + etag + "\r\n").c_str()));
+  TEST_ASSERT_TRUE(contains(full, "\r\n\r\n<h1>Settings</h1>"));
+
+  std::string conditional =
+      "GET /settings HTTP/1.1\r\nIf-None-Match: " + etag + "\r\n\r\n";
+  std::string cached = serve(platform, conditional.c_str());
+  TEST_ASSERT_TRUE(contains(cached, "HTTP/1.1 304 Not Modified\r\n"));
+  TEST_ASSERT_FALSE(contains(cached, "Settings"));
+}
+
+// Chunked gzip bodies for clients that accept them
+void test_native_web_platform_compression() {
+  NativeWebPlatform platform(0);
+  std::string list = "[";
+  for (int i = 0; i < 200; i++) {
+    list += (i ? ",{\"id\":" : "{\"id\":") + std::to_string(i) + "}";
+  }
+  list += "]";
+  class ListModule : public IWebModule {
+  public:
+    explicit ListModule(const std::string &list) : list(list) {}
+    std::vector<RouteVariant> getHttpRoutes() override {
+      return {ApiRoute("/list", WebModule::WM_GET,
+                       [this](WebRequest &req, WebResponse &res) {
+                         res.setContent(list.c_str(), "application/json");
+                       })
+                  .compressed(),
+              ApiRoute("/tiny", WebModule::WM_GET,
+                       [](WebRequest &req, WebResponse &res) {
+                         res.setContent("{}", "application/json");
+                       })};
+    }
+    std::vector<RouteVariant> getHttpsRoutes() override {
+      return getHttpRoutes();
+    }
+    String getModuleName() const override { return "list"; }
+
+  private:
+    const std::string &list;
+  };
+  ListModule module(list);
+  platform.registerModule("/devices", &module);
+
+  std::string plain = serve(platform, "GET /api/devices/list HTTP/1.1\r\n\r\n");
+  TEST_ASSERT_TRUE(contains(plain, ("\r\n\r\n" + list).c_str()));
+
+  std::string response = serve(platform, "GET /api/devices/list HTTP/1.1\r\n"
+                                         "Accept-Encoding: gzip\r\n\r\n");
+  TEST_ASSERT_TRUE(contains(response, "Content-Encoding: gzip\r\n"));
+  TEST_ASSERT_TRUE(contains(response, "Vary: Accept-Encoding\r\n"));
+  TEST_ASSERT_TRUE(contains(response, "Transfer-Encoding: chunked\r\n"));
+
+  // Reassemble the chunks and inflate
+  std::string gzip;
+  size_t pos = response.find("\r\n\r\n") + 4;
+  while (true) {
+    size_t length = strtoul(response.c_str() + pos, nullptr, 16);
+    pos = response.find("\r\n", pos) + 2;
+    if (length == 0) {
+      break;
+    }
+    gzip.append(response, pos, length);
+    pos += length + 2;
+  }
+  std::string decoded;
+  TEST_ASSERT_TRUE(gzipTestDecode(gzip, decoded));
+  TEST_ASSERT_TRUE(decoded == list);
+  TEST_ASSERT_LESS_THAN(list.size() / 2, gzip.size());
+
+  // Platform-wide policy: filtered by type and size
+  ResponseCompressionPolicy policy;
+  policy.windowBits = 9;
+  policy.minBytes = 2;
+  policy.mimeTypes = "text/";
+  platform.setResponseCompression(policy);
+  const char *tiny = "GET /api/devices/tiny HTTP/1.1\r\n"
+                     "Accept-Encoding: gzip\r\n\r\n";
+  TEST_ASSERT_FALSE(contains(serve(platform, tiny), "Content-Encoding"));
+  policy.mimeTypes = "application/json";
+  platform.setResponseCompression(policy);
+  TEST_ASSERT_TRUE(contains(serve(platform, tiny), "Content-Encoding: gzip"));
+}
+
+void test_native_web_platform_socket() {
+  NativeWebPlatform platform(0);
+  platform.registerWebRoute(
+      "/ping",
+      [](WebRequest &req, WebResponse &res) {
+        res.setContent("pong", "text/plain");
+      },
+      {AuthType::NONE}, WebModule::WM_GET);
+  platform.begin("loopback");
+  TEST_ASSERT_TRUE(platform.isConnected());
+  TEST_ASSERT_NOT_EQUAL(0, platform.getPort());
+
+  int client = socket(AF_INET, SOCK_STREAM, 0);
+  sockaddr_in address = {};
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  address.sin_port = htons(platform.getPort());
+  TEST_ASSERT_EQUAL(0, connect(client, reinterpret_cast<sockaddr *>(&address),
+                               sizeof(address)));
+
+  // Two pipelined requests on one keep-alive connection
+  const char pipelined[] = "GET /ping HTTP/1.1\r\nHost: a\r\n\r\n"
+                           "GET /ping HTTP/1.1\r\nConnection: close\r\n\r\n";
+  TEST_ASSERT_EQUAL(sizeof(pipelined) - 1,
+                    send(client, pipelined, sizeof(pipelined) - 1, 0));
+
+  std::string received;
+  char buffer[1024];
+  for (int i = 0; i < 100; i++) {
+    platform.poll(10);
+    ssize_t count = recv(client, buffer, sizeof(buffer), MSG_DONTWAIT);
+    if (count == 0) {
+      break; // Server closed after the second response
+    }
+    if (count > 0) {
+      received.append(buffer, count);
+    }
+  }
+  close(client);
+
+  TEST_ASSERT_EQUAL(2, platform.getRequestCount());
+  size_t first = received.find("\r\n\r\npong");
+  TEST_ASSERT_TRUE(first != std::string::npos);
+  TEST_ASSERT_TRUE(received.find("\r\n\r\npong", first + 1) !=
+                   std::string::npos);
+  TEST_ASSERT_TRUE(contains(received, "Connection: close\r\n"));
+}
+
+void test_native_web_platform_response_cache() {
+  NativeWebPlatform platform(0);
+  platform.addApiToken("secret");
+  int calls = 0;
+
+  class StatusModule : public IWebModule {
+  public:
+    explicit StatusModule(int &calls) : calls(calls) {}
+    std::vector<RouteVariant> getHttpRoutes() override {
+      return {ApiRoute("/status", WebModule::WM_GET,
+                       [this](WebRequest &req, WebResponse &res) {
+                         calls++;
+                         res.setHeader("X-Call", String(calls));
+                         res.setContent("{\"fields\":\"" +
+                                            req.getParam("fields") + "\"}",
+                                        "application/json");
+                       },
+                       {AuthType::TOKEN})
+                  .cached(60000, "fields")};
+    }
+    std::vector<RouteVariant> getHttpsRoutes() override {
+      return getHttpRoutes();
+    }
+    String getModuleName() const override { return "status"; }
+    void statusChanged(IWebPlatform &platform) {
+      platform.invalidateResponseCache(this, "/status");
+    }
+
+  private:
+    int &calls;
+  };
+
+  StatusModule module(calls);
+  platform.registerModule("/sys", &module);
+  const char *request = "GET /api/sys/status?fields=a&t=1 HTTP/1.1\r\n"
+                        "Authorization: Bearer secret\r\n\r\n";
+  const char *otherTime = "GET /api/sys/status?t=2&fields=a HTTP/1.1\r\n"
+                          "Authorization: Bearer secret\r\n\r\n";
+  const char *otherFields = "GET /api/sys/status?fields=b HTTP/1.1\r\n"
+                            "Authorization: Bearer secret\r\n\r\n";
+
+  std::string first = serve(platform, request);
+  TEST_ASSERT_TRUE(contains(first, "X-Call: 1\r\n"));
+  TEST_ASSERT_TRUE(contains(first, "\r\n\r\n{\"fields\":\"a\"}"));
+
+  // Same key: served from the cache, byte for byte
+  TEST_ASSERT_EQUAL_STRING(first.c_str(), serve(platform, otherTime).c_str());
+  TEST_ASSERT_EQUAL(1, calls);
+  TEST_ASSERT_TRUE(contains(serve(platform, otherFields), "X-Call: 2\r\n"));
+
+  // Authentication still applies to cached routes
+  TEST_ASSERT_TRUE(contains(
+      serve(platform, "GET /api/sys/status?fields=a HTTP/1.1\r\n\r\n"),
+      "401 Unauthorized"));
+
+  platform.invalidateResponseCache("/api/sys");
+  TEST_ASSERT_TRUE(contains(serve(platform, request), "X-Call: 3\r\n"));
+  TEST_ASSERT_EQUAL(3, calls);
+  TEST_ASSERT_EQUAL(1, platform.getResponseCache().stats().hits);
+
+  // The module names its own route; the platform adds the mount point
+  module.statusChanged(platform);
+  TEST_ASSERT_TRUE(contains(serve(platform, request), "X-Call: 4\r\n"));
+}
+
+void test_native_web_platform_response_cache_formats() {
+  NativeWebPlatform platform(0);
+  int calls = 0;
+
+  class ReadingsModule : public IWebModule {
+  public:
+    ReadingsModule(NativeWebPlatform &platform, int &calls)
+        : platform(platform), calls(calls) {}
+    std::vector<RouteVariant> getHttpRoutes() override {
+      return {ApiRoute("/readings", WebModule::WM_GET,
+                       [this](WebRequest &, WebResponse &res) {
+                         calls++;
+                         platform.createJsonResponse(res, [](JsonObject &obj) {
+                           obj["celsius"] = 21;
+                         });
+                       })
+                  .cached(60000)};
+    }
+    std::vector<RouteVariant> getHttpsRoutes() override {
+      return getHttpRoutes();
+    }
+    String getModuleName() const override { return "readings"; }
+
+  private:
+    NativeWebPlatform &platform;
+    int &calls;
+  };
+
+  ReadingsModule module(platform, calls);
+  platform.registerModule("/sensors", &module);
+  const char *json = "GET /api/sensors/readings HTTP/1.1\r\n\r\n";
+  const char *packed = "GET /api/sensors/readings HTTP/1.1\r\n"
+                       "Accept: application/msgpack\r\n\r\n";
+
+  // A cached JSON answer is never handed to a MessagePack client
+  std::string first = serve(platform, json);
+  TEST_ASSERT_TRUE(contains(first, "Content-Type: application/json\r\n"));
+  TEST_ASSERT_TRUE(contains(first, "Vary: Accept\r\n"));
+  std::string binary = serve(platform, packed);
+  TEST_ASSERT_TRUE(
+      contains(binary, "Content-Type: application/msgpack\r\n"));
+  TEST_ASSERT_EQUAL(2, calls);
+
+  // Both formats are cached, each under its own key
+  TEST_ASSERT_EQUAL_STRING(first.c_str(), serve(platform, json).c_str());
+  TEST_ASSERT_EQUAL_STRING(binary.c_str(), serve(platform, packed).c_str());
+  TEST_ASSERT_EQUAL(2, calls);
+}
+
+void test_native_web_platform_request_validation() {
+  class ThermostatModule : public IWebModule {
+  public:
+    int calls = 0;
+    std::vector<RouteVariant> getHttpRoutes() override {
+      return {ApiRoute("/target", WebModule::WM_PUT,
+                       [this](WebRequest &req, WebResponse &res) {
+                         calls++;
+                         res.setContent("set", "text/plain");
+                       })
+                  .validated(R"({
+                      "type": "object",
+                      "properties": {
+                          "celsius": {"type": "number", "maximum": 30}
+                      },
+                      "required": ["celsius"]
+                  })")};
+    }
+    std::vector<RouteVariant> getHttpsRoutes() override {
+      return getHttpRoutes();
+    }
+    String getModuleName() const override { return "thermostat"; }
+  };
+
+  NativeWebPlatform platform(0);
+  ThermostatModule module;
+  platform.registerModule("/heating", &module);
+  auto put = [&platform](const std::string &body) {
+    std::string request = "PUT /api/heating/target HTTP/1.1\r\n"
+                          "Content-Type: application/json\r\n"
+                          "Content-Length: " +
+                          std::to_string(body.length()) + "\r\n\r\n" + body;
+    return serve(platform, request.c_str());
+  };
+
+  TEST_ASSERT_TRUE(contains(put("{\"celsius\": 21.5}"), "200 OK"));
+  TEST_ASSERT_EQUAL(1, module.calls);
+
+  // Rejected before dispatch: the handler never runs
+  std::string response = put("{\"celsius\": 45}");
+  TEST_ASSERT_TRUE(contains(response, "HTTP/1.1 400 Bad Request\r\n"));
+  TEST_ASSERT_TRUE(contains(
+      response, "Invalid request body: celsius is above the maximum"));
+  TEST_ASSERT_TRUE(
+      contains(put("{}"), "Invalid request body: celsius is required"));
+  TEST_ASSERT_TRUE(
+      contains(put("not json"), "Invalid request body: body has the wrong"));
+  TEST_ASSERT_EQUAL(1, module.calls);
+}
+
+void test_native_web_platform_https_routes() {
+  class SecureModule : public IWebModule {
+  public:
+    std::vector<RouteVariant> getHttpRoutes() override {
+      return {WebRoute("/status", WebModule::WM_GET,
+                       [](WebRequest &req, WebResponse &res) {
+                         res.setContent("http", "text/plain");
+                       })};
+    }
+    std::vector<RouteVariant> getHttpsRoutes() override {
+      return {WebRoute("/status", WebModule::WM_GET,
+                       [](WebRequest &req, WebResponse &res) {
+                         res.setContent("http", "text/plain");
+                       }),
+              WebRoute("/keys", WebModule::WM_GET,
+                       [](WebRequest &req, WebResponse &res) {
+                         res.setContent("keys", "text/plain");
+                       })};
+    }
+    String getModuleName() const override { return "secure"; }
+  };
+
+  NativeWebPlatform platform(0);
+  SecureModule module;
+  platform.registerModule("/secure", &module);
+  TEST_ASSERT_EQUAL(2, platform.getRouteCount());
+
+  // Served over plain HTTP since there is no TLS on the host
+  std::string response =
+      serve(platform, "GET /secure/keys HTTP/1.1\r\n\r\n");
+  TEST_ASSERT_TRUE(contains(response, "HTTP/1.1 200 OK\r\n"));
+  TEST_ASSERT_TRUE(contains(response, "\r\n\r\nkeys"));
+  response = serve(platform, "GET /secure/status HTTP/1.1\r\n\r\n");
+  TEST_ASSERT_TRUE(contains(response, "\r\n\r\nhttp"));
+}
+
+void register_native_web_platform_tests() {
+  RUN_TEST(test_native_web_platform_dispatch);
+  RUN_TEST(test_native_web_platform_methods);
+  RUN_TEST(test_native_web_platform_response_cache);
+  RUN_TEST(test_native_web_platform_response_cache_formats);
+  RUN_TEST(test_native_web_platform_auth);
+  RUN_TEST(test_native_web_platform_json_stream);
+  RUN_TEST(test_native_web_platform_json_stream_etag);
+  RUN_TEST(test_native_web_platform_progmem_etag);
+  RUN_TEST(test_native_web_platform_openapi);
+  RUN_TEST(test_native_web_platform_compression);
+  RUN_TEST(test_native_web_platform_socket);
+  RUN_TEST(test_native_web_platform_request_validation);
+  RUN_TEST(test_native_web_platform_https_routes);
+}
+
+#else
+
+void register_native_web_platform_tests() {}
+
+#endif // NATIVE_PLATFORM && __linux__
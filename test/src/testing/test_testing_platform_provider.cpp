@@ -595,6 +595,44 @@ void test_mock_web_platform_json_serialization_coverage() {
 }
 
 // Register all tests
+// Recorded module routes produce the spec tools/openapi_extract embeds
+void test_mock_web_platform_openapi_spec() {
+  class DocumentedModule : public IWebModule {
+  public:
+    std::vector<RouteVariant> getHttpRoutes() override {
+      return {ApiRoute("/items", WebModule::WM_GET,
+                       [](WebRequest &req, WebResponse &res) {},
+                       OpenAPIDocumentation("List items")),
+              WebRoute("/page", WebModule::WM_GET,
+                       [](WebRequest &req, WebResponse &res) {})};
+    }
+    std::vector<RouteVariant> getHttpsRoutes() override {
+      return getHttpRoutes();
+    }
+    String getModuleName() const override { return "documented"; }
+  };
+
+  MockWebPlatform platform;
+  DocumentedModule module;
+  platform.registerModule("/store", &module);
+
+  std::string spec;
+  JsonStreamWriter writer([&spec](const char *data, size_t length) {
+    spec.append(data, length);
+    return true;
+  });
+  OpenAPISpecWriter::Info info;
+  TEST_ASSERT_TRUE(platform.writeOpenApiSpec(writer, info));
+
+  // API routes only, once although offered over HTTP and HTTPS
+  const char *operation =
+      "\"/api/store/items\":{\"get\":{\"summary\":\"List items\"";
+  size_t first = spec.find(operation);
+  TEST_ASSERT_TRUE(first != std::string::npos);
+  TEST_ASSERT_TRUE(spec.find(operation, first + 1) == std::string::npos);
+  TEST_ASSERT_TRUE(spec.find("/store/page") == std::string::npos);
+}
+
 void register_testing_platform_provider_tests() {
   RUN_TEST(test_mock_web_platform_callback_defaults);
   RUN_TEST(test_mock_web_platform_https_conditions);
@@ -614,4 +652,5 @@ void register_testing_platform_provider_tests() {
   RUN_TEST(test_mock_web_platform_provider_edge_cases);
   RUN_TEST(test_mock_web_platform_string_conversion);
   RUN_TEST(test_mock_web_platform_json_serialization_coverage);
+  RUN_TEST(test_mock_web_platform_openapi_spec);
 }
\ No newline at end of file
@@ -0,0 +1,151 @@
+#include "../../include/testing/test_web_request_native.h"
+#include <ArduinoFake.h>
+#include <cstring>
+#include <interface/web_request.h>
+#include <unity.h>
+
+namespace {
+WebRequest parse(const char *raw, const String &clientIp = "10.0.0.2") {
+  return WebRequest(raw, strlen(raw), clientIp);
+}
+} // namespace
+
+void test_web_request_native_request_line() {
+  WebRequest request =
+      parse("PUT /api/devices/7?name=Living+Room&id=%37 HTTP/1.1\r\n\r\n");
+  TEST_ASSERT_EQUAL(WebModule::WM_PUT, request.getMethod());
+  TEST_ASSERT_TRUE(request.pathView() == "/api/devices/7");
+  TEST_ASSERT_EQUAL_STRING("/api/devices/7", request.getPath().c_str());
+  TEST_ASSERT_TRUE(request.paramView("name") == "Living Room");
+  TEST_ASSERT_EQUAL_STRING("7", request.getParam("id").c_str());
+  TEST_ASSERT_TRUE(request.paramView("missing").empty());
+  TEST_ASSERT_EQUAL_STRING("10.0.0.2", request.getClientIp().c_str());
+  TEST_ASSERT_EQUAL(2, request.getAllParams().size());
+
+  WebRequest bare = parse("GET / HTTP/1.0\n\n");
+  TEST_ASSERT_EQUAL(WebModule::WM_GET, bare.getMethod());
+  TEST_ASSERT_TRUE(bare.pathView() == "/");
+}
+
+void test_web_request_native_headers() {
+  WebRequest request = parse("GET /status HTTP/1.1\r\n"
+                             "Host: device.local\r\n"
+                             "Authorization:   Bearer abc123  \r\n"
+                             "X-Custom: one\r\n"
+                             "\r\n");
+  TEST_ASSERT_TRUE(request.headerView("Host") == "device.local");
+  TEST_ASSERT_TRUE(request.headerView("authorization") == "Bearer abc123");
+  TEST_ASSERT_EQUAL_STRING("one", request.getHeader("X-CUSTOM").c_str());
+  TEST_ASSERT_EQUAL_STRING("", request.getHeader("Cookie").c_str());
+
+  // Views point into the request's own arena and stay put between calls
+  TEST_ASSERT_TRUE(request.headerView("Host").data() ==
+                   request.headerView("host").data());
+}
+
+void test_web_request_native_header_ids() {
+  WebRequest request = parse("GET /status HTTP/1.1\r\n"
+                             "cookie: session=first\r\n"
+                             "X-Trace: 42\r\n"
+                             "Cookie: session=second\r\n"
+                             "AUTHORIZATION: Bearer xyz\r\n"
+                             "\r\n");
+  TEST_ASSERT_TRUE(request.headerView(HeaderId::AUTHORIZATION) ==
+                   "Bearer xyz");
+  TEST_ASSERT_EQUAL_STRING("Bearer xyz",
+                           request.getHeader(HeaderId::AUTHORIZATION).c_str());
+
+  // First occurrence wins, by id and by name alike
+  TEST_ASSERT_TRUE(request.headerView(HeaderId::COOKIE) == "session=first");
+  TEST_ASSERT_TRUE(request.headerView("Cookie") == "session=first");
+
+  // Uncommon headers use the fallback scan
+  TEST_ASSERT_TRUE(request.headerView("x-trace") == "42");
+  TEST_ASSERT_TRUE(request.headerView(HeaderId::HOST).empty());
+  TEST_ASSERT_TRUE(request.headerView(HeaderId::UNKNOWN).empty());
+}
+
+void test_web_request_native_form_body() {
+  WebRequest request =
+      parse("POST /login?next=%2Fhome HTTP/1.1\r\n"
+            "Content-Type: application/x-www-form-urlencoded\r\n"
+            "Content-Length: 27\r\n"
+            "\r\n"
+            "user=admin&pass=s%26cret!!\ntrailing");
+  TEST_ASSERT_EQUAL(WebModule::WM_POST, request.getMethod());
+  TEST_ASSERT_EQUAL(27, request.bodyView().length());
+  TEST_ASSERT_TRUE(request.paramView("user") == "admin");
+  TEST_ASSERT_TRUE(request.paramView("pass") == "s&cret!!\n");
+  TEST_ASSERT_TRUE(request.paramView("next") == "/home");
+}
+
+void test_web_request_native_json_body() {
+  WebRequest request = parse("POST /api/config HTTP/1.1\r\n"
+                             "Content-Type: application/json\r\n"
+                             "\r\n"
+                             "{\"name\":\"lamp\",\"level\":42}");
+  TEST_ASSERT_EQUAL_STRING("lamp", request.getJsonParam("name").c_str());
+  TEST_ASSERT_EQUAL_STRING("42", request.getJsonParam("level").c_str());
+  TEST_ASSERT_EQUAL_STRING("", request.getJsonParam("missing").c_str());
+  TEST_ASSERT_TRUE(request.paramView("name").empty());
+}
+
+void test_web_request_native_lazy_parsing() {
+  WebRequest request =
+      parse("POST /api/devices?dry%20run=1 HTTP/1.1\r\n"
+            "Content-Type: application/x-www-form-urlencoded\r\n"
+            "\r\n"
+            "name=Kitchen%20Lamp&dry%20run=0");
+
+  // Views taken before params are parsed survive the parse
+  StringView path = request.pathView();
+  StringView body = request.bodyView();
+  TEST_ASSERT_TRUE(request.paramView("dry run") == "1"); // Query wins
+  TEST_ASSERT_TRUE(request.paramView("name") == "Kitchen Lamp");
+  TEST_ASSERT_TRUE(path.data() == request.pathView().data());
+  TEST_ASSERT_TRUE(path == "/api/devices");
+  TEST_ASSERT_TRUE(body == "name=Kitchen%20Lamp&dry%20run=0");
+
+  // Repeated access does not parse again
+  TEST_ASSERT_EQUAL(2, request.getAllParams().size());
+  TEST_ASSERT_EQUAL(2, request.getAllParams().size());
+}
+
+void test_web_request_native_json_document() {
+  WebRequest request =
+      parse("PATCH /api/config HTTP/1.1\r\n"
+            "Content-Type: application/json\r\n"
+            "\r\n"
+            "{\"wifi\":{\"ssid\":\"home\"},\"ports\":[80,443]}");
+  JsonVariantConst json = request.getJsonBody();
+  TEST_ASSERT_FALSE(json.isNull());
+  TEST_ASSERT_EQUAL_STRING("home", json["wifi"]["ssid"].as<const char *>());
+  TEST_ASSERT_EQUAL(443, json["ports"][1].as<int>());
+  TEST_ASSERT_EQUAL_STRING("{\"ssid\":\"home\"}",
+                           request.getJsonParam("wifi").c_str());
+
+  WebRequest notJson = parse("GET /status HTTP/1.1\r\n\r\n");
+  TEST_ASSERT_TRUE(notJson.getJsonBody().isNull());
+  TEST_ASSERT_EQUAL_STRING("", notJson.getJsonParam("wifi").c_str());
+}
+
+void test_web_request_native_route_parameter() {
+  WebRequest request = parse("GET /devices/42/fields/power HTTP/1.1\r\n\r\n");
+  request.setMatchedRoute("/devices/{id}/fields/{field}");
+  TEST_ASSERT_EQUAL_STRING("42", request.getRouteParameter("id").c_str());
+  TEST_ASSERT_EQUAL_STRING("power",
+                           request.getRouteParameter("field").c_str());
+  TEST_ASSERT_EQUAL_STRING("", request.getRouteParameter("other").c_str());
+}
+
+// Registration function to run all native WebRequest tests
+void register_web_request_native_tests() {
+  RUN_TEST(test_web_request_native_request_line);
+  RUN_TEST(test_web_request_native_headers);
+  RUN_TEST(test_web_request_native_header_ids);
+  RUN_TEST(test_web_request_native_form_body);
+  RUN_TEST(test_web_request_native_json_body);
+  RUN_TEST(test_web_request_native_lazy_parsing);
+  RUN_TEST(test_web_request_native_json_document);
+  RUN_TEST(test_web_request_native_route_parameter);
+}
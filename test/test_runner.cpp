@@ -3,17 +3,36 @@
 
 // Include all test header files
 #include "include/interface/test_core_types.h"
+#include "include/interface/test_openapi_components.h"
+#include "include/interface/test_openapi_spec_writer.h"
+#include "include/interface/test_storage_driver.h"
 #include "include/interface/test_string_compat.h"
 #include "include/interface/test_web_module_interface.h"
 #include "include/interface/test_web_module_types.h"
 #include "include/interface/test_web_platform_interface.h"
 #include "include/interface/test_web_request.h"
 #include "include/interface/test_web_response.h"
+#include "include/interface/utils/test_content_encoding.h"
+#include "include/interface/utils/test_etag.h"
+#include "include/interface/utils/test_gzip_stream.h"
+#include "include/interface/utils/test_http_range.h"
+#include "include/interface/utils/test_inplace_function.h"
+#include "include/interface/utils/test_json_document_pool.h"
+#include "include/interface/utils/test_json_format.h"
+#include "include/interface/utils/test_request_validator.h"
+#include "include/interface/utils/test_json_stream_writer.h"
+#include "include/interface/utils/test_request_arena.h"
+#include "include/interface/utils/test_response_cache.h"
+#include "include/interface/utils/test_route_trie.h"
 #include "include/interface/utils/test_route_variant.h"
+#include "include/testing/test_alloc_scope.h"
 #include "include/testing/test_mock_web_platform.h"
 #include "include/testing/test_mocks.h"
+#include "include/testing/test_native_storage_driver.h"
+#include "include/testing/test_native_web_platform.h"
 #include "include/testing/test_route_variant_native.h"
 #include "include/testing/test_test_utilities.h"
+#include "include/testing/test_web_request_native.h"
 #include "include/testing/test_testing_platform_provider.h"
 #include "include/testing/test_testing_platform_provider_json.h"
 
@@ -29,11 +48,27 @@ int main(int argc, char **argv) {
 
   // Register and run all test groups
   register_core_types_tests();
+  register_openapi_spec_writer_tests();
+  register_openapi_components_tests();
   register_route_variant_tests();
   register_route_variant_native_tests();
+  register_route_trie_tests();
+  register_inplace_function_tests();
+  register_json_stream_writer_tests();
   register_web_module_types_tests();
   register_web_response_tests();
   register_web_request_tests();
+  register_request_arena_tests();
+  register_response_cache_tests();
+  register_json_document_pool_tests();
+  register_request_validator_tests();
+  register_json_format_tests();
+  register_content_encoding_tests();
+  register_etag_tests();
+  register_gzip_stream_tests();
+  register_http_range_tests();
+  register_storage_driver_tests();
+  register_web_request_native_tests();
   register_mock_tests();
   register_helper_tests();
   register_string_compat_tests();
@@ -43,6 +78,9 @@ int main(int argc, char **argv) {
   register_testing_platform_provider_tests(); // Register testing platform
                                               // provider tests
   register_mock_web_platform_tests(); // Register our new mock platform tests
+  register_native_web_platform_tests();
+  register_native_storage_driver_tests();
+  register_alloc_scope_tests();
 
   UNITY_END();
   return 0;
@@ -53,11 +91,27 @@ void setup() {
 
   // Register and run all test groups
   register_core_types_tests();
+  register_openapi_spec_writer_tests();
+  register_openapi_components_tests();
   register_route_variant_tests();
   register_route_variant_native_tests();
+  register_route_trie_tests();
+  register_inplace_function_tests();
+  register_json_stream_writer_tests();
   register_web_module_types_tests();
   register_web_response_tests();
   register_web_request_tests();
+  register_request_arena_tests();
+  register_response_cache_tests();
+  register_json_document_pool_tests();
+  register_request_validator_tests();
+  register_json_format_tests();
+  register_content_encoding_tests();
+  register_etag_tests();
+  register_gzip_stream_tests();
+  register_http_range_tests();
+  register_storage_driver_tests();
+  register_web_request_native_tests();
   register_mock_tests();
   register_helper_tests();
   register_string_compat_tests();
@@ -67,6 +121,9 @@ void setup() {
   register_testing_platform_provider_tests(); // Register testing platform
                                               // provider tests
   register_mock_web_platform_tests(); // Register our new mock platform tests
+  register_native_web_platform_tests();
+  register_native_storage_driver_tests();
+  register_alloc_scope_tests();
 
   UNITY_END();
 }
@@ -0,0 +1,203 @@
+#!/usr/bin/env python3
+"""
+generate_progmem_assets.py
+Turn a directory of static web assets into a header of pre-compressed
+PROGMEM arrays and ProgmemAsset descriptors (interface/progmem_asset.h).
+
+Each file is stored as identity bytes plus a gzip copy (and a brotli copy
+with --brotli, which needs the `brotli` Python package). A compressed copy
+is dropped when it does not save at least --min-saving of the identity
+size. Output is deterministic (gzip mtime is zeroed), so regenerating
+unchanged assets gives an identical header.
+
+The header defines its arrays `static`: include it from one translation
+unit, typically the module that registers the asset routes.
+
+Usage:
+    python3 tools/generate_progmem_assets.py web/ \
+        --out src/generated/web_assets.h --namespace WebAssets \
+        --url-prefix /assets
+"""
+import argparse
+import gzip
+import hashlib
+import mimetypes
+import os
+import re
+import sys
+
+# Explicit types for what dashboards ship; mimetypes covers the rest
+MIME_TYPES = {
+    ".html": "text/html",
+    ".htm": "text/html",
+    ".css": "text/css",
+    ".js": "application/javascript",
+    ".mjs": "application/javascript",
+    ".json": "application/json",
+    ".svg": "image/svg+xml",
+    ".ico": "image/x-icon",
+    ".png": "image/png",
+    ".jpg": "image/jpeg",
+    ".jpeg": "image/jpeg",
+    ".gif": "image/gif",
+    ".webp": "image/webp",
+    ".woff": "font/woff",
+    ".woff2": "font/woff2",
+    ".txt": "text/plain",
+    ".map": "application/json",
+}
+
+BYTES_PER_LINE = 16
+
+
+def mime_type(path):
+    ext = os.path.splitext(path)[1].lower()
+    if ext in MIME_TYPES:
+        return MIME_TYPES[ext]
+    guessed, _ = mimetypes.guess_type(path)
+    return guessed or "application/octet-stream"
+
+
+def identifier(relative_path):
+    name = re.sub(r"[^0-9A-Za-z]+", "_", relative_path).strip("_").upper()
+    if not name or name[0].isdigit():
+        name = "ASSET_" + name
+    return name
+
+
+def c_array(name, data):
+    # A trailing NUL (not counted in the length) lets text assets also be
+    # passed to setProgmemContent(const char *, mimeType)
+    lines = ["static const uint8_t %s[] PROGMEM = {" % name]
+    body = list(data) + [0]
+    for start in range(0, len(body), BYTES_PER_LINE):
+        chunk = body[start:start + BYTES_PER_LINE]
+        lines.append("    " + ", ".join("0x%02x" % b for b in chunk) + ",")
+    lines.append("};")
+    return "\n".join(lines)
+
+
+def etag(data):
+    # Quoted, escaped for a C string literal: "\"<16 hex>\""
+    return '"\\"%s\\""' % hashlib.sha256(data).hexdigest()[:16]
+
+
+def collect(root):
+    files = []
+    for directory, dirnames, filenames in os.walk(root):
+        dirnames.sort()
+        for filename in sorted(filenames):
+            if filename.startswith("."):
+                continue
+            full = os.path.join(directory, filename)
+            files.append(os.path.relpath(full, root).replace(os.sep, "/"))
+    return files
+
+
+def compress(data, args):
+    variants = {"gzip": gzip.compress(data, compresslevel=9, mtime=0)}
+    if args.brotli:
+        import brotli  # Optional dependency, only with --brotli
+        variants["brotli"] = brotli.compress(data, quality=11)
+    # Keep a compressed copy only when it pays for its flash
+    limit = len(data) * (1.0 - args.min_saving)
+    return {k: v for k, v in variants.items() if len(v) <= limit}
+
+
+def generate(args):
+    files = collect(args.asset_dir)
+    if not files:
+        sys.exit("no files found in %s" % args.asset_dir)
+
+    prefix = "/" + args.url_prefix.strip("/") if args.url_prefix.strip("/") \
+        else ""
+    guard = identifier(os.path.basename(args.out)) + "_"
+    out = [
+        "// Generated by tools/generate_progmem_assets.py - do not edit",
+        "#ifndef %s" % guard,
+        "#define %s" % guard,
+        "",
+        "#include <interface/progmem_asset.h>",
+        "",
+        "namespace %s {" % args.namespace,
+        "",
+    ]
+    descriptors = []
+    totals = {"identity": 0, "served": 0}
+
+    for relative in files:
+        with open(os.path.join(args.asset_dir, relative), "rb") as f:
+            data = f.read()
+        name = identifier(relative)
+        variants = compress(data, args)
+
+        out.append("// %s (%d bytes)" % (relative, len(data)))
+        out.append(c_array(name + "_IDENTITY", data))
+        fields = ["%s_IDENTITY" % name, str(len(data))]
+        for kind in ("gzip", "brotli"):
+            if kind in variants:
+                array = "%s_%s" % (name, kind.upper())
+                out.append(c_array(array, variants[kind]))
+                fields += [array, str(len(variants[kind]))]
+            else:
+                fields += ["nullptr", "0"]
+        out.append("")
+        fields.append(etag(data))
+        descriptors.append((name, prefix + "/" + relative, mime_type(relative),
+                            fields))
+
+        smallest = min([len(data)] + [len(v) for v in variants.values()])
+        totals["identity"] += len(data)
+        totals["served"] += smallest
+        print("%-40s %8d -> %8d bytes" % (relative, len(data), smallest),
+              file=sys.stderr)
+
+    for name, path, mime, fields in descriptors:
+        out.append("static const ProgmemAsset %s = {" % name)
+        out.append('    "%s", "%s",' % (path, mime))
+        out.append("    %s, %s," % (fields[0], fields[1]))
+        out.append("    %s, %s," % (fields[2], fields[3]))
+        out.append("    %s, %s," % (fields[4], fields[5]))
+        out.append("    %s};" % fields[6])
+        out.append("")
+
+    out.append("static const ProgmemAsset *const ALL[] = {")
+    for name, _, _, _ in descriptors:
+        out.append("    &%s," % name)
+    out.append("};")
+    out.append("static const size_t COUNT = %d;" % len(descriptors))
+    out.append("")
+    out.append("} // namespace %s" % args.namespace)
+    out.append("")
+    out.append("#endif // %s" % guard)
+
+    out_dir = os.path.dirname(args.out)
+    if out_dir:
+        os.makedirs(out_dir, exist_ok=True)
+    with open(args.out, "w") as f:
+        f.write("\n".join(out) + "\n")
+
+    ratio = totals["identity"] / max(1, totals["served"])
+    print("%d assets: %d bytes served as %d (%.1fx)" %
+          (len(descriptors), totals["identity"], totals["served"], ratio),
+          file=sys.stderr)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[2])
+    parser.add_argument("asset_dir", help="directory of static assets")
+    parser.add_argument("--out", required=True, help="header to write")
+    parser.add_argument("--namespace", default="WebAssets",
+                        help="C++ namespace for the generated symbols")
+    parser.add_argument("--url-prefix", default="",
+                        help="URL path prefix for ProgmemAsset::path")
+    parser.add_argument("--brotli", action="store_true",
+                        help="also emit brotli copies (needs `brotli`)")
+    parser.add_argument("--min-saving", type=float, default=0.1,
+                        help="minimum fraction a compressed copy must save "
+                             "(default 0.1)")
+    generate(parser.parse_args())
+
+
+if __name__ == "__main__":
+    main()
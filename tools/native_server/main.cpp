@@ -0,0 +1,109 @@
+// Loopback server for load-testing modules on a Linux workstation.
+//
+//   pio run -e native_server
+//   .pio/build/native_server/program [port]
+//   wrk -t2 -c64 -d10s --latency http://127.0.0.1:8080/bench/hello
+//
+// Register your own modules below alongside (or instead of) BenchModule.
+
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <testing/native_web_platform.h>
+
+namespace {
+
+NativeWebPlatform *activePlatform = nullptr;
+
+void handleSignal(int) {
+  if (activePlatform) {
+    activePlatform->stop();
+  }
+}
+
+// Representative handlers: plain text, small JSON, streamed list, route
+// parameter, JSON body and an authenticated route
+class BenchModule : public IWebModule {
+public:
+  std::vector<RouteVariant> getHttpRoutes() override {
+    return {
+        WebRoute("/hello", WebModule::WM_GET,
+                 [](WebRequest &req, WebResponse &res) {
+                   res.setContent("hello", "text/plain");
+                 }),
+        ApiRoute("/status", WebModule::WM_GET,
+                 [](WebRequest &req, WebResponse &res) {
+                   res.setJsonStreamContent([](JsonStreamWriter &json) {
+                     json.beginObject()
+                         .member("status", "ok")
+                         .member("uptime", 12345)
+                         .endObject();
+                   });
+                 }),
+        ApiRoute("/devices", WebModule::WM_GET,
+                 [](WebRequest &req, WebResponse &res) {
+                   long count = atol(req.getParam("count").c_str());
+                   count = count > 0 ? count : 100;
+                   res.setJsonStreamContent([count](JsonStreamWriter &json) {
+                     json.beginArray();
+                     for (long i = 0; i < count; i++) {
+                       json.beginObject()
+                           .member("id", i)
+                           .member("name", "device")
+                           .member("on", i % 2 == 0)
+                           .endObject();
+                     }
+                     json.endArray();
+                   });
+                 }),
+        ApiRoute("/devices/{id}", WebModule::WM_GET,
+                 [](WebRequest &req, WebResponse &res) {
+                   String id = req.getRouteParameter("id");
+                   res.setJsonStreamContent([id](JsonStreamWriter &json) {
+                     json.beginObject().member("id", id).endObject();
+                   });
+                 }),
+        ApiRoute("/echo", WebModule::WM_POST,
+                 [](WebRequest &req, WebResponse &res) {
+                   res.setContent(req.getBody(), "application/json");
+                 }),
+        ApiRoute("/secure", WebModule::WM_GET,
+                 [](WebRequest &req, WebResponse &res) {
+                   res.setContent(req.getAuthContext().username,
+                                  "text/plain");
+                 },
+                 {AuthType::TOKEN}),
+    };
+  }
+  std::vector<RouteVariant> getHttpsRoutes() override {
+    return getHttpRoutes();
+  }
+  String getModuleName() const override { return "bench"; }
+};
+
+} // namespace
+
+int main(int argc, char **argv) {
+  uint16_t port = argc > 1 ? static_cast<uint16_t>(atoi(argv[1]))
+                           : NativeWebPlatform::DEFAULT_PORT;
+  NativeWebPlatform platform(port);
+  BenchModule benchModule;
+  platform.registerModule("/bench", &benchModule);
+  platform.addApiToken("bench-token", "bench");
+
+  platform.begin("native-server");
+  if (!platform.isConnected()) {
+    return 1;
+  }
+  benchModule.begin();
+
+  activePlatform = &platform;
+  signal(SIGINT, handleSignal);
+  signal(SIGTERM, handleSignal);
+  printf("Serving %zu routes on %s (token: bench-token), Ctrl-C to stop\n",
+         platform.getRouteCount(), platform.getBaseUrl().c_str());
+  platform.run();
+  printf("Handled %llu requests\n",
+         static_cast<unsigned long long>(platform.getRequestCount()));
+  return 0;
+}
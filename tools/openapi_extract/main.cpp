@@ -0,0 +1,131 @@
+// Build-time OpenAPI extraction: records the routes modules register and
+// writes the minified OpenAPI 3 spec to a file, for embedding in firmware
+// that is built without OpenAPI docs.
+//
+//   pio run -e openapi_extract
+//   .pio/build/openapi_extract/program build/openapi/openapi.json
+//       --title "My Device" --version 1.2.0
+//   python3 tools/generate_progmem_assets.py build/openapi
+//       --out src/generated/openapi_spec.h --namespace OpenAPISpec
+//
+// The generated header holds the spec plus a gzip copy and an ETag as a
+// ProgmemAsset (OpenAPISpec::OPENAPI_JSON). Firmware built with
+// -DWEB_PLATFORM_OPENAPI=0 -DWEB_PLATFORM_MAKERAPI=0 compiles every
+// OpenAPIDoc down to OpenAPIDoc<false> and serves the embedded copy:
+//
+//   platform.registerWebRoute(
+//       "/openapi.json", [](WebRequest &req, WebResponse &res) {
+//         res.setProgmemContent(OpenAPISpec::OPENAPI_JSON);
+//       });
+//
+// The project registers its modules, with the base paths the firmware
+// uses, by defining this hook in one of its own sources and adding that
+// file (and the modules) to the environment's build_src_filter:
+//
+//   #include <web_platform_interface.h>
+//   void registerOpenApiModules(IWebPlatform &platform) {
+//     static ThermostatModule thermostat;
+//     platform.registerModule("/heating", &thermostat);
+//   }
+//
+// Without one, the weak default below registers ExampleModule so the tool
+// still runs. Module constructors and getHttpRoutes() run on the host, so
+// they must not touch hardware.
+
+#include <Arduino.h>
+#include <cstdio>
+#include <cstring>
+#include <testing/testing_platform_provider.h>
+
+namespace {
+
+// Stand-in used when the project defines no registerOpenApiModules()
+class ExampleModule : public IWebModule {
+public:
+  std::vector<RouteVariant> getHttpRoutes() override {
+    return {
+        ApiRoute("/status", WebModule::WM_GET,
+                 [](WebRequest &req, WebResponse &res) {},
+                 API_DOC("Device status", "Uptime and firmware version")
+                     .withResponseSchema(R"({
+                         "type": "object",
+                         "properties": {
+                             "uptime": {"type": "integer"},
+                             "version": {"type": "string"}
+                         }
+                     })")),
+        ApiRoute("/settings", WebModule::WM_PUT,
+                 [](WebRequest &req, WebResponse &res) {},
+                 {AuthType::TOKEN, AuthType::SESSION},
+                 API_DOC("Update settings")
+                     .withRequestBody(R"({"type": "object"})")
+                     .withResponseSchema(
+                         OpenAPIFactory::createSuccessResponse())),
+    };
+  }
+  std::vector<RouteVariant> getHttpsRoutes() override {
+    return getHttpRoutes();
+  }
+  String getModuleName() const override { return "example"; }
+};
+
+void usage(const char *program) {
+  fprintf(stderr,
+          "usage: %s <out.json> [--title T] [--version V] [--server URL]\n",
+          program);
+}
+
+} // namespace
+
+// Overridden by the project's own definition, if it links one
+__attribute__((weak)) void registerOpenApiModules(IWebPlatform &platform) {
+  fprintf(stderr, "openapi_extract: the project defines no "
+                  "registerOpenApiModules(); writing the example spec\n");
+  static ExampleModule exampleModule;
+  platform.registerModule("/example", &exampleModule);
+}
+
+int main(int argc, char **argv) {
+#if !OPENAPI_ENABLED
+  fprintf(stderr, "openapi_extract needs -DWEB_PLATFORM_OPENAPI=1\n");
+  return 1;
+#endif
+  if (argc < 2 || argv[1][0] == '-') {
+    usage(argv[0]);
+    return 2;
+  }
+  OpenAPISpecWriter::Info info;
+  for (int i = 2; i + 1 < argc; i += 2) {
+    if (strcmp(argv[i], "--title") == 0) {
+      info.title = argv[i + 1];
+    } else if (strcmp(argv[i], "--version") == 0) {
+      info.version = argv[i + 1];
+    } else if (strcmp(argv[i], "--server") == 0) {
+      info.serverUrl = argv[i + 1];
+    } else {
+      usage(argv[0]);
+      return 2;
+    }
+  }
+
+  // Records every route; routes offered over both HTTP and HTTPS are
+  // recorded once
+  MockWebPlatform platform;
+  registerOpenApiModules(platform);
+
+  FILE *out = fopen(argv[1], "wb");
+  if (!out) {
+    perror(argv[1]);
+    return 1;
+  }
+  JsonStreamWriter writer([out](const char *data, size_t length) {
+    return fwrite(data, 1, length, out) == length;
+  });
+  bool written = platform.writeOpenApiSpec(writer, info);
+  if (fclose(out) != 0 || !written) {
+    fprintf(stderr, "failed to write %s\n", argv[1]);
+    return 1;
+  }
+  fprintf(stderr, "%s: %zu bytes\n", argv[1], writer.bytesWritten());
+  return 0;
+}